@@ -62,6 +62,10 @@ public:
 
   static void MemoryPressureDetected();
 
+  static void SetTimerTraceEnabled(bool enabled);
+
+  static lldb::SBError ExportTimerTrace(const char *path);
+
   explicit operator bool() const;
 
   bool IsValid() const;
@@ -314,6 +314,15 @@ public:
 
   lldb::SBError IsTypeSystemCompatible(lldb::LanguageType language);
 
+  //------------------------------------------------------------------
+  /// Get an estimate of the memory used by this module.
+  ///
+  /// @return
+  ///     The number of bytes used by the symbols, debug information,
+  ///     line tables and types parsed for this module so far.
+  //------------------------------------------------------------------
+  uint64_t GetMemoryUsage();
+
 private:
   friend class SBAddress;
   friend class SBFrame;
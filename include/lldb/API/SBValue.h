@@ -280,6 +280,19 @@ public:
 
   uint32_t GetNumChildren(uint32_t max);
 
+  //------------------------------------------------------------------
+  /// Read the memory backing a window of children with a single read.
+  ///
+  /// For arrays in process memory, this makes a following run of
+  /// GetChildAtIndex() calls over [start_idx, start_idx + count) avoid
+  /// one memory read per child. This is designed for UIs that page
+  /// through very large arrays.
+  ///
+  /// @return
+  ///     The number of children whose memory was prefetched.
+  //------------------------------------------------------------------
+  uint32_t PrefetchChildren(uint32_t start_idx, uint32_t count);
+
   void *GetOpaqueType();
 
   lldb::SBTarget GetTarget();
@@ -227,10 +227,13 @@ public:
 
   void SetCloseInputOnEOF(bool b);
 
+  /// Enable logging for \a channel. If \a buffer_size is non-zero, only the
+  /// last \a buffer_size bytes of log messages are kept in memory until they
+  /// are dumped with "log dump"; this implies LLDB_LOG_OPTION_ASYNC.
   bool EnableLog(llvm::StringRef channel,
                  llvm::ArrayRef<const char *> categories,
                  llvm::StringRef log_file, uint32_t log_options,
-                 llvm::raw_ostream &error_stream);
+                 llvm::raw_ostream &error_stream, size_t buffer_size = 0);
 
   void SetLoggingCallback(lldb::LogOutputCallback log_callback, void *baton);
 
@@ -293,6 +296,8 @@ public:
 
   uint32_t GetStopSourceLineCount(bool before) const;
 
+  uint64_t GetSourceCacheMaxSize() const;
+
   StopDisassemblyType GetStopDisassemblyDisplay() const;
 
   uint32_t GetDisassemblyLineCount() const;
@@ -417,7 +422,9 @@ protected:
   std::recursive_mutex m_script_interpreter_mutex;
 
   IOHandlerStack m_input_reader_stack;
-  llvm::StringMap<std::weak_ptr<llvm::raw_ostream>> m_log_streams;
+  // Log files opened by EnableLog, and their file descriptors.
+  llvm::StringMap<std::pair<std::weak_ptr<llvm::raw_ostream>, int>>
+      m_log_streams;
   std::shared_ptr<llvm::raw_ostream> m_log_callback_stream_sp;
   ConstString m_instance_name;
   static LoadPluginCallbackType g_load_plugin_callback;
@@ -91,6 +91,21 @@ class VariableList;
 
 namespace lldb_private {
 
+//----------------------------------------------------------------------
+/// An estimate of the memory a module holds for the information it parsed
+/// out of its object and symbol files, in bytes.
+//----------------------------------------------------------------------
+struct ModuleMemoryUsage {
+  uint64_t symtab = 0;
+  uint64_t debug_info = 0;
+  uint64_t line_tables = 0;
+  uint64_t types = 0;
+
+  uint64_t GetTotal() const {
+    return symtab + debug_info + line_tables + types;
+  }
+};
+
 //----------------------------------------------------------------------
 /// @class Module Module.h "lldb/Core/Module.h"
 /// A class that describes an executable image and its associated
@@ -601,6 +616,31 @@ public:
 
   void SetSymbolFileFileSpec(const FileSpec &file);
 
+  //------------------------------------------------------------------
+  /// Estimate the memory used by the symbol table, debug information, line
+  /// tables and types parsed so far. Nothing gets parsed to find out.
+  //------------------------------------------------------------------
+  ModuleMemoryUsage GetMemoryUsage();
+
+  //------------------------------------------------------------------
+  /// Free the symbol table, the symbol vendor and the type systems. They
+  /// are parsed again from the object and symbol files the next time they
+  /// are needed.
+  ///
+  /// Symbols, compile units, functions and types handed out before are
+  /// freed too, so this must only be called for modules that no target
+  /// uses anymore.
+  //------------------------------------------------------------------
+  void ReleaseParsedInfo();
+
+  //------------------------------------------------------------------
+  /// Record that the module is being used. Modules with a smaller
+  /// GetLastUse() value were used less recently.
+  //------------------------------------------------------------------
+  void UpdateLastUse();
+
+  uint64_t GetLastUse() const { return m_last_use; }
+
   const llvm::sys::TimePoint<> &GetModificationTime() const {
     return m_mod_time;
   }
@@ -1137,6 +1177,7 @@ protected:
   std::atomic<bool> m_did_load_objfile{false};
   std::atomic<bool> m_did_load_symbol_vendor{false};
   std::atomic<bool> m_did_set_uuid{false};
+  std::atomic<uint64_t> m_last_use{0};
   mutable bool m_file_has_changed : 1,
       m_first_file_changed_log : 1; /// See if the module was modified after it
                                     /// was initially opened.
@@ -1190,6 +1231,11 @@ protected:
 
   SectionList *GetUnifiedSectionList();
 
+  /// Remove the sections that \a obj_file, a separate symbol file, added to
+  /// the unified \a section_list.
+  void RemoveSectionsOfSymbolFile(SectionList &section_list,
+                                  ObjectFile *obj_file);
+
   friend class ModuleList;
   friend class ObjectFile;
   friend class SymbolFile;
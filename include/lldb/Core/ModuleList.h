@@ -83,7 +83,15 @@ public:
   bool SetClangModulesCachePath(llvm::StringRef path);
   SwiftModuleLoadingMode GetSwiftModuleLoadingMode() const;
   bool SetSwiftModuleLoadingMode(SwiftModuleLoadingMode);
+  FileSpec GetSwiftTypeCachePath() const;
+  uint64_t GetSwiftTypeCacheMaxSize() const;
   bool GetEnableExternalLookup() const;
+  bool GetLazyMemberFunctionParsing() const;
+  FileSpec GetModuleCRCCachePath() const;
+  FileSpec GetDebugFileIndexPath() const;
+  FileSpec GetDebugNamesCachePath() const;
+  uint64_t GetUnusedModuleMemoryBudget() const;
+  bool GetUseNameLookupFilters() const;
 }; 
 
 //----------------------------------------------------------------------
@@ -589,6 +597,16 @@ public:
 
   static size_t RemoveOrphanSharedModules(bool mandatory);
 
+  //------------------------------------------------------------------
+  /// Release the parsed information of the least recently used shared
+  /// modules that no target uses, until the memory they hold fits into
+  /// symbols.unused-module-memory-budget.
+  ///
+  /// @return
+  ///     The number of modules whose information was released.
+  //------------------------------------------------------------------
+  static size_t ReleaseUnusedSharedModuleInfo();
+
   static bool RemoveSharedModuleIfOrphaned(const Module *module_ptr);
   
   void ForEach(std::function<bool(const lldb::ModuleSP &module_sp)> const
@@ -612,6 +630,10 @@ protected:
 
   void ClearImpl(bool use_notifier = true);
 
+  /// Return a copy of the modules, so that they can be searched without
+  /// holding the list mutex.
+  collection GetModulesCopy() const;
+
   //------------------------------------------------------------------
   // Member variables.
   //------------------------------------------------------------------
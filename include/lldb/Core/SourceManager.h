@@ -15,9 +15,12 @@
 
 #include "llvm/Support/Chrono.h"
 
+#include <chrono>
 #include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stddef.h>
 #include <string>
 #include <vector>
@@ -49,7 +52,9 @@ public:
     File(const FileSpec &file_spec, lldb::DebuggerSP debugger_sp);
     ~File() = default;
 
-    void UpdateIfNeeded();
+    /// Reload the file if it changed on disk. Returns false if the file no
+    /// longer exists.
+    bool UpdateIfNeeded();
 
     size_t DisplaySourceLines(uint32_t line, llvm::Optional<size_t> column,
                               uint32_t context_before, uint32_t context_after,
@@ -76,6 +81,9 @@ public:
 
     uint32_t GetNumLines();
 
+    /// The number of bytes of source text this file is holding on to.
+    size_t GetByteSize() const;
+
   protected:
     bool CalculateLineOffsets(uint32_t line = UINT32_MAX);
 
@@ -88,12 +96,21 @@ public:
     // Keep the modification time that this file data is valid for
     llvm::sys::TimePoint<> m_mod_time;
 
+    // When the modification time was last checked, so that repeatedly
+    // displaying lines from this file doesn't stat it every time.
+    std::chrono::steady_clock::time_point m_last_mod_time_check;
+
     // If the target uses path remappings, be sure to clear our notion of a
     // source file if the path modification ID changes
     uint32_t m_source_map_mod_id = 0;
     lldb::DataBufferSP m_data_sp;
     typedef std::vector<uint32_t> LineOffsets;
+    // m_offsets[N - 1] is the start offset of line N. The index is built
+    // lazily: m_offsets_scan_pos is where the next scan picks up, and
+    // m_offsets_complete is set once the whole file has been indexed.
     LineOffsets m_offsets;
+    uint32_t m_offsets_scan_pos = 0;
+    bool m_offsets_complete = false;
     lldb::DebuggerWP m_debugger_wp;
 
   private:
@@ -112,12 +129,28 @@ public:
     SourceFileCache() = default;
     ~SourceFileCache() = default;
 
-    void AddSourceFile(const FileSP &file_sp);
-    FileSP FindSourceFile(const FileSpec &file_spec) const;
+    /// Add \a file_sp to the cache under \a file_spec, evicting the least
+    /// recently used files until the cached source text fits in
+    /// \a max_byte_size. The file just added is never evicted. Adding a file
+    /// that is already cached makes it the most recently used one and
+    /// measures it again.
+    void AddSourceFile(const FileSpec &file_spec, const FileSP &file_sp,
+                       uint64_t max_byte_size = UINT64_MAX);
+    FileSP FindSourceFile(const FileSpec &file_spec);
 
   protected:
-    typedef std::map<FileSpec, FileSP> FileCache;
+    struct CacheEntry {
+      FileSpec file_spec;
+      FileSP file_sp;
+      size_t byte_size;
+    };
+    // Most recently used entries are at the front.
+    typedef std::list<CacheEntry> EntryList;
+    typedef std::map<FileSpec, EntryList::iterator> FileCache;
+    EntryList m_entries;
     FileCache m_file_cache;
+    uint64_t m_byte_size = 0;
+    std::mutex m_mutex;
   };
 #endif // SWIG
 
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <vector>
 
+#include "lldb/Utility/BloomFilter.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
 
@@ -51,11 +52,18 @@ public:
   //------------------------------------------------------------------
   void Append(ConstString unique_cstr, const T &value) {
     m_map.push_back(typename UniqueCStringMap<T>::Entry(unique_cstr, value));
+    m_filter.Insert(unique_cstr);
   }
 
-  void Append(const Entry &e) { m_map.push_back(e); }
+  void Append(const Entry &e) {
+    m_map.push_back(e);
+    m_filter.Insert(e.cstring);
+  }
 
-  void Clear() { m_map.clear(); }
+  void Clear() {
+    m_map.clear();
+    m_filter.Reset(0);
+  }
 
   //------------------------------------------------------------------
   // Call this function to always keep the map sorted when putting entries into
@@ -63,11 +71,12 @@ public:
   //------------------------------------------------------------------
   void Insert(ConstString unique_cstr, const T &value) {
     typename UniqueCStringMap<T>::Entry e(unique_cstr, value);
-    m_map.insert(std::upper_bound(m_map.begin(), m_map.end(), e), e);
+    Insert(e);
   }
 
   void Insert(const Entry &e) {
     m_map.insert(std::upper_bound(m_map.begin(), m_map.end(), e), e);
+    m_filter.Insert(e.cstring);
   }
 
   //------------------------------------------------------------------
@@ -111,6 +120,8 @@ public:
   // be returned and that won't match any existing values.
   //------------------------------------------------------------------
   T Find(ConstString unique_cstr, T fail_value) const {
+    if (!MayContain(unique_cstr))
+      return fail_value;
     Entry search_entry(unique_cstr);
     const_iterator end = m_map.end();
     const_iterator pos = std::lower_bound(m_map.begin(), end, search_entry);
@@ -118,6 +129,7 @@ public:
       if (pos->cstring == unique_cstr)
         return pos->value;
     }
+    RecordMiss();
     return fail_value;
   }
 
@@ -129,11 +141,14 @@ public:
   // during while using the returned pointer.
   //------------------------------------------------------------------
   const Entry *FindFirstValueForName(ConstString unique_cstr) const {
+    if (!MayContain(unique_cstr))
+      return nullptr;
     Entry search_entry(unique_cstr);
     const_iterator end = m_map.end();
     const_iterator pos = std::lower_bound(m_map.begin(), end, search_entry);
     if (pos != end && pos->cstring == unique_cstr)
       return &(*pos);
+    RecordMiss();
     return nullptr;
   }
 
@@ -160,6 +175,8 @@ public:
 
   size_t GetValues(ConstString unique_cstr, std::vector<T> &values) const {
     const size_t start_size = values.size();
+    if (!MayContain(unique_cstr))
+      return 0;
 
     Entry search_entry(unique_cstr);
     const_iterator pos, end = m_map.end();
@@ -171,6 +188,8 @@ public:
         break;
     }
 
+    if (values.size() == start_size)
+      RecordMiss();
     return values.size() - start_size;
   }
 
@@ -232,6 +251,20 @@ public:
     }
   }
 
+  //------------------------------------------------------------------
+  // Build a Bloom filter of the names in this map, so that searches for
+  // names that aren't in it don't have to search the map. Call this as part
+  // of the finalization of maps that are searched often for names they
+  // mostly don't contain. Entries added afterwards are added to the filter.
+  //------------------------------------------------------------------
+  void BuildFilter() {
+    m_filter.Reset(m_map.size());
+    for (const Entry &entry : m_map)
+      m_filter.Insert(entry.cstring);
+  }
+
+  size_t GetFilterMemoryUsage() const { return m_filter.GetMemoryUsage(); }
+
   size_t Erase(ConstString unique_cstr) {
     size_t num_removed = 0;
     Entry search_entry(unique_cstr);
@@ -257,7 +290,22 @@ protected:
   typedef std::vector<Entry> collection;
   typedef typename collection::iterator iterator;
   typedef typename collection::const_iterator const_iterator;
+
+  bool MayContain(ConstString unique_cstr) const {
+    if (m_filter.MayContain(unique_cstr))
+      return true;
+    BloomFilter::RecordLookupAvoided();
+    return false;
+  }
+
+  // A search the filter let through found nothing.
+  void RecordMiss() const {
+    if (m_filter.IsValid())
+      BloomFilter::RecordFalsePositive();
+  }
+
   collection m_map;
+  BloomFilter m_filter;
 };
 
 } // namespace lldb_private
@@ -490,6 +490,18 @@ public:
 
   virtual lldb::ValueObjectSP GetChildAtIndex(size_t idx, bool can_create);
 
+  //------------------------------------------------------------------
+  /// Read the memory backing children [idx, idx + count) of an array
+  /// that lives in process memory with a single memory read, so that
+  /// subsequently creating those children is served from the process
+  /// memory cache instead of costing one read each.
+  ///
+  /// @return
+  ///     The number of children whose memory was prefetched. Zero if
+  ///     this value is not an array in process memory.
+  //------------------------------------------------------------------
+  size_t PrefetchChildren(size_t idx, size_t count);
+
   // this will always create the children if necessary
   lldb::ValueObjectSP GetChildAtIndexPath(llvm::ArrayRef<size_t> idxs,
                                           size_t *index_of_error = nullptr);
@@ -28,6 +28,11 @@ public:
 
   static uint32_t GetCurrentRevision();
 
+  // number of formatter lookups answered by (or missing) the type-name cache
+  static uint64_t GetFormatCacheHits();
+
+  static uint64_t GetFormatCacheMisses();
+
   static bool ShouldPrintAsOneLiner(ValueObject &valobj);
 
   static lldb::TypeFormatImplSP GetFormat(ValueObject &valobj,
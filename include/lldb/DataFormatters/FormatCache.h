@@ -10,12 +10,14 @@
 #ifndef lldb_FormatCache_h_
 #define lldb_FormatCache_h_
 
-#include <map>
-#include <mutex>
+#include <atomic>
 
 #include "lldb/Utility/ConstString.h"
 #include "lldb/lldb-public.h"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/RWMutex.h"
+
 namespace lldb_private {
 class FormatCache {
 private:
@@ -40,21 +42,21 @@ private:
     Entry(lldb::TypeFormatImplSP, lldb::TypeSummaryImplSP,
           lldb::SyntheticChildrenSP, lldb::TypeValidatorImplSP);
 
-    bool IsFormatCached();
+    bool IsFormatCached() const;
 
-    bool IsSummaryCached();
+    bool IsSummaryCached() const;
 
-    bool IsSyntheticCached();
+    bool IsSyntheticCached() const;
 
-    bool IsValidatorCached();
+    bool IsValidatorCached() const;
 
-    lldb::TypeFormatImplSP GetFormat();
+    lldb::TypeFormatImplSP GetFormat() const;
 
-    lldb::TypeSummaryImplSP GetSummary();
+    lldb::TypeSummaryImplSP GetSummary() const;
 
-    lldb::SyntheticChildrenSP GetSynthetic();
+    lldb::SyntheticChildrenSP GetSynthetic() const;
 
-    lldb::TypeValidatorImplSP GetValidator();
+    lldb::TypeValidatorImplSP GetValidator() const;
 
     void SetFormat(lldb::TypeFormatImplSP);
 
@@ -64,15 +66,21 @@ private:
 
     void SetValidator(lldb::TypeValidatorImplSP);
   };
-  typedef std::map<ConstString, Entry> CacheMap;
+  // Type names are uniqued ConstStrings, so the string pointer identifies
+  // the type and lookups never need to compare the names themselves.
+  typedef llvm::DenseMap<const char *, Entry> CacheMap;
   CacheMap m_map;
-  std::recursive_mutex m_mutex;
+  // Lookups vastly outnumber insertions once a few values have been
+  // printed, so readers only take a shared lock.
+  llvm::sys::SmartRWMutex<false> m_mutex;
 
-  uint64_t m_cache_hits;
-  uint64_t m_cache_misses;
+  std::atomic<uint64_t> m_cache_hits;
+  std::atomic<uint64_t> m_cache_misses;
 
   Entry &GetEntry(ConstString type);
 
+  const Entry *FindEntry(ConstString type) const;
+
 public:
   FormatCache();
 
@@ -98,9 +106,9 @@ public:
 
   void Clear();
 
-  uint64_t GetCacheHits() { return m_cache_hits; }
+  uint64_t GetCacheHits() const { return m_cache_hits; }
 
-  uint64_t GetCacheMisses() { return m_cache_misses; }
+  uint64_t GetCacheMisses() const { return m_cache_misses; }
 };
 } // namespace lldb_private
 
@@ -105,7 +105,7 @@ private:
   lldb::DynamicValueType m_dynamic_value_type;
   std::pair<FormattersMatchVector, bool> m_formatters_match_vector;
   ConstString m_type_for_cache;
-  CandidateLanguagesVector m_candidate_languages;
+  std::pair<CandidateLanguagesVector, bool> m_candidate_languages;
 };
 
 class TypeNameSpecifierImpl {
@@ -181,6 +181,8 @@ public:
 
   uint32_t GetCurrentRevision() override { return m_last_revision; }
 
+  const FormatCache &GetFormatCache() const { return m_format_cache; }
+
   static FormattersMatchVector
   GetPossibleMatches(ValueObject &valobj, lldb::DynamicValueType use_dynamic) {
     FormattersMatchVector matches;
@@ -0,0 +1,91 @@
+//===-- ExpressionCache.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ExpressionCache_h_
+#define liblldb_ExpressionCache_h_
+
+#include "lldb/Expression/Expression.h"
+#include "lldb/lldb-forward.h"
+#include "lldb/lldb-private.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class ExpressionCache ExpressionCache.h "lldb/Expression/ExpressionCache.h"
+/// A per-target cache of parsed and JITed user expressions.
+///
+/// IDEs and scripts evaluate the same expressions at every stop. A cached
+/// expression can be executed again without parsing, running the IR passes
+/// or JITing, as long as it is evaluated with the same options in the same
+/// lexical block of the same process, which is what UserExpression's
+/// MatchesContext checks.
+//----------------------------------------------------------------------
+class ExpressionCache {
+public:
+  /// Everything other than the process that has to match for a compiled
+  /// expression to be reused.
+  struct Key {
+    std::string expr;
+    std::string prefix;
+    lldb::LanguageType language = lldb::eLanguageTypeUnknown;
+    Expression::ResultType desired_type = Expression::eResultTypeAny;
+    ExecutionPolicy execution_policy = eExecutionPolicyOnlyWhenNeeded;
+    lldb::DynamicValueType use_dynamic = lldb::eNoDynamicValues;
+    bool generate_debug_info = false;
+    /// The innermost lexical block of the frame. If the frame has no debug
+    /// information, the frame's pc is used instead.
+    const Block *block = nullptr;
+    lldb::addr_t pc = LLDB_INVALID_ADDRESS;
+
+    bool operator<(const Key &rhs) const;
+  };
+
+  /// Fill in \a key for evaluating \a expr in \a exe_ctx. Returns false if
+  /// the expression must not be cached.
+  static bool MakeKey(ExecutionContext &exe_ctx, llvm::StringRef expr,
+                      llvm::StringRef prefix, lldb::LanguageType language,
+                      Expression::ResultType desired_type,
+                      ExecutionPolicy execution_policy,
+                      const EvaluateExpressionOptions &options, Key &key);
+
+  /// Remove and return the expression cached under \a key if it can be run
+  /// in \a exe_ctx. The caller owns the expression until it hands it back
+  /// with Insert(), so two evaluations never share one expression.
+  lldb::UserExpressionSP Take(const Key &key, ExecutionContext &exe_ctx);
+
+  /// Cache \a expr_sp under \a key, dropping the least recently used
+  /// expressions beyond \a max_size.
+  void Insert(const Key &key, const lldb::UserExpressionSP &expr_sp,
+              size_t max_size);
+
+  /// Drop every cached expression, e.g. because modules were loaded or
+  /// unloaded and name lookups might now resolve differently.
+  void Clear();
+
+  size_t GetSize();
+
+private:
+  typedef std::list<std::pair<Key, lldb::UserExpressionSP>> EntryList;
+
+  std::mutex m_mutex;
+  // Most recently used entries are at the front.
+  EntryList m_entries;
+  std::map<Key, EntryList::iterator> m_map;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_ExpressionCache_h_
@@ -125,6 +125,16 @@ public:
 
   bool MatchesContext(ExecutionContext &exe_ctx);
 
+  //------------------------------------------------------------------
+  /// Let this expression run anywhere in the lexical block it was parsed
+  /// in, rather than only at the pc it was parsed at. Only the
+  /// ExpressionCache does this: it keys expressions by block and checks
+  /// that the frame still provides what the parse assumed.
+  //------------------------------------------------------------------
+  void SetMatchAnyAddressInBlock(bool match) {
+    m_match_any_address_in_block = match;
+  }
+
   //------------------------------------------------------------------
   /// Execute the parsed expression by callinng the derived class's DoExecute
   /// method.
@@ -316,7 +326,18 @@ protected:
                            lldb::ProcessSP &process_sp,
                            lldb::StackFrameSP &frame_sp);
 
+  //------------------------------------------------------------------
+  /// Return true if what the parse found out about its frame, like whether
+  /// there is a usable object pointer, also holds in  frame. Only asked
+  /// for frames at a different pc in the same block.
+  //------------------------------------------------------------------
+  virtual bool ContextIsValidForFrame(StackFrame &frame) { return true; }
+
   Address m_address;       ///< The address the process is stopped in.
+  const Block *m_block = nullptr; ///< The innermost lexical block containing
+                                  ///m_address, if there is debug info.
+  bool m_match_any_address_in_block = false; ///< Whether the expression can
+                                             ///run anywhere in m_block.
   std::string m_expr_text; ///< The text of the expression, as typed by the user
   std::string m_expr_prefix; ///< The text of the translation-level definitions,
                              ///as provided by the user
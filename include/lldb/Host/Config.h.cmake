@@ -33,4 +33,6 @@
 #cmakedefine HAVE_LIBCOMPRESSION
 #endif
 
+#cmakedefine HAVE_LIBZSTD
+
 #endif // #ifndef LLDB_HOST_CONFIG_H
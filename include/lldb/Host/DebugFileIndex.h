@@ -0,0 +1,103 @@
+//===-- DebugFileIndex.h ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_DebugFileIndex_h_
+#define liblldb_DebugFileIndex_h_
+
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Status.h"
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class DebugFileIndex DebugFileIndex.h "lldb/Host/DebugFileIndex.h"
+/// Remembers the contents of the directories searched for separate debug
+/// files.
+///
+/// Every module probes a handful of candidate paths in each debug file
+/// directory (debuglink names, .debug subdirectories, .build-id/xx/yyyy.debug
+/// files). Instead of a stat per candidate, each directory is listed once and
+/// candidates whose name isn't in the listing are rejected right away.
+/// A listing is refreshed when the modification time of its directory
+/// changes, which is checked at most once a second. Listings can also be
+/// kept in a cache directory so that later debug sessions don't have to list
+/// large symbol stores again.
+//----------------------------------------------------------------------
+class DebugFileIndex {
+public:
+  /// Return the index stored in \a cache_dir. An empty \a cache_dir gives an
+  /// index that is only kept in memory.
+  static DebugFileIndex &Get(const FileSpec &cache_dir);
+
+  explicit DebugFileIndex(const FileSpec &cache_dir);
+
+  /// Return false if \a path certainly doesn't exist. True means it is
+  /// listed in its directory, and still needs to be checked.
+  bool MayExist(llvm::StringRef path);
+
+  /// Return true if \a path is a directory that can be listed.
+  bool IsDirectory(llvm::StringRef path);
+
+  /// Write the listings back to the cache directory if any were made since
+  /// the index was loaded.
+  Status Save();
+
+  /// Save every index. Lookups happen for every module that is loaded, so
+  /// the listings are only written out once, when LLDB terminates.
+  static void SaveAll();
+
+  FileSpec GetFileSpec() const { return m_file_spec; }
+
+  /// Index statistics, accumulated over all indexes.
+  /// @{
+  /// The number of candidate paths rejected without touching the file
+  /// system.
+  static uint64_t GetLookupsAvoided() { return g_lookups_avoided; }
+  /// The number of directories that had to be listed.
+  static uint64_t GetDirectoriesScanned() { return g_directories_scanned; }
+  /// @}
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Directory {
+    bool exists = false;
+    int64_t mtime = 0;
+    /// When the modification time was last compared to the file system.
+    /// Listings loaded from the cache are always compared first.
+    Clock::time_point validated;
+    llvm::StringSet<> entries;
+  };
+
+  /// Return the listing of \a path, listing it again if it changed.
+  const Directory &GetDirectory(llvm::StringRef path);
+
+  void Load();
+
+  static std::atomic<uint64_t> g_lookups_avoided;
+  static std::atomic<uint64_t> g_directories_scanned;
+
+  const FileSpec m_cache_dir;
+  const FileSpec m_file_spec;
+
+  std::mutex m_mutex;
+  llvm::StringMap<Directory> m_directories;
+  bool m_loaded = false;
+  bool m_dirty = false;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_DebugFileIndex_h_
@@ -38,15 +38,12 @@ public:
   // Run all of the specified tasks on the task pool and wait until all of them
   // are finished before returning. This method is intended to be used for
   // small number tasks where listing them as function arguments is acceptable.
-  // For running large number of tasks you should use AddTask for each task and
-  // then call wait() on each returned future.
+  // The calling thread runs tasks too, see TaskMapOverInt.
   template <typename... T> static void RunTasks(T &&... tasks);
 
 private:
   TaskPool() = delete;
 
-  template <typename... T> struct RunTaskImpl;
-
   static void AddTaskImpl(std::function<void()> &&task_fn);
 };
 
@@ -62,29 +59,20 @@ TaskPool::AddTask(F &&f, Args &&... args) {
   return task_sp->get_future();
 }
 
-template <typename... T> void TaskPool::RunTasks(T &&... tasks) {
-  RunTaskImpl<T...>::Run(std::forward<T>(tasks)...);
-}
-
-template <typename Head, typename... Tail>
-struct TaskPool::RunTaskImpl<Head, Tail...> {
-  static void Run(Head &&h, Tail &&... t) {
-    auto f = AddTask(std::forward<Head>(h));
-    RunTaskImpl<Tail...>::Run(std::forward<Tail>(t)...);
-    f.wait();
-  }
-};
-
-template <> struct TaskPool::RunTaskImpl<> {
-  static void Run() {}
-};
-
-// Run 'func' on every value from begin .. end-1.  Each worker will grab
-// 'batch_size' numbers at a time to work on, so for very fast functions, batch
-// should be large enough to avoid too much cache line contention.
+// Run 'func' on every value from begin .. end-1, on the task pool and on the
+// calling thread. The calling thread only waits for values that other threads
+// already started working on, so it is safe to call this from a task running
+// on the pool, including from 'func' itself, even when every pool thread is
+// busy.
 void TaskMapOverInt(size_t begin, size_t end,
                     const llvm::function_ref<void(size_t)> &func);
 
+template <typename... T> void TaskPool::RunTasks(T &&... tasks) {
+  std::function<void()> task_fns[] = {
+      std::function<void()>(std::forward<T>(tasks))...};
+  TaskMapOverInt(0, sizeof...(T), [&task_fns](size_t idx) { task_fns[idx](); });
+}
+
 unsigned GetHardwareConcurrencyHint();
 
 } // namespace lldb_private
@@ -14,6 +14,7 @@
 #include "NativeWatchpointList.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/MainLoop.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/TraceOptions.h"
@@ -110,6 +111,14 @@ public:
 
   virtual Status RemoveBreakpoint(lldb::addr_t addr, bool hardware = false);
 
+  //----------------------------------------------------------------------
+  /// Attach conditions to the software breakpoint at \a addr. A hit is only
+  /// reported when one of the conditions evaluates to non-zero. An empty list
+  /// makes the breakpoint unconditional again.
+  //----------------------------------------------------------------------
+  Status SetBreakpointConditions(lldb::addr_t addr,
+                                 std::vector<AgentExpression> conditions);
+
   //----------------------------------------------------------------------
   // Hardware Breakpoint functions
   //----------------------------------------------------------------------
@@ -401,6 +410,7 @@ protected:
     uint32_t ref_count;
     llvm::SmallVector<uint8_t, 4> saved_opcodes;
     llvm::ArrayRef<uint8_t> breakpoint_opcodes;
+    std::vector<AgentExpression> conditions;
   };
 
   std::unordered_map<lldb::addr_t, SoftwareBreakpoint> m_software_breakpoints;
@@ -465,6 +475,17 @@ protected:
   // resets it to point to the breakpoint itself.
   void FixupBreakpointPCAsNeeded(NativeThreadProtocol &thread);
 
+  // Return false if the software breakpoint at addr has conditions and all of
+  // them evaluate to zero for thread. A condition that can't be evaluated
+  // counts as true, so the client gets to decide.
+  bool ShouldReportBreakpointHit(NativeThreadProtocol &thread,
+                                 lldb::addr_t addr);
+
+  // Write either the trap or the saved opcodes of the software breakpoint at
+  // addr, without changing its reference count. Used to step a thread over a
+  // breakpoint whose condition was false.
+  Status WriteSoftwareBreakpointOpcodes(lldb::addr_t addr, bool trap);
+
   // -----------------------------------------------------------
   /// Notify the delegate that an exec occurred.
   ///
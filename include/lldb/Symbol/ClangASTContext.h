@@ -64,6 +64,8 @@ public:
 
   void Finalize() override;
 
+  size_t GetMemoryUsage() override;
+
   //------------------------------------------------------------------
   // PluginInterface functions
   //------------------------------------------------------------------
@@ -467,6 +469,11 @@ public:
   DWARFASTParser *GetDWARFParser() override;
   PDBASTParser *GetPDBParser();
 
+  // Whether the DWARF parser may leave member functions out of the classes
+  // it completes. Decided when the AST is created, together with whether
+  // the AST's name lookups can find them later.
+  bool GetLazyMemberFunctions() const { return m_lazy_member_functions; }
+
   //------------------------------------------------------------------
   // ClangASTContext callbacks for external source lookups.
   //------------------------------------------------------------------
@@ -475,6 +482,11 @@ public:
   static void CompleteObjCInterfaceDecl(void *baton,
                                         clang::ObjCInterfaceDecl *);
 
+  static void FindExternalVisibleDeclsByName(
+      void *baton, const clang::DeclContext *decl_ctx,
+      clang::DeclarationName name,
+      llvm::SmallVectorImpl<clang::NamedDecl *> *results);
+
   static bool LayoutRecordType(
       void *baton, const clang::RecordDecl *record_decl, uint64_t &size,
       uint64_t &alignment,
@@ -1079,6 +1091,7 @@ protected:
     uint32_t                                        m_pointer_byte_size;
     bool                                            m_ast_owned;
     bool                                            m_can_evaluate_expressions;
+    bool                                            m_lazy_member_functions;
   // clang-format on
 private:
   //------------------------------------------------------------------
@@ -209,6 +209,34 @@ public:
   void ForgetDestination(clang::ASTContext *dst_ctx);
   void ForgetSource(clang::ASTContext *dst_ctx, clang::ASTContext *src_ctx);
 
+  //
+  // Lookup cache
+  //
+  // Expressions look up the same names in the target's images over and over.
+  // The importer lives as long as the target's images don't change, so it
+  // remembers the results of searching all images for a type or namespace by
+  // name, including searches that found nothing. The cache must be cleared
+  // whenever images are added or removed.
+  //
+
+  /// Return true and set \a type_sp if all images were searched for a type
+  /// named \a name before. \a type_sp is empty if none was found.
+  bool LookupCachedType(ConstString name, lldb::TypeSP &type_sp);
+
+  void CacheTypeLookup(ConstString name, const lldb::TypeSP &type_sp);
+
+  /// Return the namespaces named \a name found in all images before, or
+  /// nullptr if all images weren't searched for that name yet.
+  NamespaceMapSP LookupCachedNamespaces(ConstString name);
+
+  void CacheNamespaceLookup(ConstString name,
+                            const NamespaceMapSP &namespace_map);
+
+  void ClearLookupCache();
+
+  uint64_t GetLookupCacheHits() const { return m_lookup_cache_hits; }
+  uint64_t GetLookupCacheMisses() const { return m_lookup_cache_misses; }
+
 private:
   struct DeclOrigin {
     DeclOrigin() : ctx(nullptr), decl(nullptr) {}
@@ -340,6 +368,12 @@ private:
       RecordDeclToLayoutMap;
 
   RecordDeclToLayoutMap m_record_decl_to_layout_map;
+
+  /// Lookup caches, keyed by the names' ConstString pointers.
+  llvm::DenseMap<const char *, lldb::TypeSP> m_type_lookup_cache;
+  llvm::DenseMap<const char *, NamespaceMapSP> m_namespace_lookup_cache;
+  uint64_t m_lookup_cache_hits = 0;
+  uint64_t m_lookup_cache_misses = 0;
 };
 
 } // namespace lldb_private
@@ -245,6 +245,16 @@ public:
   //------------------------------------------------------------------
   LineTable *GetLineTable();
 
+  //------------------------------------------------------------------
+  /// Get an estimate of the memory used by the line table, without parsing
+  /// it.
+  ///
+  /// @return
+  ///     The number of bytes used by the line table, or zero if it hasn't
+  ///     been parsed yet.
+  //------------------------------------------------------------------
+  size_t GetLineTableMemoryUsage() const;
+
   DebugMacros *GetDebugMacros();
 
   //------------------------------------------------------------------
@@ -0,0 +1,103 @@
+//===-- FileCRCCache.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_FileCRCCache_h_
+#define liblldb_FileCRCCache_h_
+
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Status.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class FileCRCCache FileCRCCache.h "lldb/Symbol/FileCRCCache.h"
+/// Remembers the CRC32 of the contents of files, in memory and in a
+/// directory shared across debug sessions.
+///
+/// ELF files without a build ID are identified by the CRC32 of the whole
+/// file, the same checksum .gnu_debuglink uses. That takes seconds for
+/// large unstripped binaries, so results are keyed by the file's path,
+/// size, modification time, device and inode, and reused as long as
+/// none of them changes.
+//----------------------------------------------------------------------
+class FileCRCCache {
+public:
+  /// Return the cache stored in \a cache_dir. An empty \a cache_dir gives a
+  /// cache that is only kept in memory.
+  static FileCRCCache &Get(const FileSpec &cache_dir);
+
+  /// Return the CRC32 of \a contents, the bytes of \a file starting at
+  /// \a offset, computing it only if it isn't cached yet.
+  uint32_t GetCRC32(const FileSpec &file, uint64_t offset,
+                    llvm::ArrayRef<uint8_t> contents);
+
+  /// Continue the CRC32 \a crc with \a data. Large buffers are split into
+  /// chunks that are checksummed concurrently.
+  static uint32_t CalculateCRC32(uint32_t crc, llvm::ArrayRef<uint8_t> data);
+
+  FileSpec GetFileSpec() const { return m_file_spec; }
+
+  /// Cache statistics, accumulated over all caches.
+  /// @{
+  static uint64_t GetCacheHits() { return g_cache_hits; }
+  static uint64_t GetCacheMisses() { return g_cache_misses; }
+  /// The time it took to compute the checksums that were found in a cache.
+  static double GetSecondsSaved();
+  /// @}
+
+  explicit FileCRCCache(const FileSpec &cache_dir);
+
+private:
+  struct Key {
+    std::string path;
+    uint64_t offset;
+    uint64_t length;
+    uint64_t file_size;
+    int64_t mtime;
+    uint64_t device;
+    uint64_t inode;
+
+    bool operator<(const Key &rhs) const {
+      return std::tie(path, offset, length, file_size, mtime, device, inode) <
+             std::tie(rhs.path, rhs.offset, rhs.length, rhs.file_size,
+                      rhs.mtime, rhs.device, rhs.inode);
+    }
+  };
+
+  struct Entry {
+    uint32_t crc;
+    /// How long computing the checksum took.
+    double seconds;
+  };
+
+  void Load();
+  Status Save();
+
+  static std::atomic<uint64_t> g_cache_hits;
+  static std::atomic<uint64_t> g_cache_misses;
+  static std::atomic<uint64_t> g_microseconds_saved;
+
+  const FileSpec m_cache_dir;
+  const FileSpec m_file_spec;
+
+  std::mutex m_mutex;
+  std::map<Key, Entry> m_entries;
+  bool m_loaded = false;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_FileCRCCache_h_
@@ -197,6 +197,14 @@ public:
   //------------------------------------------------------------------
   uint32_t GetSize() const;
 
+  //------------------------------------------------------------------
+  /// Gets an estimate of the memory used by the line table entries.
+  ///
+  /// @return
+  ///     The number of bytes allocated for the line table entries.
+  //------------------------------------------------------------------
+  size_t GetMemoryUsage() const;
+
   typedef lldb_private::RangeArray<lldb::addr_t, lldb::addr_t, 32>
       FileAddressRanges;
 
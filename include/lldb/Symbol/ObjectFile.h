@@ -400,6 +400,15 @@ public:
   //------------------------------------------------------------------
   virtual void ClearSymtab();
 
+  //------------------------------------------------------------------
+  /// Gets the symbol table if it has been parsed already.
+  ///
+  /// @return
+  ///     The symbol table for this object file, or NULL if GetSymtab()
+  ///     hasn't created it yet.
+  //------------------------------------------------------------------
+  Symtab *GetParsedSymtab() const { return m_symtab_up.get(); }
+
   //------------------------------------------------------------------
   /// Gets the UUID for this object file.
   ///
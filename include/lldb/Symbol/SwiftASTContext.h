@@ -63,6 +63,7 @@ class SwiftEnumDescriptor;
 namespace lldb_private {
 
 struct SourceModule;
+class SwiftPersistentTypeCache;
 
 class SwiftASTContext : public TypeSystem {
 public:
@@ -151,6 +152,12 @@ public:
                                            Target &target,
                                            const char *extra_options);
 
+  /// Start creating the per-module contexts of the Swift modules in
+  /// \p module_list on a background thread. Anyone who asks a module for
+  /// its Swift type system before that finishes waits for just that
+  /// module.
+  static void CreateModuleContextsInBackground(const ModuleList &module_list);
+
   static void EnumerateSupportedLanguages(
       std::set<lldb::LanguageType> &languages_for_types,
       std::set<lldb::LanguageType> &languages_for_expressions);
@@ -856,6 +863,9 @@ protected:
 
   typedef ThreadSafeDenseSet<const char *> SwiftMangledNameSet;
   SwiftMangledNameSet m_negative_type_cache;
+  /// Failures carried over from earlier debug sessions. Only module
+  /// contexts have one.
+  std::unique_ptr<SwiftPersistentTypeCache> m_persistent_type_cache;
 
   typedef ThreadSafeDenseMap<const char *, lldb::TypeSP> SwiftTypeMap;
   SwiftTypeMap m_swift_type_map;
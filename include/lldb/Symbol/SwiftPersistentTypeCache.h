@@ -0,0 +1,147 @@
+//===-- SwiftPersistentTypeCache.h ------------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_SwiftPersistentTypeCache_h_
+#define liblldb_SwiftPersistentTypeCache_h_
+
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Status.h"
+#include "lldb/Utility/UUID.h"
+
+#include "llvm/ADT/StringMap.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class SwiftPersistentTypeCache SwiftPersistentTypeCache.h
+/// "lldb/Symbol/SwiftPersistentTypeCache.h"
+/// An on-disk record of the work a module's SwiftASTContext did in
+/// earlier debug sessions.
+///
+/// Reconstructed types and loaded modules are AST nodes and can't
+/// outlive the swift::ASTContext that created them, so what is kept
+/// across sessions is the outcome of the expensive searches: where each
+/// module was imported from, mangled names that couldn't be reconstructed
+/// and modules that couldn't be imported. A warm session answers those from
+/// the cache instead of searching every import path again.
+///
+/// The cache for a module is keyed by the module's UUID and by a context
+/// string that describes everything else imports depend on: the compiler
+/// version, target, SDK, search paths and clang arguments. It also records
+/// where every successfully imported module was loaded from and when that
+/// file was last modified; if any of those files changed, the whole cache
+/// is considered stale and starts out empty. A failure can also be caused
+/// by something the cache doesn't track, like a module that was missing
+/// and has since been built, so failures expire after a while.
+//----------------------------------------------------------------------
+class SwiftPersistentTypeCache {
+public:
+  //------------------------------------------------------------------
+  /// Load the cache for a module from \a cache_dir. Failures recorded more
+  /// than \a failure_lifetime ago are dropped.
+  ///
+  /// @return
+  ///     A cache, possibly empty if nothing was cached yet or the cached
+  ///     data is stale, or nullptr if \a cache_dir or \a uuid is invalid
+  ///     or \a max_size is zero. \a max_size bounds the size of all the
+  ///     files in \a cache_dir together.
+  //------------------------------------------------------------------
+  static std::unique_ptr<SwiftPersistentTypeCache>
+  Open(const FileSpec &cache_dir, const UUID &uuid, llvm::StringRef context,
+       uint64_t max_size,
+       std::chrono::seconds failure_lifetime = std::chrono::hours(24 * 7));
+
+  ~SwiftPersistentTypeCache();
+
+  /// Return true if reconstructing \a mangled_name failed in an earlier
+  /// session.
+  bool IsKnownTypeFailure(llvm::StringRef mangled_name);
+
+  void RecordTypeFailure(llvm::StringRef mangled_name);
+
+  /// Return true if importing the module \a name failed in an earlier
+  /// session.
+  bool IsKnownImportFailure(llvm::StringRef name);
+
+  /// Record that the module \a name was imported from \a path, or that it
+  /// couldn't be imported if \a path is empty.
+  void RecordImport(llvm::StringRef name, llvm::StringRef path);
+
+  /// Return the file the module \a name was imported from in an earlier
+  /// session, or an empty string.
+  std::string GetImportPath(llvm::StringRef name);
+
+  /// Write the cache back to disk if anything was recorded since it was
+  /// loaded, then trim the cache directory to the size limit.
+  Status Save();
+
+  FileSpec GetFileSpec() const { return m_file_spec; }
+
+  /// Save every open cache. Modules in the shared module list may never be
+  /// destroyed, so this runs when LLDB terminates.
+  static void SaveAll();
+
+  /// Cache statistics, accumulated over all modules.
+  /// @{
+  static uint64_t GetCacheHits() { return g_cache_hits; }
+  static uint64_t GetCacheMisses() { return g_cache_misses; }
+  /// @}
+
+  /// Delete the least recently written cache files in \a cache_dir until
+  /// the files there take up no more than \a max_size bytes.
+  static void Prune(const FileSpec &cache_dir, uint64_t max_size);
+
+private:
+  /// Failures, with the time they were recorded at.
+  typedef llvm::StringMap<int64_t> FailureMap;
+
+  SwiftPersistentTypeCache(const FileSpec &cache_dir,
+                           const FileSpec &file_spec, uint64_t max_size,
+                           std::chrono::seconds failure_lifetime)
+      : m_cache_dir(cache_dir), m_file_spec(file_spec), m_max_size(max_size),
+        m_failure_lifetime(failure_lifetime) {}
+
+  bool Load();
+  bool LoadFailure(FailureMap &failures, llvm::StringRef entry,
+                   size_t line_size);
+  bool CanGrow(size_t entry_size);
+  bool Lookup(const FailureMap &failures, llvm::StringRef key);
+  void RecordFailure(FailureMap &failures, llvm::StringRef kind,
+                     llvm::StringRef key);
+
+  static std::atomic<uint64_t> g_cache_hits;
+  static std::atomic<uint64_t> g_cache_misses;
+
+  const FileSpec m_cache_dir;
+  const FileSpec m_file_spec;
+  const uint64_t m_max_size;
+  const std::chrono::seconds m_failure_lifetime;
+
+  std::mutex m_mutex;
+  FailureMap m_type_failures;
+  FailureMap m_import_failures;
+  /// Module name to the file it was imported from.
+  llvm::StringMap<std::string> m_imports;
+  /// Approximate size of the cache file.
+  uint64_t m_size = 0;
+  bool m_dirty = false;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_SwiftPersistentTypeCache_h_
@@ -296,6 +296,14 @@ public:
                                              uint32_t actual_line);
   virtual void Dump(Stream &s) {}
 
+  /// Print per-module loading statistics for "statistics dump". Print
+  /// nothing if there is nothing worth reporting.
+  virtual void DumpStatistics(Stream &s) {}
+
+  /// Return an estimate of the memory held by the debug information parsed
+  /// so far, not counting line tables and types, in bytes.
+  virtual size_t GetDebugInfoMemoryUsage() { return 0; }
+
 protected:
   class SourceRange {
   public:
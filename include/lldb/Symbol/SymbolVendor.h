@@ -119,6 +119,10 @@ public:
 
   virtual lldb::CompUnitSP GetCompileUnitAtIndex(size_t idx);
 
+  // Return an estimate of the memory used by the line tables parsed so far.
+  // Compile units and line tables that haven't been parsed yet are skipped.
+  size_t GetLineTableMemoryUsage();
+
   TypeList &GetTypeList() { return m_type_list; }
 
   const TypeList &GetTypeList() const { return m_type_list; }
@@ -44,6 +44,9 @@ public:
   Symbol *Resize(size_t count);
   uint32_t AddSymbol(const Symbol &symbol);
   size_t GetNumSymbols() const;
+  /// Return an estimate of the memory used by the symbols and the lookup
+  /// tables built from them, in bytes.
+  size_t GetMemoryUsage() const;
   void
   Dump(Stream *s, Target *target, SortOrder sort_type,
        Mangled::NamePreference name_preference = Mangled::ePreferDemangled);
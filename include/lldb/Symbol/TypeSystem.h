@@ -94,6 +94,10 @@ public:
   // removing all the TypeSystems from the TypeSystemMap.
   virtual void Finalize() {}
 
+  // Return an estimate of the memory held by the types created so far, in
+  // bytes.
+  virtual size_t GetMemoryUsage() { return 0; }
+
   virtual DWARFASTParser *GetDWARFParser() { return nullptr; }
 
   virtual SymbolFile *GetSymbolFile() const { return m_sym_file; }
@@ -179,6 +179,8 @@ public:
 
   virtual void ModulesDidLoad(const ModuleList &module_list) {}
 
+  virtual void ModulesDidUnload(const ModuleList &module_list) {}
+
   // Called by the Clang expression evaluation engine to allow runtimes to
   // alter the set of target options provided to the compiler. If the options
   // prototype is modified, runtimes must return true, false otherwise.
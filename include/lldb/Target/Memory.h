@@ -17,6 +17,8 @@
 #include "lldb/Core/RangeMap.h"
 #include "lldb/lldb-private.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 namespace lldb_private {
 //----------------------------------------------------------------------
 // A class to track memory that was read from a live process between
@@ -37,6 +39,11 @@ public:
 
   size_t Read(lldb::addr_t addr, void *dst, size_t dst_len, Status &error);
 
+  // Read the cache lines holding each of the addresses in \a addrs that
+  // aren't cached yet. Lines close to each other are read from the process
+  // at once, and the cache isn't locked while reading.
+  void Prefetch(llvm::ArrayRef<lldb::addr_t> addrs);
+
   uint32_t GetMemoryCacheLineSize() const { return m_L2_cache_line_byte_size; }
 
   void AddInvalidRange(lldb::addr_t base_addr, lldb::addr_t byte_size);
@@ -65,6 +72,9 @@ protected:
   InvalidRanges m_invalid_ranges;
   Process &m_process;
   uint32_t m_L2_cache_line_byte_size;
+  // Bumped whenever cached memory is thrown away, so that a prefetch doesn't
+  // add memory that was written to while it was being read.
+  uint32_t m_flush_id = 0;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(MemoryCache);
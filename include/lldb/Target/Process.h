@@ -1519,6 +1519,11 @@ public:
   //------------------------------------------------------------------
   virtual void ModulesDidLoad(ModuleList &module_list);
 
+  //------------------------------------------------------------------
+  // Notify this process class that modules got unloaded.
+  //------------------------------------------------------------------
+  void ModulesDidUnload(ModuleList &module_list);
+
   //------------------------------------------------------------------
   /// Retrieve the list of shared libraries that are loaded for this process
   /// This method is used on pre-macOS 10.12, pre-iOS 10, pre-tvOS 10, pre-
@@ -1808,6 +1813,16 @@ public:
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  //------------------------------------------------------------------
+  /// Read the memory at each of \a addrs into the memory cache ahead of
+  /// time.
+  ///
+  /// Addresses that are close together are read from the inferior at once,
+  /// so this takes fewer round trips than reading each of them when it is
+  /// first needed. Does nothing when the memory cache is disabled.
+  //------------------------------------------------------------------
+  void PrefetchMemory(llvm::ArrayRef<lldb::addr_t> addrs);
+
   //------------------------------------------------------------------
   /// Reads an unsigned integer of the specified byte size from process
   /// memory.
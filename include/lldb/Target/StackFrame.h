@@ -23,6 +23,8 @@
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/UserID.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 namespace lldb_private {
 
 /// @class StackFrame StackFrame.h "lldb/Target/StackFrame.h"
@@ -468,6 +470,28 @@ public:
   lldb::ValueObjectSP TrackGlobalVariable(const lldb::VariableSP &variable_sp,
                                           lldb::DynamicValueType use_dynamic);
 
+  //------------------------------------------------------------------
+  /// Compute the dynamic types and summaries of a set of this frame's
+  /// variables ahead of displaying them.
+  ///
+  /// When target.experimental.prefetch-variable-memory is set, the static
+  /// values are read first, then the memory the variables point to is read
+  /// into the process memory cache with Process::PrefetchMemory, while the
+  /// process is held stopped. The dynamic types and summaries are then
+  /// computed one variable at a time, finding that memory already read.
+  /// The results are cached in the ValueObjects, so printing them afterwards
+  /// in declaration order does no further work. Otherwise this does nothing
+  /// and each value is computed lazily when it is displayed.
+  ///
+  /// @params [in] valobjs
+  ///   ValueObjects returned by GetValueObjectForFrameVariable.
+  ///
+  /// @params [in] use_dynamic
+  ///   The dynamic value type the values will be displayed with.
+  //------------------------------------------------------------------
+  void MaterializeValueObjects(llvm::ArrayRef<lldb::ValueObjectSP> valobjs,
+                               lldb::DynamicValueType use_dynamic);
+
   //------------------------------------------------------------------
   /// Query this frame to determine what the default language should be when
   /// parsing expressions given the execution context.
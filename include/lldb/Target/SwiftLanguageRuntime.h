@@ -15,6 +15,7 @@
 
 // C Includes
 // C++ Includes
+#include <atomic>
 #include <mutex>
 #include <tuple>
 #include <vector>
@@ -209,6 +210,21 @@ public:
 
   void ModulesDidLoad(const ModuleList &module_list) override;
 
+  void ModulesDidUnload(const ModuleList &module_list) override;
+
+  /// Counters for the class metadata cache and the memory reader, for
+  /// "statistics dump".
+  struct MetadataCacheStatistics {
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+    /// Reads served from the file images of loaded modules.
+    uint64_t file_image_reads = 0;
+    /// Reads that went to the process.
+    uint64_t memory_reads = 0;
+  };
+
+  MetadataCacheStatistics GetMetadataCacheStatistics();
+
   virtual bool GetObjectDescription(Stream &str, ValueObject &object) override;
 
   virtual bool GetObjectDescription(Stream &str, Value &value,
@@ -440,6 +456,10 @@ protected:
 
   void PopLocalBuffer();
 
+  /// Let the memory reader serve reflection metadata of \p module from the
+  /// module's file.
+  void AddFileImage(Module &module);
+
   /// We have to load swift dependent libraries by hand, but if they
   /// are missing, we shouldn't keep trying.
   llvm::StringSet<> m_library_negative_cache;
@@ -457,6 +477,15 @@ protected:
                  std::unique_ptr<swift::remoteAST::RemoteASTContext>>
       m_remote_ast_contexts;
 
+  /// The type each class metadata address resolved to, per AST context.
+  /// Cleared whenever images are loaded or unloaded.
+  llvm::DenseMap<std::pair<swift::ASTContext *, lldb::addr_t>,
+                 swift::TypeBase *>
+      m_class_metadata_cache;
+  std::mutex m_class_metadata_cache_mutex;
+  std::atomic<uint64_t> m_class_metadata_cache_hits{0};
+  std::atomic<uint64_t> m_class_metadata_cache_misses{0};
+
   /// Uses ConstStrings as keys to avoid storing the strings twice.
   llvm::DenseMap<const char *, lldb::SyntheticChildrenSP> m_bridged_synthetics_map;
 
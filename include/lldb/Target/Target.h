@@ -26,6 +26,7 @@
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/UserSettingsController.h"
 #include "lldb/Expression/Expression.h"
+#include "lldb/Expression/ExpressionCache.h"
 #include "lldb/Interpreter/OptionValueBoolean.h"
 #include "lldb/Interpreter/OptionValueEnumeration.h"
 #include "lldb/Interpreter/OptionValueFileSpec.h"
@@ -149,6 +150,12 @@ public:
 
   bool GetSwiftCreateModuleContextsInParallel() const;
 
+  bool GetSwiftCreateModuleContextsInBackground() const;
+
+  bool GetPrefetchVariableMemory() const;
+
+  bool GetLazyClangTypeImport() const;
+
   bool GetEnableAutoImportClangModules() const;
 
   bool GetUseAllCompilerFlags() const;
@@ -159,10 +166,14 @@ public:
 
   bool GetEnableSaveObjects() const;
 
+  uint32_t GetExpressionCacheSize() const;
+
   bool GetEnableSyntheticValue() const;
 
   uint32_t GetMaximumNumberOfChildrenToDisplay() const;
 
+  uint32_t GetMaximumSyntheticNodeCacheSize() const;
+
   uint32_t GetMaximumSizeOfStringSummary() const;
 
   uint32_t GetMaximumMemReadSize() const;
@@ -1163,6 +1174,10 @@ public:
       Expression::ResultType desired_type,
       const EvaluateExpressionOptions &options, Status &error);
 
+  /// Parsed expressions kept for UserExpression::Evaluate, see the
+  /// target.expression-cache-size setting.
+  ExpressionCache &GetExpressionCache() { return m_expression_cache; }
+
   // Creates a FunctionCaller for the given language, the rest of the
   // parameters have the same meaning as for the FunctionCaller constructor.
   // Since a FunctionCaller can't be
@@ -1507,6 +1522,8 @@ protected:
   /// Guards the scratch typesystem from being re-initialized.
   SharedMutex m_scratch_typesystem_lock;
 
+  ExpressionCache m_expression_cache;
+
   static void ImageSearchPathsChanged(const PathMappingList &path_list,
                                       void *baton);
 
@@ -0,0 +1,126 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AgentExpression_h_
+#define liblldb_AgentExpression_h_
+
+#include "lldb/lldb-types.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Error.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class AgentExpression AgentExpression.h "lldb/Utility/AgentExpression.h"
+/// A GDB agent expression: the stack machine bytecode the gdb-remote
+/// protocol uses for breakpoint conditions evaluated by the stub (the
+/// cond_list of a Z0 packet).
+///
+/// Only the integer subset is supported; tracing, trace state variables,
+/// floating point and printf opcodes are rejected by Evaluate().
+//----------------------------------------------------------------------
+class AgentExpression {
+public:
+  enum Opcode : uint8_t {
+    eOpAdd = 0x02,
+    eOpSub = 0x03,
+    eOpMul = 0x04,
+    eOpDivSigned = 0x05,
+    eOpDivUnsigned = 0x06,
+    eOpRemSigned = 0x07,
+    eOpRemUnsigned = 0x08,
+    eOpLsh = 0x09,
+    eOpRshSigned = 0x0a,
+    eOpRshUnsigned = 0x0b,
+    eOpLogNot = 0x0e,
+    eOpBitAnd = 0x0f,
+    eOpBitOr = 0x10,
+    eOpBitXor = 0x11,
+    eOpBitNot = 0x12,
+    eOpEqual = 0x13,
+    eOpLessSigned = 0x14,
+    eOpLessUnsigned = 0x15,
+    eOpExt = 0x16,
+    eOpRef8 = 0x17,
+    eOpRef16 = 0x18,
+    eOpRef32 = 0x19,
+    eOpRef64 = 0x1a,
+    eOpIfGoto = 0x20,
+    eOpGoto = 0x21,
+    eOpConst8 = 0x22,
+    eOpConst16 = 0x23,
+    eOpConst32 = 0x24,
+    eOpConst64 = 0x25,
+    eOpReg = 0x26,
+    eOpEnd = 0x27,
+    eOpDup = 0x28,
+    eOpPop = 0x29,
+    eOpZeroExt = 0x2a,
+    eOpSwap = 0x2b,
+    eOpPick = 0x32,
+    eOpRot = 0x33,
+  };
+
+  typedef llvm::function_ref<llvm::Optional<uint64_t>(uint32_t regnum)>
+      ReadRegisterCallback;
+  typedef llvm::function_ref<llvm::Optional<uint64_t>(lldb::addr_t addr,
+                                                      size_t size)>
+      ReadMemoryCallback;
+
+  AgentExpression() = default;
+  explicit AgentExpression(llvm::ArrayRef<uint8_t> bytes)
+      : m_bytes(bytes.begin(), bytes.end()) {}
+
+  llvm::ArrayRef<uint8_t> GetBytes() const { return m_bytes; }
+  size_t GetSize() const { return m_bytes.size(); }
+
+  //------------------------------------------------------------------
+  /// @name Building expressions
+  //------------------------------------------------------------------
+  void Emit(Opcode op) { m_bytes.push_back(op); }
+
+  /// Push \a value using the smallest constN opcode that holds it.
+  void EmitConstant(uint64_t value);
+
+  void EmitRegister(uint16_t regnum);
+
+  /// Load a \a byte_size byte unsigned value from the address on the stack.
+  /// Returns false for sizes other than 1, 2, 4 and 8.
+  bool EmitLoad(size_t byte_size);
+
+  /// Sign or zero extend the top of the stack from \a bits bits. Nothing is
+  /// emitted for 64 bit values.
+  void EmitExtend(unsigned bits, bool is_signed);
+
+  /// Emit a goto or if_goto with a placeholder target and return the offset
+  /// to pass to PatchJump() once the target is known.
+  size_t EmitJump(Opcode op);
+  void PatchJump(size_t jump_offset, size_t target);
+
+  //------------------------------------------------------------------
+  /// Run the expression and return the value on the top of the stack when
+  /// it reaches the end opcode.
+  //------------------------------------------------------------------
+  llvm::Expected<uint64_t> Evaluate(ReadRegisterCallback read_register,
+                                    ReadMemoryCallback read_memory) const;
+
+private:
+  void EmitBigEndian(uint64_t value, size_t byte_size);
+
+  std::vector<uint8_t> m_bytes;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_AgentExpression_h_
@@ -0,0 +1,114 @@
+//===-- AsyncLogStream.h ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AsyncLogStream_h_
+#define liblldb_AsyncLogStream_h_
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace lldb_private {
+
+/// A log stream that hands messages off to a background thread.
+///
+/// Every thread writing to the stream gets its own fixed size ring buffer, so
+/// writers never wait on each other or on I/O. A background thread drains
+/// the rings, orders the messages by the time they were written, and
+/// forwards them to the underlying stream. When a writer's ring is full its
+/// message is dropped and counted instead of blocking. The ring of a thread
+/// that exited is freed once it has been drained.
+///
+/// If a history size is given, messages are not forwarded as they arrive.
+/// Only the most recent history_size bytes are kept in memory, and they are
+/// written to the underlying stream by DumpHistory(). If \a crash_fd is a
+/// file descriptor, they are also written to it when LLDB crashes.
+class AsyncLogStream : public llvm::raw_ostream {
+public:
+  static const size_t DefaultRingSize = 256 * 1024;
+
+  AsyncLogStream(std::shared_ptr<llvm::raw_ostream> stream_sp,
+                 size_t history_size = 0, size_t ring_size = DefaultRingSize,
+                 int crash_fd = -1);
+  ~AsyncLogStream() override;
+
+  /// Forward everything written so far. In history mode this only moves the
+  /// messages into the history.
+  void Drain();
+
+  /// Drain, then write and clear the retained history.
+  void DumpHistory();
+
+  /// The number of messages dropped because a writer's ring was full.
+  uint64_t GetDroppedCount() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+  /// Return the AsyncLogStream \a stream is, or nullptr.
+  static AsyncLogStream *Find(const llvm::raw_ostream *stream);
+
+private:
+  class Ring;
+
+  void write_impl(const char *ptr, size_t size) override;
+  uint64_t current_pos() const override;
+
+  Ring *GetRingForCurrentThread();
+  void WriterThread();
+  void Emit(llvm::StringRef message);
+
+  /// Call \a callback with the retained history, in at most two pieces. If
+  /// older messages were overwritten, the history starts at the first
+  /// complete one. Safe to call from a signal handler.
+  template <typename Callback> void ForEachHistoryPiece(Callback &&callback);
+
+  static void DumpHistoriesOnCrash(void *);
+
+  std::shared_ptr<llvm::raw_ostream> m_stream_sp;
+  const size_t m_history_size;
+  const size_t m_ring_size;
+  const int m_crash_fd;
+  // Unique for the life of the process, so threads can cache their ring
+  // without worrying about a new stream reusing this one's address.
+  const uint64_t m_id;
+
+  std::atomic<uint64_t> m_sequence{0};
+  std::atomic<uint64_t> m_bytes_written{0};
+  std::atomic<uint64_t> m_dropped{0};
+
+  std::mutex m_rings_mutex;
+  std::vector<std::shared_ptr<Ring>> m_rings;
+
+  // Held while consuming from the rings and while writing the history.
+  std::mutex m_drain_mutex;
+  uint64_t m_dropped_reported = 0;
+  // A byte ring of m_history_size bytes, allocated up front so that the
+  // crash handler can write it out as is. The positions only grow; the
+  // history is what lies between them, modulo the buffer size.
+  std::unique_ptr<char[]> m_history;
+  std::atomic<size_t> m_history_begin{0};
+  std::atomic<size_t> m_history_end{0};
+
+  std::mutex m_wake_mutex;
+  std::condition_variable m_wake_cv;
+  bool m_stop = false;
+  std::thread m_thread;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_AsyncLogStream_h_
@@ -0,0 +1,80 @@
+//===-- BloomFilter.h -------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_BloomFilter_h_
+#define liblldb_BloomFilter_h_
+
+#include "lldb/Utility/ConstString.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class BloomFilter BloomFilter.h "lldb/Utility/BloomFilter.h"
+/// A compact set of names that can only answer "maybe" or "certainly not".
+///
+/// Lookups by name go through the name indexes of every module, and most
+/// names are in a single module or in none at all. A filter built next to
+/// an index turns most of those lookups into a single cache line read.
+/// Names are hashed by their ConstString pointer, so a filter is only valid
+/// within the process that built it.
+///
+/// Each name sets a few bits in one 64 byte block, which gives less than a 1%
+/// false positive rate.
+//----------------------------------------------------------------------
+class BloomFilter {
+public:
+  /// Make an empty filter for up to \a num_names names. A filter made for no
+  /// names contains every name.
+  explicit BloomFilter(size_t num_names = 0) { Reset(num_names); }
+
+  void Reset(size_t num_names);
+
+  void Insert(ConstString name);
+
+  /// Return false if \a name was certainly not inserted.
+  bool MayContain(ConstString name) const;
+
+  /// Return true if the filter can rule names out.
+  bool IsValid() const { return !m_blocks.empty(); }
+
+  size_t GetMemoryUsage() const { return m_blocks.capacity() * sizeof(Block); }
+
+  /// Filter statistics, accumulated over all filters.
+  /// @{
+  /// The number of lookups a filter answered without the index.
+  static uint64_t GetLookupsAvoided() { return g_lookups_avoided; }
+  /// The number of lookups a filter let through that found nothing.
+  static uint64_t GetFalsePositives() { return g_false_positives; }
+  static void RecordLookupAvoided() {
+    g_lookups_avoided.fetch_add(1, std::memory_order_relaxed);
+  }
+  static void RecordFalsePositive() {
+    g_false_positives.fetch_add(1, std::memory_order_relaxed);
+  }
+  /// @}
+
+private:
+  struct Block {
+    uint64_t words[8];
+  };
+
+  size_t GetBlockIndex(uint64_t hash) const;
+
+  static std::atomic<uint64_t> g_lookups_avoided;
+  static std::atomic<uint64_t> g_false_positives;
+
+  std::vector<Block> m_blocks;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_BloomFilter_h_
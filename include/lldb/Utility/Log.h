@@ -25,6 +25,7 @@
 #include <cstdarg>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <type_traits>
 
@@ -43,6 +44,7 @@ class raw_ostream;
 #define LLDB_LOG_OPTION_BACKTRACE (1U << 7)
 #define LLDB_LOG_OPTION_APPEND (1U << 8)
 #define LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION (1U << 9)
+#define LLDB_LOG_OPTION_ASYNC (1U << 10)
 
 //----------------------------------------------------------------------
 // Logging Functions
@@ -118,10 +120,17 @@ public:
   static bool ListChannelCategories(llvm::StringRef channel,
                                     llvm::raw_ostream &stream);
 
+  static bool DumpLogChannel(llvm::StringRef channel,
+                             llvm::raw_ostream &error_stream);
+
   static void DisableAllLogChannels();
 
   static void ListAllLogChannels(llvm::raw_ostream &stream);
 
+  // Held while thread safe logs and the threads of asynchronous logs write to
+  // their streams. Several channels can share one stream.
+  static std::recursive_mutex &GetOutputMutex();
+
   //------------------------------------------------------------------
   // Member functions
   //
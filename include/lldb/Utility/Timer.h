@@ -10,10 +10,17 @@
 #define liblldb_Timer_h_
 
 #include "lldb/lldb-defines.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
+#include "llvm/Support/Error.h"
 #include <atomic>
+#include <string>
 #include <stdint.h>
 
+namespace llvm {
+class raw_ostream;
+}
+
 namespace lldb_private {
 class Stream;
 
@@ -58,6 +65,25 @@ public:
 
   static void ResetCategoryTimes();
 
+  //--------------------------------------------------------------
+  /// Record a begin/end event with the thread ID and the formatted message
+  /// for every timer that finishes while tracing is enabled, so concurrent
+  /// work on different threads can be inspected after the fact.
+  //--------------------------------------------------------------
+  static void SetTraceEnabled(bool enabled);
+
+  static bool GetTraceEnabled();
+
+  /// Discard all recorded trace events.
+  static void ResetTrace();
+
+  /// Write the recorded trace events in the Chrome trace event JSON format,
+  /// which chrome://tracing and Perfetto can display.
+  static void DumpTrace(llvm::raw_ostream &os);
+
+  /// Write the recorded trace events to the file at \a path.
+  static llvm::Error ExportTrace(llvm::StringRef path);
+
 protected:
   using TimePoint = std::chrono::steady_clock::time_point;
   void ChildDuration(TimePoint::duration dur) { m_child_duration += dur; }
@@ -65,9 +91,12 @@ protected:
   Category &m_category;
   TimePoint m_total_start;
   TimePoint::duration m_child_duration{0};
+  // Only formatted if tracing was enabled when the timer started.
+  std::string m_trace_message;
 
   static std::atomic<bool> g_quiet;
   static std::atomic<unsigned> g_display_depth;
+  static std::atomic<bool> g_trace;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Timer);
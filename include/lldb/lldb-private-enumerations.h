@@ -280,7 +280,9 @@ enum StatisticKind {
   ExpressionFailure = 1,
   FrameVarSuccess = 2,
   FrameVarFailure = 3,
-  StatisticMax = 4
+  ExpressionCacheHit = 4,
+  ExpressionCacheMiss = 5,
+  StatisticMax = 6
 };
 
 
@@ -294,6 +296,10 @@ inline std::string GetStatDescription(lldb_private::StatisticKind K) {
      return "Number of frame var successes";
    case StatisticKind::FrameVarFailure:
      return "Number of frame var failures";
+   case StatisticKind::ExpressionCacheHit:
+     return "Number of expr cache hits";
+   case StatisticKind::ExpressionCacheMiss:
+     return "Number of expr cache misses";
    case StatisticKind::StatisticMax:
      return "";
    }
@@ -0,0 +1,73 @@
+// Test that a name index generated for a module without one is used in
+// later sessions.
+
+// REQUIRES: lld
+
+// RUN: %clang %s -g -c -o %t.o --target=x86_64-pc-linux -mllvm -accel-tables=Disable
+// RUN: ld.lld %t.o -o %t --build-id
+// RUN: rm -rf %t.cache
+// RUN: lldb-test symbols --debug-names-cache=%t.cache %t | \
+// RUN:   FileCheck --check-prefix=MANUAL %s
+// RUN: lldb-test symbols --debug-names-cache=%t.cache --write-debug-names %t | \
+// RUN:   FileCheck --check-prefix=WRITE %s
+// RUN: lldb-test symbols --debug-names-cache=%t.cache %t | FileCheck %s
+// RUN: lldb-test symbols --debug-names-cache=%t.cache --name=foo \
+// RUN:   --find=function --function-flags=base %t | \
+// RUN:   FileCheck --check-prefix=BASE %s
+// RUN: lldb-test symbols --debug-names-cache=%t.cache --name=foo \
+// RUN:   --find=function --function-flags=method %t | \
+// RUN:   FileCheck --check-prefix=METHOD %s
+// RUN: lldb-test symbols --debug-names-cache=%t.cache --name=foo \
+// RUN:   --find=variable %t | FileCheck --check-prefix=VARIABLE %s
+// RUN: lldb-test symbols --debug-names-cache=%t.cache --name=sbar \
+// RUN:   --find=type %t | FileCheck --check-prefix=TYPE %s
+
+// Modules with a name index of their own are left alone.
+// RUN: %clang %s -g -c -o %t-dwarf.o --target=x86_64-pc-linux -mllvm -accel-tables=Dwarf
+// RUN: ld.lld %t-dwarf.o -o %t-dwarf --build-id
+// RUN: not lldb-test symbols --debug-names-cache=%t.cache --write-debug-names \
+// RUN:   %t-dwarf 2>&1 | FileCheck --check-prefix=HAS-INDEX %s
+
+// MANUAL: Manual DWARF index
+// MANUAL-NOT: Name Index
+
+// WRITE: Wrote name index.
+
+// CHECK: Name Index
+// CHECK: String: 0x{{.*}} "_start"
+// CHECK: Tag: DW_TAG_subprogram
+
+// BASE: Found 2 functions:
+// BASE-DAG: name = "foo()", mangled = "_Z3foov"
+// BASE-DAG: name = "bar::foo()", mangled = "_ZN3bar3fooEv"
+
+// METHOD: Found 1 functions:
+// METHOD-DAG: name = "sbar::foo()", mangled = "_ZN4sbar3fooEv"
+
+// VARIABLE: Found 1 variables:
+// VARIABLE-DAG: name = "foo", type = {{.*}} (int)
+
+// TYPE: Found 1 types:
+// TYPE-DAG: name = "sbar"
+
+// HAS-INDEX: Cannot write name index: the module already has a name index
+
+void foo() {}
+
+namespace bar {
+void foo() {}
+} // namespace bar
+
+namespace baz {
+int foo;
+} // namespace baz
+
+struct sbar {
+  void foo();
+};
+void sbar::foo() {}
+
+extern "C" void _start() {
+  sbar s;
+  s.foo();
+}
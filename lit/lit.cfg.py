@@ -52,6 +52,9 @@ toolchain.use_support_substitutions(config)
 if re.match(r'^arm(hf.*-linux)|(.*-linux-gnuabihf)', config.target_triple):
     config.available_features.add("armhf-linux")
 
+if config.have_zstd:
+    config.available_features.add("zstd")
+
 def calculate_arch_features(arch_string):
     # This will add a feature such as x86, arm, mips, etc for each built
     # target
@@ -24,6 +24,12 @@ class TestBenchmarkLibcxxMap(BenchBase):
         self.build()
         self.data_formatter_commands()
 
+    @benchmarks_test
+    def test_page_large_map(self):
+        """Benchmark paging through a large std::map (libc++)"""
+        self.build()
+        self.page_large_map()
+
     def setUp(self):
         # Call super's setUp().
         BenchBase.setUp(self)
@@ -65,3 +71,26 @@ class TestBenchmarkLibcxxMap(BenchBase):
         sw.stop()
 
         print("time to print: %s" % (sw))
+
+    def page_large_map(self):
+        """Benchmark random access into a large std::map (libc++)"""
+        target, process, thread, bkpt = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+
+        large_map = thread.GetSelectedFrame().FindVariable("large_map")
+        self.assertTrue(large_map.IsValid())
+        large_map.SetPreferSyntheticValue(True)
+        self.assertEqual(large_map.GetNumChildren(), 100000)
+
+        # Fetch windows of children the way an IDE variable view would,
+        # jumping around instead of expanding the map front to back.
+        sw = Stopwatch()
+        sw.start()
+        for start in [50000, 99900, 0, 75000, 50100]:
+            for idx in range(start, start + 100):
+                child = large_map.GetChildAtIndex(idx)
+                self.assertEqual(child.GetChildAtIndex(0).GetValueAsUnsigned(),
+                                 idx)
+        sw.stop()
+
+        print("time to page: %s" % (sw))
@@ -7,5 +7,10 @@ int main()
     i < 1500;
     i++)
         map[i] = i;
-    return map.size(); // break here
+    std::map<int, int> large_map;
+    for (int i = 0;
+    i < 100000;
+    i++)
+        large_map[i] = i;
+    return map.size() + large_map.size(); // break here
 }
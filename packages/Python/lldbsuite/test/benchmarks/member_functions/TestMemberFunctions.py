@@ -0,0 +1,68 @@
+"""Time printing a member of a class with 10000 member functions, with and
+without lazy member function parsing."""
+
+from __future__ import print_function
+
+
+import resource
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class MemberFunctionsBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.count = 5
+
+    def print_member(self, lazy):
+        self.runCmd("settings set symbols.lazy-member-function-parsing "
+                    + ("true" if lazy else "false"))
+        self.stopwatch.reset()
+        max_rss = 0
+        for i in range(self.count):
+            target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+            self.assertTrue(target, VALID_TARGET)
+            lldbutil.run_break_set_by_source_regexp(self, "Set breakpoint here")
+            process = target.LaunchSimple(
+                None, None, self.get_process_working_directory())
+            self.assertTrue(process, PROCESS_IS_VALID)
+            frame = process.GetSelectedThread().GetSelectedFrame()
+
+            rss_before = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+            # Like "frame variable big.value"; an expression would import
+            # the whole class.
+            with self.stopwatch:
+                value = frame.GetValueForVariablePath("big.value")
+                self.assertEqual(value.GetValueAsSigned(), 1)
+            max_rss = max(max_rss,
+                          resource.getrusage(resource.RUSAGE_SELF).ru_maxrss -
+                          rss_before)
+
+            process.Kill()
+            self.dbg.DeleteTarget(target)
+            # Drop the module so that the next iteration parses the class
+            # again.
+            lldb.SBDebugger.MemoryPressureDetected()
+        return max_rss
+
+    @benchmarks_test
+    def test_member_functions(self):
+        """Time printing one member of a class with 10000 member functions."""
+        self.build()
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear symbols.lazy-member-function-parsing"))
+        print()
+        # Lazy first: the peak resident size only ever grows.
+        rss = self.print_member(lazy=True)
+        print("lazy member functions:", self.stopwatch,
+              "peak RSS growth:", rss)
+        rss = self.print_member(lazy=False)
+        print("eager member functions:", self.stopwatch,
+              "peak RSS growth:", rss)
@@ -0,0 +1,34 @@
+// A class with 10000 member functions and a handful of fields.
+#define METHOD(n) int method##n(int x) const { return x + value; }
+#define METHODS10(n)                                                           \
+  METHOD(n##0) METHOD(n##1) METHOD(n##2) METHOD(n##3) METHOD(n##4)             \
+  METHOD(n##5) METHOD(n##6) METHOD(n##7) METHOD(n##8) METHOD(n##9)
+#define METHODS100(n)                                                          \
+  METHODS10(n##0) METHODS10(n##1) METHODS10(n##2) METHODS10(n##3)              \
+  METHODS10(n##4) METHODS10(n##5) METHODS10(n##6) METHODS10(n##7)              \
+  METHODS10(n##8) METHODS10(n##9)
+#define METHODS1000(n)                                                         \
+  METHODS100(n##0) METHODS100(n##1) METHODS100(n##2) METHODS100(n##3)          \
+  METHODS100(n##4) METHODS100(n##5) METHODS100(n##6) METHODS100(n##7)          \
+  METHODS100(n##8) METHODS100(n##9)
+
+struct Big {
+  METHODS1000(_0)
+  METHODS1000(_1)
+  METHODS1000(_2)
+  METHODS1000(_3)
+  METHODS1000(_4)
+  METHODS1000(_5)
+  METHODS1000(_6)
+  METHODS1000(_7)
+  METHODS1000(_8)
+  METHODS1000(_9)
+
+  int value = 1;
+  long other = 2;
+};
+
+int main() {
+  Big big;
+  return big.method_0000(0) + big.method_9999(1); // Set breakpoint here
+}
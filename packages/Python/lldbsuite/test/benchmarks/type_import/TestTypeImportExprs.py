@@ -0,0 +1,62 @@
+"""Time a suite of expressions over STL-heavy types with eager and lazy
+type import."""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TypeImportExprsBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    exprs = [
+        "scene.selected->id",
+        "scene.selected->points.size()",
+        "scene.shapes.size()",
+        "(app::Point *)nullptr",
+        "sizeof(app::Shape)",
+        "scene.names.size()",
+    ]
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.count = 10
+
+    def run_exprs(self, lazy):
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        self.runCmd("settings set target.experimental.lazy-clang-type-import "
+                    + ("true" if lazy else "false"))
+        lldbutil.run_break_set_by_source_regexp(self, "Set breakpoint here")
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        frame = process.GetSelectedThread().GetSelectedFrame()
+
+        self.stopwatch.reset()
+        for i in range(self.count):
+            for expr in self.exprs:
+                with self.stopwatch:
+                    value = frame.EvaluateExpression(expr)
+                self.assertTrue(value.GetError().Success(), expr)
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+
+    @benchmarks_test
+    def test_type_import(self):
+        """Time expressions over STL-heavy types with and without lazy
+        type import."""
+        self.build()
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.lazy-clang-type-import"))
+        print()
+        self.run_exprs(lazy=False)
+        print("eager type import:", self.stopwatch)
+        self.run_exprs(lazy=True)
+        print("lazy type import:", self.stopwatch)
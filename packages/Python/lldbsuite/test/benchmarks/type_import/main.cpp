@@ -0,0 +1,37 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace app {
+struct Point {
+  double x, y, z;
+};
+
+struct Shape {
+  std::string name;
+  std::vector<Point> points;
+  std::map<std::string, std::shared_ptr<Shape>> children;
+  int id;
+};
+
+struct Scene {
+  std::vector<std::unique_ptr<Shape>> shapes;
+  std::map<int, std::string> names;
+  Shape *selected = nullptr;
+};
+} // namespace app
+
+int main() {
+  app::Scene scene;
+  for (int i = 0; i < 16; ++i) {
+    auto shape = std::unique_ptr<app::Shape>(new app::Shape());
+    shape->name = "shape" + std::to_string(i);
+    shape->points.push_back({1.0 * i, 2.0 * i, 3.0 * i});
+    shape->id = i;
+    scene.names[i] = shape->name;
+    scene.shapes.push_back(std::move(shape));
+  }
+  scene.selected = scene.shapes[3].get();
+  return scene.selected->id; // Set breakpoint here.
+}
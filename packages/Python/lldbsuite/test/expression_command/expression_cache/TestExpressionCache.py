@@ -0,0 +1,60 @@
+"""
+Test that compiled expressions are reused when target.expression-cache-size
+is set.
+"""
+
+from __future__ import print_function
+
+import json
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ExpressionCacheTestCase(TestBase):
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def get_stats(self, target):
+        stream = lldb.SBStream()
+        target.GetStatistics().GetAsJSON(stream)
+        return json.loads(stream.GetData())
+
+    def test_expression_cache(self):
+        """Test that evaluating an expression again in the same block reuses
+           the compiled expression."""
+        self.build()
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.c"))
+
+        self.runCmd("settings set target.expression-cache-size 16")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.expression-cache-size"))
+        target.SetCollectingStats(True)
+
+        # A JITed expression with a side effect, so we can tell it really ran
+        # every time.
+        expr = "increment(10) + i"
+        for expected in [10, 20]:
+            value = thread.frames[0].EvaluateExpression(expr)
+            self.assertTrue(value.GetError().Success(), "expression failed")
+            self.assertEqual(value.GetValueAsSigned(), expected)
+
+        # Continue to the next iteration; we are still in the same block.
+        process.Continue()
+        value = thread.frames[0].EvaluateExpression(expr)
+        self.assertTrue(value.GetError().Success(), "expression failed")
+        self.assertEqual(value.GetValueAsSigned(), 31)
+
+        stats = self.get_stats(target)
+        self.assertEqual(stats["Number of expr cache misses"], 1)
+        self.assertEqual(stats["Number of expr cache hits"], 2)
+
+        # Expressions using persistent variables are never cached.
+        thread.frames[0].EvaluateExpression("int $v = i")
+        thread.frames[0].EvaluateExpression("int $w = i")
+        stats = self.get_stats(target)
+        self.assertEqual(stats["Number of expr cache misses"], 1)
+        self.assertEqual(stats["Number of expr cache hits"], 2)
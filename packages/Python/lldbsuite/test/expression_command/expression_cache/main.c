@@ -0,0 +1,17 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+int counter = 0;
+
+int increment(int by) { return counter += by; }
+
+int main(int argc, char const *argv[]) {
+  for (int i = 0; i < 3; i++)
+    increment(i); // break here
+  return 0;
+}
@@ -87,6 +87,85 @@ class IRInterpreterTestCase(TestBase):
                 "While evaluating " +
                 expression)
 
+    @add_test_categories(['pyapi'])
+    # getpid() is POSIX, among other problems, see bug
+    @expectedFailureAll(
+        oslist=['windows'],
+        bugnumber="http://llvm.org/pr21765")
+    def test_ir_interpreter_floating_point(self):
+        """Test that the interpreter agrees with the JIT on floating point,
+           select and switch."""
+        self.build_and_run()
+
+        options = lldb.SBExpressionOptions()
+        options.SetLanguage(lldb.eLanguageTypeC_plus_plus)
+
+        set_up_expressions = ["double $d = 2.5", "double $e = -0.75",
+                              "float $f = 1.5f", "int $n = 7",
+                              "unsigned $u = 3000000000u"]
+
+        expressions = ["$d + $e",
+                       "$d - $e",
+                       "$d * 1.5",
+                       "$d / $e",
+                       "__builtin_fmod($d, 0.75)",
+                       "$d * 1.5 > $n",
+                       "$e <= $d",
+                       "$d == 2.5",
+                       "$d != $d",
+                       "__builtin_nan(\"\") == __builtin_nan(\"\")",
+                       "$f * $d",
+                       "(float)$d",
+                       "(double)$f",
+                       "(double)$n",
+                       "(double)$u",
+                       "(int)($d * $e)",
+                       "(unsigned)($d * 4)",
+                       "$n > 5 ? $d : $e",
+                       "int r = 0; switch ($n) { case 1: r = 10; break; "
+                       "case 7: r = 70; break; default: r = -1; } r",
+                       "char a[4] = { 1, 2, 3, 4 }; char b[4]; "
+                       "__builtin_memcpy(b, a, 4); b[3]",
+                       "char c[8]; __builtin_memset(c, 9, 8); c[5]"]
+
+        for expression in set_up_expressions:
+            self.frame().EvaluateExpression(expression, options)
+
+        for expression in expressions:
+            interp_expression = expression
+            jit_expression = "(int)getpid(); " + expression
+
+            interp_result = self.frame().EvaluateExpression(
+                interp_expression, options)
+            jit_result = self.frame().EvaluateExpression(
+                jit_expression, options)
+
+            self.assertTrue(interp_result.GetError().Success(),
+                            "While interpreting " + expression)
+            self.assertTrue(jit_result.GetError().Success(),
+                            "While JITing " + expression)
+            self.assertEqual(
+                interp_result.GetValue(),
+                jit_result.GetValue(),
+                "While evaluating " +
+                expression)
+
+    def test_floating_point_without_process(self):
+        """Floating point expressions don't need a process to run in."""
+        target = self.dbg.GetDummyTarget()
+        # Go through a persistent variable so clang can't fold the constants.
+        double_val = target.EvaluateExpression("(double)2.5")
+        value = target.EvaluateExpression(
+            double_val.GetName() + " * 1.5 > 3.5 ? 1.25 : -1.0")
+        self.assertTrue(value.GetError().Success(),
+                        value.GetError().GetCString())
+        self.assertEqual(value.GetValue(), "1.25")
+        value = target.EvaluateExpression(
+            "(int)(" + double_val.GetName() + " * 3.1)")
+        self.assertTrue(value.GetError().Success(),
+                        value.GetError().GetCString())
+        self.assertEqual(value.GetValueAsSigned(), 7)
+
     def test_type_conversions(self):
         target = self.dbg.GetDummyTarget()
         short_val = target.EvaluateExpression("(short)-1")
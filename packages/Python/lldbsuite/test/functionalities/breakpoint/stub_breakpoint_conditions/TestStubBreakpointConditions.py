@@ -0,0 +1,74 @@
+"""
+Test that breakpoint conditions the remote stub evaluates stop at the same
+place, and leave the same hit counts, as conditions lldb evaluates itself.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StubBreakpointConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    @skipUnlessPlatform(oslist=['linux'])
+    def test_stub_conditions(self):
+        """Conditions evaluated by lldb-server stop on the right iteration."""
+        self.build()
+        self.do_conditional_breakpoint(True)
+
+    @skipUnlessPlatform(oslist=['linux'])
+    def test_client_conditions(self):
+        """The same conditions evaluated by lldb itself."""
+        self.build()
+        self.do_conditional_breakpoint(False)
+
+    def do_conditional_breakpoint(self, use_stub):
+        self.runCmd(
+            "settings set plugin.process.gdb-remote.use-stub-breakpoint-conditions %s" %
+            ("true" if use_stub else "false"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear plugin.process.gdb-remote.use-stub-breakpoint-conditions",
+            check=False))
+
+        exe = self.getBuildArtifact("a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateBySourceRegex(
+            "Set break point at this line.", lldb.SBFileSpec("main.c"))
+        self.assertTrue(breakpoint.GetNumLocations() == 1, VALID_BREAKPOINT)
+        breakpoint.SetCondition("value == 700 && g_total > 1000")
+
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        threads = lldbutil.get_threads_stopped_at_breakpoint(
+            process, breakpoint)
+        self.assertEqual(len(threads), 1)
+        frame = threads[0].GetFrameAtIndex(0)
+        self.assertEqual(frame.FindVariable("value").GetValueAsSigned(), 700)
+        self.assertEqual(breakpoint.GetHitCount(), 1)
+
+        # A condition the stub can't evaluate falls back to lldb.
+        breakpoint.SetCondition("accumulate(0) == 700 * 701 / 2")
+        process.Continue()
+        threads = lldbutil.get_threads_stopped_at_breakpoint(
+            process, breakpoint)
+        self.assertEqual(len(threads), 1)
+        frame = threads[0].GetFrameAtIndex(0)
+        self.assertEqual(frame.FindVariable("value").GetValueAsSigned(), 701)
+        self.assertEqual(breakpoint.GetHitCount(), 2)
+
+        breakpoint.SetCondition("value == 1001")
+        process.Continue()
+        self.assertEqual(process.GetState(), lldb.eStateExited)
+        self.assertEqual(breakpoint.GetHitCount(), 2)
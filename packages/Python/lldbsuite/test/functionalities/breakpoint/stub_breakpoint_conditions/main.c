@@ -0,0 +1,21 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+int g_total = 0;
+
+static int accumulate(int value) {
+  g_total += value; // Set break point at this line.
+  return g_total;
+}
+
+int main(int argc, char const *argv[]) {
+  int result = 0;
+  for (int i = 0; i < 1000; ++i)
+    result = accumulate(i);
+  return result == 0;
+}
@@ -0,0 +1,71 @@
+"""
+Test that a thread stepping over a breakpoint whose condition the remote
+stub evaluated doesn't report a stop of its own when another thread stops
+at a breakpoint in the meantime.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StubBreakpointConditionsThreadsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    @skipUnlessPlatform(oslist=['linux'])
+    def test_two_breakpoints(self):
+        """Only the unconditional breakpoint stops while others are stepped over."""
+        self.build()
+        self.runCmd(
+            "settings set plugin.process.gdb-remote.use-stub-breakpoint-conditions true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear plugin.process.gdb-remote.use-stub-breakpoint-conditions",
+            check=False))
+
+        exe = self.getBuildArtifact("a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        main_spec = lldb.SBFileSpec("main.cpp")
+        conditional = target.BreakpointCreateBySourceRegex(
+            "Set conditional break point here.", main_spec)
+        self.assertTrue(conditional.GetNumLocations() == 1, VALID_BREAKPOINT)
+        # Never true, so the stub steps the spinning threads over it all the
+        # time.
+        conditional.SetCondition("value == 2")
+        unconditional = target.BreakpointCreateBySourceRegex(
+            "Set unconditional break point here.", main_spec)
+        self.assertTrue(unconditional.GetNumLocations() == 1, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        for round in range(10):
+            self.assertEqual(process.GetState(), lldb.eStateStopped)
+            threads = lldbutil.get_threads_stopped_at_breakpoint(
+                process, unconditional)
+            self.assertEqual(len(threads), 1)
+            frame = threads[0].GetFrameAtIndex(0)
+            self.assertEqual(
+                frame.FindVariable("round").GetValueAsSigned(), round)
+            # A step over that was cut short must not show up as a stop.
+            for thread in process:
+                if thread.GetThreadID() == threads[0].GetThreadID():
+                    continue
+                self.assertNotEqual(
+                    thread.GetStopReason(), lldb.eStopReasonTrace)
+                self.assertNotEqual(
+                    thread.GetStopReason(), lldb.eStopReasonBreakpoint)
+            process.Continue()
+
+        self.assertEqual(process.GetState(), lldb.eStateExited)
+        self.assertEqual(conditional.GetHitCount(), 0)
+        self.assertEqual(unconditional.GetHitCount(), 10)
@@ -0,0 +1,31 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+std::atomic<bool> g_done(false);
+std::atomic<int> g_spins(0);
+
+static void spin(int value) {
+  g_spins += value; // Set conditional break point here.
+}
+
+static void spinner() {
+  for (int i = 0; !g_done; ++i)
+    spin(i & 1);
+}
+
+static void stop_here(int round) {
+  g_spins += round; // Set unconditional break point here.
+}
+
+int main() {
+  std::thread first(spinner), second(spinner);
+  for (int round = 0; round < 10; ++round) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop_here(round);
+  }
+  g_done = true;
+  first.join();
+  second.join();
+  return 0;
+}
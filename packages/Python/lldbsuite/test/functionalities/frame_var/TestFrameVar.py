@@ -97,3 +97,17 @@ class TestFrameVar(TestBase):
 
 
 
+
+        # Prefetching the memory the variables point to must not change what
+        # is printed, nor the order it is printed in:
+        self.runCmd(
+            "settings set target.experimental.prefetch-variable-memory true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.prefetch-variable-memory"))
+        result = interp.HandleCommand("frame var", command_result)
+        self.assertEqual(result, lldb.eReturnStatusSuccessFinishResult, "frame var didn't succeed")
+        output = command_result.GetOutput()
+        self.assertTrue("(int) test_var = 10" in output, "Didn't find test_var")
+        self.assertTrue(output.index("argc") < output.index("argv") <
+                        output.index("test_var"),
+                        "Variables printed out of declaration order")
@@ -0,0 +1,53 @@
+"""
+Test the memory usage reported for modules, and that modules no target uses
+keep working after their parsed information is released.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestModuleMemoryUsage(TestBase):
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def test_memory_usage(self):
+        """Test that parsing symbols and types shows up in the memory usage."""
+        self.build()
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        module = target.GetModuleAtIndex(0)
+        self.assertTrue(module.IsValid())
+
+        before = module.GetMemoryUsage()
+        self.assertTrue(module.FindFunctions("helper").GetSize() > 0)
+        self.assertTrue(module.FindFirstType("Point").IsValid())
+        self.assertTrue(module.GetMemoryUsage() > before)
+
+        self.expect("image list -M a.out", substrs=["bytes: symtab"])
+
+    def test_release_unused_modules(self):
+        """Cycle many targets through the same files with a tiny budget for
+        unused modules, and check the modules are released and still work."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        log = self.getBuildArtifact("modules.log")
+
+        self.runCmd("settings set symbols.unused-module-memory-budget 1")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear symbols.unused-module-memory-budget"))
+        self.runCmd("log enable -f %s lldb module" % log)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb module"))
+
+        for i in range(20):
+            self.runCmd("target create %s" % exe)
+            self.expect("image lookup -n helper", substrs=["helper"])
+            self.expect("image lookup -t Point", substrs=["Point"])
+            self.runCmd("target delete")
+
+        self.runCmd("log disable lldb module")
+        with open(log) as f:
+            self.assertTrue("ReleaseParsedInfo" in f.read())
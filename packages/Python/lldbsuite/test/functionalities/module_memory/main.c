@@ -0,0 +1,11 @@
+struct Point {
+  int x;
+  int y;
+};
+
+int helper(struct Point *point) { return point->x + point->y; }
+
+int main(void) {
+  struct Point point = {1, 2};
+  return helper(&point);
+}
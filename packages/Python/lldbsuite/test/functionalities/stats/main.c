@@ -13,6 +13,7 @@ int main(void) {
   //%self.expect("frame var", substrs=['27'])
   //%self.expect("statistics disable")
   //%self.expect("statistics dump", substrs=['frame var successes : 1', 'frame var failures : 0'])
+  //%self.expect("statistics dump", substrs=['formatter cache hits : ', 'formatter cache misses : ', 'swift type cache hits : ', 'swift type cache misses : '])
 
   return 0;
 }
@@ -30,7 +30,9 @@ class TestStatsAPI(TestBase):
         stream = lldb.SBStream()
         res = stats.GetAsJSON(stream)
         stats_json = sorted(json.loads(stream.GetData()))
-        self.assertEqual(len(stats_json), 4)
+        self.assertEqual(len(stats_json), 6)
+        self.assertTrue("Number of expr cache hits" in stats_json)
+        self.assertTrue("Number of expr cache misses" in stats_json)
         self.assertTrue("Number of expr evaluation failures" in stats_json)
         self.assertTrue("Number of expr evaluation successes" in stats_json)
         self.assertTrue("Number of frame var failures" in stats_json)
@@ -0,0 +1,70 @@
+"""
+Test that C++ classes whose member functions are parsed lazily from DWARF
+are laid out correctly, and that the member functions that were left out
+are added when they are looked up by name, when the members of the class
+are enumerated, and when one of them is stopped in.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+import lldbsuite.test.lldbutil as lldbutil
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+
+
+class TestCppLazyMemberFunctions(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def set_setting(self, name, value):
+        self.runCmd("settings set %s %s" % (name, value))
+        self.addTearDownHook(lambda: self.runCmd("settings clear " + name))
+
+    def run_to(self, pattern):
+        self.build()
+        self.set_setting("symbols.lazy-member-function-parsing", "true")
+        lldbutil.run_to_source_breakpoint(self, pattern,
+                                          lldb.SBFileSpec("main.cpp"))
+
+    def test_layout(self):
+        """Printing an object only needs its fields and bases."""
+        self.run_to("Set a breakpoint here")
+        self.expect("frame variable widget",
+                    substrs=["base_value = 5", "value = 10", "small = 3"])
+        self.expect("expr sizeof(Widget)", substrs=[
+            str(self.frame().FindVariable("widget").GetByteSize())])
+        # Virtual member functions are always parsed with the class.
+        self.expect("expr ((Base &)widget).id()", substrs=["2"])
+
+    def test_lookup_by_name(self):
+        """A member function that wasn't parsed yet is found by name."""
+        self.run_to("Set a breakpoint here")
+        # Modern type lookup looks names in a class up in the module's copy
+        # of the class, instead of copying all of its members first.
+        self.set_setting("target.experimental.use-modern-type-lookup", "true")
+        self.expect("expr Widget::answer()", substrs=["42"])
+
+    def test_enumerate(self):
+        """Enumerating the members of a class adds all of them."""
+        self.run_to("Set a breakpoint here")
+        widget_type = self.frame().FindVariable("widget").GetType()
+        names = [widget_type.GetMemberFunctionAtIndex(i).GetName()
+                 for i in range(widget_type.GetNumberOfMemberFunctions())]
+        for name in ["get", "twice", "answer", "id", "triple"]:
+            self.assertIn(name, names)
+
+        # Expressions import the whole class, overloads included.
+        self.expect("expr widget.get()", substrs=["10"])
+        self.expect("expr widget.get(5)", substrs=["15"])
+        self.expect("expr widget.twice()", substrs=["20"])
+
+    def test_out_of_line_definition(self):
+        """Stopping in a member function that is defined outside of its class
+        adds it to the class."""
+        self.run_to("Set a breakpoint in a method here")
+        self.assertEqual("Widget::triple() const",
+                         self.frame().GetFunctionName())
+        self.expect("frame variable *this", substrs=["value = 10"])
+        self.expect("expr twice() + triple()", substrs=["50"])
@@ -0,0 +1,30 @@
+struct Base {
+  virtual ~Base() {}
+  virtual int id() const { return 1; }
+  int base_value = 5;
+};
+
+struct Widget : public Base {
+  Widget(int v) : value(v) {}
+  int id() const override { return 2; }
+
+  int get() const { return value; }
+  int get(int offset) const { return value + offset; }
+  int twice() const { return 2 * value; }
+  static int answer() { return 42; }
+  int triple() const;
+
+  int value;
+  short small = 3;
+};
+
+int Widget::triple() const {
+  return 3 * value; // Set a breakpoint in a method here
+}
+
+int main() {
+  Widget widget(10);
+  int result = widget.get() + widget.get(1) + widget.twice() +
+               Widget::answer() + widget.id() + widget.triple();
+  return result; // Set a breakpoint here
+}
@@ -0,0 +1,71 @@
+"""
+Test that repeated expression name lookups are answered from the target's
+lookup cache, and that lazily imported C++ types are only completed when an
+expression needs them.
+"""
+
+from __future__ import print_function
+
+
+import re
+import lldb
+import lldbsuite.test.lldbutil as lldbutil
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+
+
+class TestCppLazyTypeImport(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def get_stat(self, name):
+        result = lldb.SBCommandReturnObject()
+        self.dbg.GetCommandInterpreter().HandleCommand("statistics dump",
+                                                       result)
+        self.assertTrue(result.Succeeded())
+        match = re.search(name + r" : (\d+)", result.GetOutput())
+        self.assertTrue(match, "no '%s' in statistics" % name)
+        return int(match.group(1))
+
+    def test_lookup_cache(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "Set a breakpoint here",
+                                          lldb.SBFileSpec("main.cpp"))
+
+        self.expect("expr g_outer.inner.a", substrs=["10"])
+
+        # The same names again: the types were found in the images before.
+        hits = self.get_stat("clang name lookup cache hits")
+        self.expect("expr ((ns::Outer *)&g_outer)->inner.b", substrs=["2"])
+        self.assertGreater(self.get_stat("clang name lookup cache hits"), hits)
+
+        # Names that weren't found are cached too.
+        self.expect("expr (NoSuchType *)0", error=True)
+        hits = self.get_stat("clang name lookup cache hits")
+        misses = self.get_stat("clang name lookup cache misses")
+        self.expect("expr (NoSuchType *)0", error=True)
+        self.assertGreater(self.get_stat("clang name lookup cache hits"), hits)
+        self.assertEqual(self.get_stat("clang name lookup cache misses"),
+                         misses)
+
+    def test_lazy_import(self):
+        self.build()
+        self.runCmd(
+            "settings set target.experimental.lazy-clang-type-import true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.lazy-clang-type-import"))
+        (_, _, thread, _) = lldbutil.run_to_source_breakpoint(
+            self, "Set a breakpoint here", lldb.SBFileSpec("main.cpp"))
+        frame = thread.GetFrameAtIndex(0)
+
+        # Only naming a type doesn't need its definition.
+        value = frame.EvaluateExpression("(Unused *)nullptr")
+        self.assertTrue(value.GetError().Success())
+        self.assertFalse(value.GetType().GetPointeeType().IsTypeComplete())
+
+        # Types are completed when the expression does need them.
+        self.expect("expr sizeof(Unused) == 4 * sizeof(ns::Outer)",
+                    substrs=["true"])
+        self.expect("expr g_outer.ptr->b", substrs=["2"])
+        self.expect("expr ((ns::Outer *)&g_outer)->sum()", substrs=["12"])
+        self.expect("expr g_unused", substrs=["Unused *", "nullptr"])
@@ -0,0 +1,25 @@
+namespace ns {
+struct Inner {
+  int a = 1;
+  int b = 2;
+};
+
+struct Outer {
+  Inner inner;
+  Inner *ptr = nullptr;
+  int sum() const { return inner.a + inner.b; }
+};
+} // namespace ns
+
+struct Unused {
+  ns::Outer outer[4];
+};
+
+ns::Outer g_outer;
+Unused *g_unused = nullptr;
+
+int main() {
+  g_outer.inner.a = 10;
+  g_outer.ptr = &g_outer.inner;
+  return g_outer.sum(); // Set a breakpoint here
+}
@@ -32,6 +32,22 @@ class TestSwiftCrossModuleExtension(TestBase):
     def test_cross_module_extension(self):
         """Test that we correctly find private extension decls across modules"""
         self.build()
+        self.do_test()
+
+    @skipUnlessDarwin
+    @swiftTest
+    def test_cross_module_extension_background_contexts(self):
+        """Same as above, with the module contexts built in the background"""
+        self.build()
+        self.runCmd("settings set "
+                    "target.experimental.swift-create-module-contexts-in-background true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear "
+            "target.experimental.swift-create-module-contexts-in-background",
+            check=False))
+        self.do_test()
+
+    def do_test(self):
         target, process, thread, a_breakpoint = \
             lldbutil.run_to_source_breakpoint(
                 self, 'break here', lldb.SBFileSpec('moda.swift'),
@@ -13,6 +13,7 @@
 Tests that dynamic values work correctly for Swift
 """
 import lldb
+import re
 from lldbsuite.test.lldbtest import *
 from lldbsuite.test.decorators import *
 import lldbsuite.test.lldbutil as lldbutil
@@ -80,6 +81,17 @@ class SwiftDynamicValueTest(TestBase):
                 "v = 449493530",
                 "q = 3735928559"])
 
+        # The classes were resolved on the first stop; the second stop
+        # should have found them in the metadata cache.
+        result = lldb.SBCommandReturnObject()
+        self.dbg.GetCommandInterpreter().HandleCommand("statistics dump",
+                                                       result)
+        self.assertTrue(result.Succeeded())
+        match = re.search(r"swift class metadata cache hits : (\d+)",
+                          result.GetOutput())
+        self.assertTrue(match)
+        self.assertGreater(int(match.group(1)), 0)
+
 if __name__ == '__main__':
     import atexit
     lldb.SBDebugger.Initialize()
@@ -93,3 +93,56 @@ class LogTestCase(TestBase):
 
         # check that it is still there
         self.assertEquals(contents.find("bacon"), 0)
+
+    # Check that a buffered log is only written out when dumped
+    def test_log_buffer(self):
+        self.runCmd("log enable -b 1 -f '%s' lldb commands" % self.log_file)
+        self.runCmd("help log")
+
+        self.assertTrue(os.path.isfile(self.log_file))
+        with open(self.log_file, "r") as f:
+            self.assertEquals(f.read(), "")
+
+        self.runCmd("log dump lldb")
+        self.runCmd("log disable lldb")
+
+        with open(self.log_file, "r") as f:
+            contents = f.read()
+        self.assertNotEqual(contents.find("help log"), -1)
+
+    # Check that an async log ends up with everything once disabled
+    def test_log_async(self):
+        self.runCmd("log enable -A -f '%s' lldb commands" % self.log_file)
+        self.runCmd("help log")
+        self.runCmd("log disable lldb")
+
+        with open(self.log_file, "r") as f:
+            contents = f.read()
+        self.assertNotEqual(contents.find("help log"), -1)
+
+    # Check that timer trace events can be exported as Chrome trace JSON
+    def test_timer_trace_export(self):
+        import json
+        trace_file = self.getBuildArtifact("trace.json")
+
+        self.runCmd("log timers reset")
+        self.runCmd("log timers trace true")
+        self.runCmd("help log")
+        self.runCmd("log timers trace false")
+        self.runCmd("log timers export '%s'" % trace_file)
+        with open(trace_file, "r") as f:
+            trace = json.load(f)
+        events = trace["traceEvents"]
+        self.assertGreater(len(events), 0)
+        for event in events:
+            self.assertEquals(event["ph"], "X")
+            self.assertIn("tid", event)
+
+        lldb.SBDebugger.SetTimerTraceEnabled(True)
+        self.runCmd("help log")
+        lldb.SBDebugger.SetTimerTraceEnabled(False)
+        error = lldb.SBDebugger.ExportTimerTrace(trace_file)
+        self.assertTrue(error.Success(), error.GetCString())
+        with open(trace_file, "r") as f:
+            self.assertGreater(len(json.load(f)["traceEvents"]), len(events))
+        self.runCmd("log timers reset")
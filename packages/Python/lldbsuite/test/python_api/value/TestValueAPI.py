@@ -64,6 +64,10 @@ class ValueAPITestCase(TestBase):
         self.assertEqual(days_of_week.GetNumChildren(), 7, VALID_VARIABLE)
         self.DebugSBValue(days_of_week)
 
+        # Prefetching a window of children is clamped to the array bounds.
+        self.assertEqual(days_of_week.PrefetchChildren(2, 100), 5)
+        self.assertEqual(days_of_week.PrefetchChildren(7, 1), 0)
+
         # Use this to test the "child" and "children" accessors:
         children = days_of_week.children
         self.assertEqual(len(children), 7, VALID_VARIABLE)
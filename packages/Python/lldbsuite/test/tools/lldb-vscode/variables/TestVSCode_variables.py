@@ -110,7 +110,10 @@ class TestVSCode_variables(lldbvscode_testcase.VSCodeTestCaseBase):
                 'children': {
                     'x': {'equals': {'type': 'int', 'value': '11'}},
                     'y': {'equals': {'type': 'int', 'value': '22'}},
-                    'buffer': {'children': buffer_children}
+                    'buffer': {
+                        'equals': {'indexedVariables': 32},
+                        'children': buffer_children
+                    }
                 }
             }
         }
@@ -143,6 +143,18 @@ public:
     static void
     MemoryPressureDetected();
 
+    %feature("docstring",
+    "Record a trace event for every internal timer that completes while
+    enabled, for export with ExportTimerTrace().") SetTimerTraceEnabled;
+    static void
+    SetTimerTraceEnabled(bool enabled);
+
+    %feature("docstring",
+    "Write the recorded timer trace events to a file in the Chrome trace
+    event JSON format, viewable in chrome://tracing or Perfetto.") ExportTimerTrace;
+    static lldb::SBError
+    ExportTimerTrace(const char *path);
+
     SBDebugger();
 
     SBDebugger(const lldb::SBDebugger &rhs);
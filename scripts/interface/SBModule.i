@@ -339,6 +339,18 @@ public:
     lldb::SBAddress
     GetObjectFileEntryPointAddress() const;
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Get an estimate of the memory used by this module.
+    ///
+    /// @return
+    ///     The number of bytes used by the symbols, debug information,
+    ///     line tables and types parsed for this module so far.
+    //------------------------------------------------------------------
+    ") GetMemoryUsage;
+    uint64_t
+    GetMemoryUsage();
+
     bool
     operator == (const lldb::SBModule &rhs) const;
              
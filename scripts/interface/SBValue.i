@@ -348,6 +348,19 @@ public:
     uint32_t
     GetNumChildren (uint32_t max);
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Read the memory backing children [start_idx, start_idx + count)
+    /// of an array with a single read so that fetching them one by one
+    /// afterwards does not cost a memory read per child.
+    ///
+    /// @return
+    ///     The number of children whose memory was prefetched.
+    //------------------------------------------------------------------
+    ") PrefetchChildren;
+    uint32_t
+    PrefetchChildren (uint32_t start_idx, uint32_t count);
+
     void *
     GetOpaqueType();
 
@@ -48,6 +48,7 @@
 #include "lldb/Target/TargetList.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/State.h"
+#include "lldb/Utility/Timer.h"
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
@@ -298,6 +299,25 @@ void SBDebugger::MemoryPressureDetected() {
   ModuleList::RemoveOrphanSharedModules(mandatory);
 }
 
+void SBDebugger::SetTimerTraceEnabled(bool enabled) {
+  LLDB_RECORD_STATIC_METHOD(void, SBDebugger, SetTimerTraceEnabled, (bool),
+                            enabled);
+
+  Timer::SetTraceEnabled(enabled);
+}
+
+SBError SBDebugger::ExportTimerTrace(const char *path) {
+  LLDB_RECORD_STATIC_METHOD(lldb::SBError, SBDebugger, ExportTimerTrace,
+                            (const char *), path);
+
+  SBError sb_error;
+  if (!path || !path[0])
+    sb_error.SetErrorString("invalid path");
+  else if (llvm::Error error = Timer::ExportTrace(path))
+    sb_error.SetError(Status(std::move(error)));
+  return LLDB_RECORD_RESULT(sb_error);
+}
+
 bool SBDebugger::IsValid() const {
   LLDB_RECORD_METHOD_CONST_NO_ARGS(bool, SBDebugger, IsValid);
   return this->operator bool();
@@ -1595,6 +1615,9 @@ void RegisterMethods<SBDebugger>(Registry &R) {
   LLDB_REGISTER_STATIC_METHOD(void, SBDebugger, Destroy,
                               (lldb::SBDebugger &));
   LLDB_REGISTER_STATIC_METHOD(void, SBDebugger, MemoryPressureDetected, ());
+  LLDB_REGISTER_STATIC_METHOD(void, SBDebugger, SetTimerTraceEnabled, (bool));
+  LLDB_REGISTER_STATIC_METHOD(lldb::SBError, SBDebugger, ExportTimerTrace,
+                              (const char *));
   LLDB_REGISTER_METHOD_CONST(bool, SBDebugger, IsValid, ());
   LLDB_REGISTER_METHOD_CONST(bool, SBDebugger, operator bool, ());
   LLDB_REGISTER_METHOD(void, SBDebugger, SetAsync, (bool));
@@ -826,6 +826,7 @@ SBValueList SBFrame::GetVariables(const lldb::SBVariablesOptions &options) {
 
 
   std::set<VariableSP> variable_set;
+  std::vector<ValueObjectSP> valobjs;
   Process *process = exe_ctx.GetProcessPtr();
   if (target && process) {
     Process::StopLocker stop_locker;
@@ -880,11 +881,13 @@ SBValueList SBFrame::GetVariables(const lldb::SBVariablesOptions &options) {
                   SBValue value_sb;
                   value_sb.SetSP(valobj_sp, use_dynamic);
                   value_list.Append(value_sb);
+                  valobjs.push_back(valobj_sp);
                 }
               }
             }
           }
         }
+        frame->MaterializeValueObjects(valobjs, use_dynamic);
         if (recognized_arguments) {
           auto recognized_frame = frame->GetRecognizedFrame();
           if (recognized_frame) {
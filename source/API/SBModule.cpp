@@ -708,6 +708,15 @@ lldb::SBAddress SBModule::GetObjectFileEntryPointAddress() const {
   return LLDB_RECORD_RESULT(sb_addr);
 }
 
+uint64_t SBModule::GetMemoryUsage() {
+  LLDB_RECORD_METHOD_NO_ARGS(uint64_t, SBModule, GetMemoryUsage);
+
+  ModuleSP module_sp(GetSP());
+  if (module_sp)
+    return module_sp->GetMemoryUsage().GetTotal();
+  return 0;
+}
+
 namespace lldb_private {
 namespace repro {
 
@@ -782,6 +791,7 @@ void RegisterMethods<SBModule>(Registry &R) {
                              GetObjectFileHeaderAddress, ());
   LLDB_REGISTER_METHOD_CONST(lldb::SBAddress, SBModule,
                              GetObjectFileEntryPointAddress, ());
+  LLDB_REGISTER_METHOD(uint64_t, SBModule, GetMemoryUsage, ());
 }
 
 }
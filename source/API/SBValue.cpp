@@ -1014,6 +1014,20 @@ uint32_t SBValue::GetNumChildren(uint32_t max) {
   return num_children;
 }
 
+uint32_t SBValue::PrefetchChildren(uint32_t start_idx, uint32_t count) {
+  LLDB_RECORD_METHOD(uint32_t, SBValue, PrefetchChildren, (uint32_t, uint32_t),
+                     start_idx, count);
+
+  uint32_t num_prefetched = 0;
+
+  ValueLocker locker;
+  lldb::ValueObjectSP value_sp(GetSP(locker));
+  if (value_sp)
+    num_prefetched = value_sp->PrefetchChildren(start_idx, count);
+
+  return num_prefetched;
+}
+
 SBValue SBValue::Dereference() {
   LLDB_RECORD_METHOD_NO_ARGS(lldb::SBValue, SBValue, Dereference);
 
@@ -1570,6 +1584,8 @@ void RegisterMethods<SBValue>(Registry &R) {
   LLDB_REGISTER_METHOD(bool, SBValue, IsRuntimeSupportValue, ());
   LLDB_REGISTER_METHOD(uint32_t, SBValue, GetNumChildren, ());
   LLDB_REGISTER_METHOD(uint32_t, SBValue, GetNumChildren, (uint32_t));
+  LLDB_REGISTER_METHOD(uint32_t, SBValue, PrefetchChildren,
+                       (uint32_t, uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBValue, SBValue, Dereference, ());
   LLDB_REGISTER_METHOD(bool, SBValue, TypeIsPointerType, ());
   LLDB_REGISTER_METHOD(void *, SBValue, GetOpaqueType, ());
@@ -503,6 +503,20 @@ protected:
     return llvm::StringRef::withNullAsEmpty(nullptr);
   }
 
+  bool ShouldShowVariable(const VariableSP &var_sp) {
+    switch (var_sp->GetScope()) {
+    case eValueTypeVariableGlobal:
+    case eValueTypeVariableStatic:
+      return m_option_variable.show_globals;
+    case eValueTypeVariableArgument:
+      return m_option_variable.show_args;
+    case eValueTypeVariableLocal:
+      return m_option_variable.show_locals;
+    default:
+      return false;
+    }
+  }
+
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     // No need to check "frame" for validity as eCommandRequiresFrame ensures
     // it is valid
@@ -649,29 +663,22 @@ protected:
       {
         const size_t num_variables = variable_list->GetSize();
         if (num_variables > 0) {
+          // Give the frame a chance to compute everything we are about to
+          // print at once; the values are printed in order below.
+          std::vector<ValueObjectSP> valobjs;
           for (size_t i = 0; i < num_variables; i++) {
             var_sp = variable_list->GetVariableAtIndex(i);
-            switch (var_sp->GetScope()) {
-            case eValueTypeVariableGlobal:
-              if (!m_option_variable.show_globals)
-                continue;
-              break;
-            case eValueTypeVariableStatic:
-              if (!m_option_variable.show_globals)
-                continue;
-              break;
-            case eValueTypeVariableArgument:
-              if (!m_option_variable.show_args)
-                continue;
-              break;
-            case eValueTypeVariableLocal:
-              if (!m_option_variable.show_locals)
-                continue;
-              break;
-            default:
+            if (ShouldShowVariable(var_sp))
+              valobjs.push_back(frame->GetValueObjectForFrameVariable(
+                  var_sp, eNoDynamicValues));
+          }
+          frame->MaterializeValueObjects(valobjs,
+                                         m_varobj_options.use_dynamic);
+
+          for (size_t i = 0; i < num_variables; i++) {
+            var_sp = variable_list->GetVariableAtIndex(i);
+            if (!ShouldShowVariable(var_sp))
               continue;
-              break;
-            }
             std::string scope_string;
             if (m_option_variable.show_scope)
               scope_string = GetScopeString(var_sp).str();
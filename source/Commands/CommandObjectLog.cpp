@@ -43,6 +43,8 @@ static constexpr OptionDefinition g_log_options[] = {
   { LLDB_OPT_SET_1, false, "stack",      'S', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,     "Append a stack backtrace to each log line." },
   { LLDB_OPT_SET_1, false, "append",     'a', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,     "Append to the log file instead of overwriting." },
   { LLDB_OPT_SET_1, false, "file-function",'F',OptionParser::eNoArgument,      nullptr, {}, 0, eArgTypeNone,     "Prepend the names of files and function that generate the logs." },
+  { LLDB_OPT_SET_1, false, "async",      'A', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,     "Queue log messages and write them from a background thread instead of the thread that logs them." },
+  { LLDB_OPT_SET_1, false, "buffer",     'b', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeUnsignedInteger, "Keep only the last <n> megabytes of log messages in memory. They are written out by 'log dump' or if LLDB crashes. Implies --async." },
     // clang-format on
 };
 
@@ -126,6 +128,18 @@ public:
       case 'F':
         log_options |= LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION;
         break;
+      case 'A':
+        log_options |= LLDB_LOG_OPTION_ASYNC;
+        break;
+      case 'b': {
+        uint64_t megabytes;
+        if (option_arg.getAsInteger(0, megabytes) || megabytes == 0)
+          error.SetErrorStringWithFormat("invalid buffer size '%s'",
+                                         option_arg.str().c_str());
+        else
+          buffer_size = megabytes * 1024 * 1024;
+        break;
+      }
       default:
         error.SetErrorStringWithFormat("unrecognized option '%c'",
                                        short_option);
@@ -138,6 +152,7 @@ public:
     void OptionParsingStarting(ExecutionContext *execution_context) override {
       log_file.Clear();
       log_options = 0;
+      buffer_size = 0;
     }
 
     llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
@@ -148,6 +163,7 @@ public:
 
     FileSpec log_file;
     uint32_t log_options;
+    size_t buffer_size = 0;
   };
 
 protected:
@@ -172,7 +188,7 @@ protected:
     llvm::raw_string_ostream error_stream(error);
     bool success = m_interpreter.GetDebugger().EnableLog(
         channel, args.GetArgumentArrayRef(), log_file, m_options.log_options,
-        error_stream);
+        error_stream, m_options.buffer_size);
     result.GetErrorStream() << error_stream.str();
 
     if (success)
@@ -292,6 +308,52 @@ protected:
   }
 };
 
+class CommandObjectLogDump : public CommandObjectParsed {
+public:
+  //------------------------------------------------------------------
+  // Constructors and Destructors
+  //------------------------------------------------------------------
+  CommandObjectLogDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "log dump",
+                            "Write out the log messages buffered for a log "
+                            "channel enabled with --async or --buffer.",
+                            nullptr) {
+    CommandArgumentEntry arg;
+    CommandArgumentData channel_arg;
+
+    // Define the first (and only) variant of this arg.
+    channel_arg.arg_type = eArgTypeLogChannel;
+    channel_arg.arg_repetition = eArgRepeatPlain;
+
+    // There is only one variant this argument could be; put it into the
+    // argument entry.
+    arg.push_back(channel_arg);
+
+    // Push the data for the first argument into the m_arguments vector.
+    m_arguments.push_back(arg);
+  }
+
+  ~CommandObjectLogDump() override = default;
+
+protected:
+  bool DoExecute(Args &args, CommandReturnObject &result) override {
+    if (args.GetArgumentCount() != 1) {
+      result.AppendErrorWithFormat("%s takes a log channel.\n",
+                                   m_cmd_name.c_str());
+      return false;
+    }
+
+    std::string error;
+    llvm::raw_string_ostream error_stream(error);
+    if (Log::DumpLogChannel(args[0].ref, error_stream))
+      result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    else
+      result.SetStatus(eReturnStatusFailed);
+    result.GetErrorStream() << error_stream.str();
+    return result.Succeeded();
+  }
+};
+
 class CommandObjectLogTimer : public CommandObjectParsed {
 public:
   //------------------------------------------------------------------
@@ -302,7 +364,8 @@ public:
                             "Enable, disable, dump, and reset LLDB internal "
                             "performance timers.",
                             "log timers < enable <depth> | disable | dump | "
-                            "increment <bool> | reset >") {}
+                            "increment <bool> | trace <bool> | export <file> "
+                            "| reset >") {}
 
   ~CommandObjectLogTimer() override = default;
 
@@ -325,6 +388,7 @@ protected:
         result.SetStatus(eReturnStatusSuccessFinishResult);
       } else if (sub_command.equals_lower("reset")) {
         Timer::ResetCategoryTimes();
+        Timer::ResetTrace();
         result.SetStatus(eReturnStatusSuccessFinishResult);
       }
     } else if (args.GetArgumentCount() == 2) {
@@ -348,6 +412,24 @@ protected:
           result.SetStatus(eReturnStatusSuccessFinishNoResult);
         } else
           result.AppendError("Could not convert increment value to boolean.");
+      } else if (sub_command.equals_lower("trace")) {
+        bool success;
+        bool trace = OptionArgParser::ToBoolean(param, false, &success);
+        if (success) {
+          Timer::SetTraceEnabled(trace);
+          result.SetStatus(eReturnStatusSuccessFinishNoResult);
+        } else
+          result.AppendError("Could not convert trace value to boolean.");
+      } else if (sub_command.equals_lower("export")) {
+        FileSpec trace_file(param);
+        FileSystem::Instance().Resolve(trace_file);
+        if (llvm::Error error = Timer::ExportTrace(trace_file.GetPath()))
+          result.AppendErrorWithFormat(
+              "Could not write timer trace to '%s': %s.\n",
+              trace_file.GetPath().c_str(),
+              llvm::toString(std::move(error)).c_str());
+        else
+          result.SetStatus(eReturnStatusSuccessFinishNoResult);
       }
     }
 
@@ -369,6 +451,8 @@ CommandObjectLog::CommandObjectLog(CommandInterpreter &interpreter)
                  CommandObjectSP(new CommandObjectLogDisable(interpreter)));
   LoadSubCommand("list",
                  CommandObjectSP(new CommandObjectLogList(interpreter)));
+  LoadSubCommand("dump",
+                 CommandObjectSP(new CommandObjectLogDump(interpreter)));
   LoadSubCommand("timers",
                  CommandObjectSP(new CommandObjectLogTimer(interpreter)));
 }
@@ -7,10 +7,22 @@
 //===----------------------------------------------------------------------===//
 
 #include "CommandObjectStats.h"
+#include "lldb/Core/Module.h"
+#include "lldb/DataFormatters/DataVisualization.h"
+#include "lldb/Host/DebugFileIndex.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Symbol/ClangASTImporter.h"
+#include "lldb/Symbol/FileCRCCache.h"
+#include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
+#include "lldb/Symbol/SwiftPersistentTypeCache.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/SwiftLanguageRuntime.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/BloomFilter.h"
+#include "lldb/Utility/StreamString.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -86,6 +98,84 @@ protected:
           stat);
       i += 1;
     }
+    result.AppendMessageWithFormat(
+        "Number of formatter cache hits : %" PRIu64 "\n",
+        DataVisualization::GetFormatCacheHits());
+    result.AppendMessageWithFormat(
+        "Number of formatter cache misses : %" PRIu64 "\n",
+        DataVisualization::GetFormatCacheMisses());
+    result.AppendMessageWithFormat(
+        "Number of swift type cache hits : %" PRIu64 "\n",
+        SwiftPersistentTypeCache::GetCacheHits());
+    result.AppendMessageWithFormat(
+        "Number of swift type cache misses : %" PRIu64 "\n",
+        SwiftPersistentTypeCache::GetCacheMisses());
+    result.AppendMessageWithFormat(
+        "Number of module crc32 cache hits : %" PRIu64 "\n",
+        FileCRCCache::GetCacheHits());
+    result.AppendMessageWithFormat(
+        "Number of module crc32 cache misses : %" PRIu64 "\n",
+        FileCRCCache::GetCacheMisses());
+    result.AppendMessageWithFormat(
+        "Seconds saved by the module crc32 cache : %.3f\n",
+        FileCRCCache::GetSecondsSaved());
+    result.AppendMessageWithFormat(
+        "Number of debug file lookups avoided by the index : %" PRIu64 "\n",
+        DebugFileIndex::GetLookupsAvoided());
+    result.AppendMessageWithFormat(
+        "Number of debug file directories scanned : %" PRIu64 "\n",
+        DebugFileIndex::GetDirectoriesScanned());
+    const uint64_t lookups_avoided = BloomFilter::GetLookupsAvoided();
+    const uint64_t false_positives = BloomFilter::GetFalsePositives();
+    result.AppendMessageWithFormat(
+        "Number of name lookups avoided by Bloom filters : %" PRIu64 "\n",
+        lookups_avoided);
+    result.AppendMessageWithFormat(
+        "Number of Bloom filter false positives : %" PRIu64 "\n",
+        false_positives);
+    if (lookups_avoided + false_positives)
+      result.AppendMessageWithFormat(
+          "Bloom filter false positive rate : %.2f%%\n",
+          100.0 * false_positives / (lookups_avoided + false_positives));
+    if (ClangASTImporterSP importer_sp = target->GetClangASTImporter()) {
+      result.AppendMessageWithFormat(
+          "Number of clang name lookup cache hits : %" PRIu64 "\n",
+          importer_sp->GetLookupCacheHits());
+      result.AppendMessageWithFormat(
+          "Number of clang name lookup cache misses : %" PRIu64 "\n",
+          importer_sp->GetLookupCacheMisses());
+    }
+    if (Process *process = target->GetProcessSP().get()) {
+      if (auto *swift_runtime = SwiftLanguageRuntime::Get(*process)) {
+        auto stats = swift_runtime->GetMetadataCacheStatistics();
+        result.AppendMessageWithFormat(
+            "Number of swift class metadata cache hits : %" PRIu64 "\n",
+            stats.cache_hits);
+        result.AppendMessageWithFormat(
+            "Number of swift class metadata cache misses : %" PRIu64 "\n",
+            stats.cache_misses);
+        result.AppendMessageWithFormat(
+            "Number of swift metadata reads from file images : %" PRIu64 "\n",
+            stats.file_image_reads);
+        result.AppendMessageWithFormat(
+            "Number of swift metadata reads from memory : %" PRIu64 "\n",
+            stats.memory_reads);
+      }
+    }
+    const ModuleList &images = target->GetImages();
+    for (size_t idx = 0; idx < images.GetSize(); ++idx) {
+      ModuleSP module_sp = images.GetModuleAtIndex(idx);
+      // Don't load symbols just to report that nothing was done with them.
+      SymbolVendor *symbols =
+          module_sp ? module_sp->GetSymbolVendor(false) : nullptr;
+      SymbolFile *symbol_file = symbols ? symbols->GetSymbolFile() : nullptr;
+      if (!symbol_file)
+        continue;
+      StreamString strm;
+      symbol_file->DumpStatistics(strm);
+      if (!strm.Empty())
+        result.AppendMessageWithFormat("%s", strm.GetData());
+    }
     result.SetStatus(eReturnStatusSuccessFinishResult);
     return true;
   }
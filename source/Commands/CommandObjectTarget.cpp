@@ -670,10 +670,13 @@ protected:
       target_sp->Destroy();
     }
     // If "--clean" was specified, prune any orphaned shared modules from the
-    // global shared module list
+    // global shared module list. Otherwise keep them, but within
+    // symbols.unused-module-memory-budget.
     if (m_cleanup_option.GetOptionValue()) {
       const bool mandatory = true;
       ModuleList::RemoveOrphanSharedModules(mandatory);
+    } else {
+      ModuleList::ReleaseUnusedSharedModuleInfo();
     }
     result.GetOutputStream().Printf("%u targets deleted.\n",
                                     (uint32_t)num_targets_to_delete);
@@ -3031,6 +3034,7 @@ static constexpr OptionDefinition g_target_modules_list_options[] = {
   { LLDB_OPT_SET_1, false, "symfile-unique", 'S', OptionParser::eOptionalArgument, nullptr, {}, 0, eArgTypeWidth,               "Display the symbol file with optional width only if it is different from the executable object file." },
   { LLDB_OPT_SET_1, false, "mod-time",       'm', OptionParser::eOptionalArgument, nullptr, {}, 0, eArgTypeWidth,               "Display the modification time with optional width of the module." },
   { LLDB_OPT_SET_1, false, "ref-count",      'r', OptionParser::eOptionalArgument, nullptr, {}, 0, eArgTypeWidth,               "Display the reference count if the module is still in the shared module cache." },
+  { LLDB_OPT_SET_1, false, "memory",         'M', OptionParser::eOptionalArgument, nullptr, {}, 0, eArgTypeWidth,               "Display an estimate of the memory in bytes used by the symbols, debug information, line tables and types parsed for the module." },
   { LLDB_OPT_SET_1, false, "pointer",        'p', OptionParser::eOptionalArgument, nullptr, {}, 0, eArgTypeNone,                "Display the module pointer." },
   { LLDB_OPT_SET_1, false, "global",         'g', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,                "Display the modules from the global module list, not just the current target." }
     // clang-format on
@@ -3353,6 +3357,15 @@ protected:
                                               llvm::AlignStyle::Left, width));
         break;
 
+      case 'M': {
+        const ModuleMemoryUsage usage = module->GetMemoryUsage();
+        strm.Printf("{%*" PRIu64 " bytes: symtab %" PRIu64
+                    ", debug info %" PRIu64 ", line tables %" PRIu64
+                    ", types %" PRIu64 "}",
+                    width, usage.GetTotal(), usage.symtab, usage.debug_info,
+                    usage.line_tables, usage.types);
+      } break;
+
       case 'p':
         strm.Printf("%p", static_cast<void *>(module));
         break;
@@ -51,6 +51,7 @@
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadList.h"
 #include "lldb/Utility/AnsiTerminal.h"
+#include "lldb/Utility/AsyncLogStream.h"
 #include "lldb/Utility/Event.h"
 #include "lldb/Utility/Listener.h"
 #include "lldb/Utility/Log.h"
@@ -292,7 +293,11 @@ static constexpr PropertyDefinition g_properties[] = {
     {"frame-format-unique", OptionValue::eTypeFormatEntity, true, 0,
      DEFAULT_FRAME_FORMAT_NO_ARGS, {},
      "The default frame format string to use when displaying stack frame"
-     "information for threads from thread backtrace unique."}};
+     "information for threads from thread backtrace unique."},
+    {"source-cache-max-size", OptionValue::eTypeUInt64, true, 256 * 1024 * 1024,
+     nullptr, {},
+     "The maximum number of bytes of source file contents the debugger keeps "
+     "cached. Least recently displayed files are dropped first."}};
 
 enum {
   ePropertyAutoConfirm = 0,
@@ -320,6 +325,7 @@ enum {
   ePropertyTabSize,
   ePropertyEscapeNonPrintables,
   ePropertyFrameFormatUnique,
+  ePropertySourceCacheMaxSize,
 };
 
 LoadPluginCallbackType Debugger::g_load_plugin_callback = nullptr;
@@ -514,6 +520,12 @@ uint32_t Debugger::GetStopSourceLineCount(bool before) const {
       nullptr, idx, g_properties[idx].default_uint_value);
 }
 
+uint64_t Debugger::GetSourceCacheMaxSize() const {
+  const uint32_t idx = ePropertySourceCacheMaxSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
 Debugger::StopDisassemblyType Debugger::GetStopDisassemblyDisplay() const {
   const uint32_t idx = ePropertyStopDisassemblyDisplay;
   return (Debugger::StopDisassemblyType)
@@ -1293,23 +1305,28 @@ void Debugger::SetLoggingCallback(lldb::LogOutputCallback log_callback,
 bool Debugger::EnableLog(llvm::StringRef channel,
                          llvm::ArrayRef<const char *> categories,
                          llvm::StringRef log_file, uint32_t log_options,
-                         llvm::raw_ostream &error_stream) {
+                         llvm::raw_ostream &error_stream, size_t buffer_size) {
   const bool should_close = true;
   const bool unbuffered = true;
 
   std::shared_ptr<llvm::raw_ostream> log_stream_sp;
+  // Where an async log's history goes if LLDB crashes.
+  int log_fd = -1;
   if (m_log_callback_stream_sp) {
     log_stream_sp = m_log_callback_stream_sp;
     // For now when using the callback mode you always get thread & timestamp.
     log_options |=
         LLDB_LOG_OPTION_PREPEND_TIMESTAMP | LLDB_LOG_OPTION_PREPEND_THREAD_NAME;
   } else if (log_file.empty()) {
+    log_fd = GetOutputFile()->GetFile().GetDescriptor();
     log_stream_sp = std::make_shared<llvm::raw_fd_ostream>(
-        GetOutputFile()->GetFile().GetDescriptor(), !should_close, unbuffered);
+        log_fd, !should_close, unbuffered);
   } else {
     auto pos = m_log_streams.find(log_file);
-    if (pos != m_log_streams.end())
-      log_stream_sp = pos->second.lock();
+    if (pos != m_log_streams.end()) {
+      log_stream_sp = pos->second.first.lock();
+      log_fd = pos->second.second;
+    }
     if (!log_stream_sp) {
       llvm::sys::fs::OpenFlags flags = llvm::sys::fs::F_Text;
       if (log_options & LLDB_LOG_OPTION_APPEND)
@@ -1322,7 +1339,8 @@ bool Debugger::EnableLog(llvm::StringRef channel,
       }
       log_stream_sp =
           std::make_shared<llvm::raw_fd_ostream>(FD, should_close, unbuffered);
-      m_log_streams[log_file] = log_stream_sp;
+      log_fd = FD;
+      m_log_streams[log_file] = std::make_pair(log_stream_sp, FD);
     }
   }
   assert(log_stream_sp);
@@ -1331,6 +1349,12 @@ bool Debugger::EnableLog(llvm::StringRef channel,
     log_options =
         LLDB_LOG_OPTION_PREPEND_THREAD_NAME | LLDB_LOG_OPTION_THREADSAFE;
 
+  if (buffer_size)
+    log_options |= LLDB_LOG_OPTION_ASYNC;
+  if (log_options & LLDB_LOG_OPTION_ASYNC)
+    log_stream_sp = std::make_shared<AsyncLogStream>(
+        log_stream_sp, buffer_size, AsyncLogStream::DefaultRingSize, log_fd);
+
   return Log::EnableLogChannel(log_stream_sp, log_options, channel, categories,
                                error_stream);
 }
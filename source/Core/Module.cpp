@@ -1486,16 +1486,7 @@ void Module::SetSymbolFileFileSpec(const FileSpec &file) {
           }
         }
 
-        if (obj_file != m_objfile_sp.get()) {
-          size_t num_sections = section_list->GetNumSections(0);
-          for (size_t idx = num_sections; idx > 0; --idx) {
-            lldb::SectionSP section_sp(
-                section_list->GetSectionAtIndex(idx - 1));
-            if (section_sp->GetObjectFile() == obj_file) {
-              section_list->DeleteSection(idx - 1);
-            }
-          }
-        }
+        RemoveSectionsOfSymbolFile(*section_list, obj_file);
       }
     }
     // Keep all old symbol files around in case there are any lingering type
@@ -1507,6 +1498,65 @@ void Module::SetSymbolFileFileSpec(const FileSpec &file) {
   m_did_load_symbol_vendor = false;
 }
 
+void Module::RemoveSectionsOfSymbolFile(SectionList &section_list,
+                                        ObjectFile *obj_file) {
+  // Sections of the module's own object file stay.
+  if (obj_file == m_objfile_sp.get())
+    return;
+  size_t num_sections = section_list.GetNumSections(0);
+  for (size_t idx = num_sections; idx > 0; --idx) {
+    lldb::SectionSP section_sp(section_list.GetSectionAtIndex(idx - 1));
+    if (section_sp->GetObjectFile() == obj_file)
+      section_list.DeleteSection(idx - 1);
+  }
+}
+
+ModuleMemoryUsage Module::GetMemoryUsage() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  ModuleMemoryUsage usage;
+  if (m_objfile_sp)
+    if (Symtab *symtab = m_objfile_sp->GetParsedSymtab())
+      usage.symtab = symtab->GetMemoryUsage();
+  if (m_symfile_up) {
+    if (SymbolFile *symbol_file = m_symfile_up->GetSymbolFile())
+      usage.debug_info = symbol_file->GetDebugInfoMemoryUsage();
+    usage.line_tables = m_symfile_up->GetLineTableMemoryUsage();
+  }
+  m_type_system_map.ForEach([&usage](TypeSystem *type_system) {
+    usage.types += type_system->GetMemoryUsage();
+    return true;
+  });
+  return usage;
+}
+
+void Module::ReleaseParsedInfo() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  Log *log(lldb_private::GetLogIfAnyCategoriesSet(LIBLLDB_LOG_MODULES));
+  if (log != nullptr)
+    log->Printf("%p Module::ReleaseParsedInfo ('%s')",
+                static_cast<void *>(this), m_file.GetPath().c_str());
+
+  // Same order as in the destructor: the symbol file can still refer to the
+  // type systems and the symbol table while it is torn down.
+  if (m_symfile_up) {
+    SymbolFile *symbol_file = m_symfile_up->GetSymbolFile();
+    SectionList *section_list = m_sections_up.get();
+    if (symbol_file && section_list)
+      RemoveSectionsOfSymbolFile(*section_list, symbol_file->GetObjectFile());
+    m_symfile_up.reset();
+  }
+  m_old_symfiles.clear();
+  m_did_load_symbol_vendor = false;
+  m_type_system_map.Clear();
+  if (m_objfile_sp)
+    m_objfile_sp->ClearSymtab();
+}
+
+void Module::UpdateLastUse() {
+  static std::atomic<uint64_t> g_use_count(0);
+  m_last_use = ++g_use_count;
+}
+
 bool Module::IsExecutable() {
   if (GetObjectFile() == nullptr)
     return false;
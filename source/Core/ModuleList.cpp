@@ -12,16 +12,19 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Symbols.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Interpreter/OptionValueFileSpec.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Interpreter/Property.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/TypeList.h"
 #include "lldb/Symbol/VariableList.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/Logging.h"
+#include "lldb/Utility/Timer.h"
 #include "lldb/Utility/UUID.h"
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-private-types.h"
@@ -31,11 +34,15 @@
 #endif
 
 #include "clang/Driver/Driver.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -104,13 +111,64 @@ static constexpr PropertyDefinition g_properties[] = {
     {"swift-module-loading-mode", OptionValue::eTypeEnum, false,
      eSwiftModuleLoadingModePreferSerialized, nullptr,
      OptionEnumValues(g_swift_module_loading_mode_enums),
-     "The module loading mode to use when loading modules for Swift."}};
+     "The module loading mode to use when loading modules for Swift."},
+    {"swift-type-cache-path", OptionValue::eTypeFileSpec, true, 0, nullptr,
+     {},
+     "The path to the directory where the outcome of Swift type "
+     "reconstruction and module imports is cached across debug sessions. "
+     "Set to an empty path to disable the cache."},
+    {"swift-type-cache-max-size", OptionValue::eTypeUInt64, true,
+     64 * 1024 * 1024, nullptr, {},
+     "The maximum size in bytes of the files in swift-type-cache-path. The "
+     "least recently written files are deleted when it is exceeded. 0 "
+     "disables the cache."},
+    {"lazy-member-function-parsing", OptionValue::eTypeBoolean, true, false,
+     nullptr, {},
+     "Don't add the non-virtual member functions of a C++ class from DWARF "
+     "when the class is completed, but only once they are looked up by name "
+     "or the members of the class are enumerated. Speeds up debugging code "
+     "with very large classes. Only affects modules loaded afterwards."},
+    {"module-crc-cache-path", OptionValue::eTypeFileSpec, true, 0, nullptr,
+     {},
+     "The path to the directory where the CRC32 checksums of ELF files "
+     "without a build ID are cached across debug sessions. Set to an empty "
+     "path to only cache them in memory."},
+    {"debug-file-index-path", OptionValue::eTypeFileSpec, true, 0, nullptr,
+     {},
+     "The path to the directory where the listings of the directories "
+     "searched for separate debug files are cached across debug sessions. "
+     "Leave empty to only cache them in memory."},
+    {"debug-names-cache-path", OptionValue::eTypeFileSpec, true, 0, nullptr,
+     {},
+     "The path to the directory where name indexes generated for modules "
+     "built without .debug_names or Apple accelerator tables are stored, by "
+     "build ID. Set to an empty path to never use them."},
+    {"unused-module-memory-budget", OptionValue::eTypeUInt64, true, 0,
+     nullptr, {},
+     "The maximum number of bytes of symbols, debug information, line tables "
+     "and types kept for modules that no target uses anymore, so that they "
+     "are ready if a new target loads the same files. When it is exceeded, "
+     "this information is released for the least recently used modules, to "
+     "be parsed again if needed. 0 never releases it."},
+    {"use-name-lookup-filters", OptionValue::eTypeBoolean, true, true,
+     nullptr, {},
+     "Build a Bloom filter next to the symbol table and DWARF name indexes "
+     "of each module, so that looking up a name skips the modules that "
+     "certainly don't have it. Applies to indexes built after it is set."}};
 
 enum {
   ePropertyEnableExternalLookup,
   ePropertyUseDWARFImporter,
   ePropertyClangModulesCachePath,
-  ePropertySwiftModuleLoadingMode
+  ePropertySwiftModuleLoadingMode,
+  ePropertySwiftTypeCachePath,
+  ePropertySwiftTypeCacheMaxSize,
+  ePropertyLazyMemberFunctionParsing,
+  ePropertyModuleCRCCachePath,
+  ePropertyDebugFileIndexPath,
+  ePropertyDebugNamesCachePath,
+  ePropertyUnusedModuleMemoryBudget,
+  ePropertyUseNameLookupFilters
 };
 
 } // namespace
@@ -124,6 +182,23 @@ ModuleListProperties::ModuleListProperties() {
   clang::driver::Driver::getDefaultModuleCachePath(path);
   SetClangModulesCachePath(path);
   SetSwiftModuleLoadingMode(eSwiftModuleLoadingModePreferSerialized);
+
+  path.clear();
+  if (!llvm::sys::path::cache_directory(path))
+    llvm::sys::path::system_temp_directory(/*erasedOnReboot=*/false, path);
+  llvm::sys::path::append(path, "lldb", "SwiftTypeCache");
+  m_collection_sp->SetPropertyAtIndexAsString(
+      nullptr, ePropertySwiftTypeCachePath, path);
+
+  llvm::sys::path::remove_filename(path);
+  llvm::sys::path::append(path, "ModuleCRCCache");
+  m_collection_sp->SetPropertyAtIndexAsString(
+      nullptr, ePropertyModuleCRCCachePath, path);
+
+  llvm::sys::path::remove_filename(path);
+  llvm::sys::path::append(path, "DebugNames");
+  m_collection_sp->SetPropertyAtIndexAsString(
+      nullptr, ePropertyDebugNamesCachePath, path);
 }
 
 bool ModuleListProperties::GetEnableExternalLookup() const {
@@ -162,6 +237,58 @@ bool ModuleListProperties::SetSwiftModuleLoadingMode(SwiftModuleLoadingMode mode
       nullptr, ePropertySwiftModuleLoadingMode, mode);
 }
 
+FileSpec ModuleListProperties::GetSwiftTypeCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                ePropertySwiftTypeCachePath)
+      ->GetCurrentValue();
+}
+
+uint64_t ModuleListProperties::GetSwiftTypeCacheMaxSize() const {
+  const uint32_t idx = ePropertySwiftTypeCacheMaxSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
+bool ModuleListProperties::GetLazyMemberFunctionParsing() const {
+  const uint32_t idx = ePropertyLazyMemberFunctionParsing;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
+FileSpec ModuleListProperties::GetModuleCRCCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                ePropertyModuleCRCCachePath)
+      ->GetCurrentValue();
+}
+
+FileSpec ModuleListProperties::GetDebugFileIndexPath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                ePropertyDebugFileIndexPath)
+      ->GetCurrentValue();
+}
+
+FileSpec ModuleListProperties::GetDebugNamesCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(nullptr, false,
+                                                ePropertyDebugNamesCachePath)
+      ->GetCurrentValue();
+}
+
+uint64_t ModuleListProperties::GetUnusedModuleMemoryBudget() const {
+  const uint32_t idx = ePropertyUnusedModuleMemoryBudget;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
+bool ModuleListProperties::GetUseNameLookupFilters() const {
+  const uint32_t idx = ePropertyUseNameLookupFilters;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
 
 ModuleList::ModuleList()
     : m_modules(), m_modules_mutex(), m_notifier(nullptr) {}
@@ -383,6 +510,65 @@ ModuleSP ModuleList::GetModuleAtIndexUnlocked(size_t idx) const {
   return module_sp;
 }
 
+ModuleList::collection ModuleList::GetModulesCopy() const {
+  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+  return m_modules;
+}
+
+// Handing fewer modules than this to other threads costs more than it saves.
+static const size_t g_min_modules_to_search_in_parallel = 8;
+
+// Call "search" with the index of every module to search, on several
+// threads. "search" puts the results of each module aside and returns how
+// many it found. Modules are skipped once the modules before them found
+// "max_matches" between them, which is where a search in order would have
+// stopped. Return how many modules, from the first one, make up the results,
+// so that they can be combined in module order no matter which thread
+// finished first.
+static size_t SearchModules(size_t num_modules,
+                            llvm::function_ref<size_t(size_t)> search,
+                            size_t max_matches = SIZE_MAX) {
+  if (num_modules < g_min_modules_to_search_in_parallel) {
+    size_t total_matches = 0;
+    for (size_t idx = 0; idx < num_modules; ++idx) {
+      total_matches += search(idx);
+      if (total_matches >= max_matches)
+        return idx + 1;
+    }
+    return num_modules;
+  }
+
+  std::vector<size_t> num_matches(num_modules, 0);
+  std::unique_ptr<std::atomic<bool>[]> searched(
+      new std::atomic<bool>[num_modules]());
+  // The modules before "prefix_end" are all searched.
+  std::mutex prefix_mutex;
+  size_t prefix_end = 0;
+  size_t prefix_matches = 0;
+  auto found_enough = [&]() {
+    std::lock_guard<std::mutex> guard(prefix_mutex);
+    while (prefix_matches < max_matches && prefix_end < num_modules &&
+           searched[prefix_end])
+      prefix_matches += num_matches[prefix_end++];
+    return prefix_matches >= max_matches;
+  };
+
+  TaskMapOverInt(0, num_modules, [&](size_t idx) {
+    if (max_matches != SIZE_MAX && found_enough())
+      return;
+    num_matches[idx] = search(idx);
+    searched[idx] = true;
+  });
+
+  size_t total_matches = 0;
+  for (size_t idx = 0; idx < num_modules; ++idx) {
+    total_matches += num_matches[idx];
+    if (total_matches >= max_matches)
+      return idx + 1;
+  }
+  return num_modules;
+}
+
 size_t ModuleList::FindFunctions(ConstString name,
                                  FunctionNameType name_type_mask,
                                  bool include_symbols, bool include_inlines,
@@ -393,28 +579,30 @@ size_t ModuleList::FindFunctions(ConstString name,
 
   const size_t old_size = sc_list.GetSize();
 
+  ConstString lookup_name = name;
+  FunctionNameType lookup_name_type_mask = name_type_mask;
+  Module::LookupInfo lookup_info(name, name_type_mask, eLanguageTypeUnknown);
   if (name_type_mask & eFunctionNameTypeAuto) {
-    Module::LookupInfo lookup_info(name, name_type_mask, eLanguageTypeUnknown);
+    lookup_name = lookup_info.GetLookupName();
+    lookup_name_type_mask = lookup_info.GetNameTypeMask();
+  }
 
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      (*pos)->FindFunctions(lookup_info.GetLookupName(), nullptr,
-                            lookup_info.GetNameTypeMask(), include_symbols,
-                            include_inlines, true, sc_list);
-    }
+  const collection modules = GetModulesCopy();
+  std::vector<SymbolContextList> module_sc_lists(modules.size());
+  const size_t num_searched =
+      SearchModules(modules.size(), [&](size_t idx) -> size_t {
+        return modules[idx]->FindFunctions(
+            lookup_name, nullptr, lookup_name_type_mask, include_symbols,
+            include_inlines, true, module_sc_lists[idx]);
+      });
+  for (size_t idx = 0; idx < num_searched; ++idx)
+    sc_list.Append(module_sc_lists[idx]);
 
+  if (name_type_mask & eFunctionNameTypeAuto) {
     const size_t new_size = sc_list.GetSize();
 
     if (old_size < new_size)
       lookup_info.Prune(sc_list, old_size);
-  } else {
-    std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-    collection::const_iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      (*pos)->FindFunctions(name, nullptr, name_type_mask, include_symbols,
-                            include_inlines, true, sc_list);
-    }
   }
   return sc_list.GetSize() - old_size;
 }
@@ -454,23 +642,31 @@ size_t ModuleList::FindFunctions(const RegularExpression &name,
                                  bool append, SymbolContextList &sc_list) {
   const size_t initial_size = sc_list.GetSize();
 
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
+  collection modules;
   collection dylinker_modules;
-  for (pos = m_modules.begin(); pos != end; ++pos) {
-    if (!(*pos)->GetIsDynamicLinkEditor())
-      (*pos)->FindFunctions(name, include_symbols, include_inlines, append,
-                            sc_list);
+  for (const ModuleSP &module_sp : GetModulesCopy()) {
+    if (!module_sp->GetIsDynamicLinkEditor())
+      modules.push_back(module_sp);
     else
-      dylinker_modules.push_back(*pos);
+      dylinker_modules.push_back(module_sp);
   }
+
+  std::vector<SymbolContextList> module_sc_lists(modules.size());
+  const size_t num_searched =
+      SearchModules(modules.size(), [&](size_t idx) -> size_t {
+        return modules[idx]->FindFunctions(name, include_symbols,
+                                           include_inlines, true,
+                                           module_sc_lists[idx]);
+      });
+  for (size_t idx = 0; idx < num_searched; ++idx)
+    sc_list.Append(module_sc_lists[idx]);
+
   bool keep_looking = KeepLookingInDylinker(sc_list, initial_size);
 
   if (keep_looking) {
-    end = dylinker_modules.end();
-    for (pos = dylinker_modules.begin(); pos != end; pos++)
-      (*pos)->FindFunctions(name, include_symbols, include_inlines, append,
-                            sc_list);
+    for (const ModuleSP &module_sp : dylinker_modules)
+      module_sp->FindFunctions(name, include_symbols, include_inlines, append,
+                               sc_list);
   }
   return sc_list.GetSize() - initial_size;
 }
@@ -493,11 +689,15 @@ size_t ModuleList::FindGlobalVariables(ConstString name,
                                        size_t max_matches,
                                        VariableList &variable_list) const {
   size_t initial_size = variable_list.GetSize();
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
-    (*pos)->FindGlobalVariables(name, nullptr, max_matches, variable_list);
-  }
+  const collection modules = GetModulesCopy();
+  // "max_matches" limits the matches of each module, not the total.
+  std::vector<VariableList> module_variables(modules.size());
+  SearchModules(modules.size(), [&](size_t idx) -> size_t {
+    return modules[idx]->FindGlobalVariables(name, nullptr, max_matches,
+                                             module_variables[idx]);
+  });
+  for (VariableList &variables : module_variables)
+    variable_list.AddVariables(&variables);
   return variable_list.GetSize() - initial_size;
 }
 
@@ -505,11 +705,14 @@ size_t ModuleList::FindGlobalVariables(const RegularExpression &regex,
                                        size_t max_matches,
                                        VariableList &variable_list) const {
   size_t initial_size = variable_list.GetSize();
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-  collection::const_iterator pos, end = m_modules.end();
-  for (pos = m_modules.begin(); pos != end; ++pos) {
-    (*pos)->FindGlobalVariables(regex, max_matches, variable_list);
-  }
+  const collection modules = GetModulesCopy();
+  std::vector<VariableList> module_variables(modules.size());
+  SearchModules(modules.size(), [&](size_t idx) -> size_t {
+    return modules[idx]->FindGlobalVariables(regex, max_matches,
+                                             module_variables[idx]);
+  });
+  for (VariableList &variables : module_variables)
+    variable_list.AddVariables(&variables);
   return variable_list.GetSize() - initial_size;
 }
 
@@ -655,36 +858,62 @@ ModuleList::FindTypes(Module *search_first, ConstString name,
                       bool name_is_fully_qualified, size_t max_matches,
                       llvm::DenseSet<SymbolFile *> &searched_symbol_files,
                       TypeList &types) const {
-  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
-
   size_t total_matches = 0;
-  collection::const_iterator pos, end = m_modules.end();
-  if (search_first) {
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      if (search_first == pos->get()) {
+  collection modules;
+  for (const ModuleSP &module_sp : GetModulesCopy()) {
+    // Search the module in "search_first" before the others.
+    if (search_first == module_sp.get()) {
+      if (total_matches < max_matches)
         total_matches +=
             search_first->FindTypes(name, name_is_fully_qualified, max_matches,
                                     searched_symbol_files, types);
-
-        if (total_matches >= max_matches)
-          break;
-      }
+    } else {
+      modules.push_back(module_sp);
     }
   }
 
-  if (total_matches < max_matches) {
-    for (pos = m_modules.begin(); pos != end; ++pos) {
-      // Search the module if the module is not equal to the one in the symbol
-      // context "sc". If "sc" contains a empty module shared pointer, then the
-      // comparison will always be true (valid_module_ptr != nullptr).
-      if (search_first != pos->get())
-        total_matches +=
-            (*pos)->FindTypes(name, name_is_fully_qualified, max_matches,
-                              searched_symbol_files, types);
-
-      if (total_matches >= max_matches)
-        break;
-    }
+  if (total_matches >= max_matches)
+    return total_matches;
+
+  // Each module gets its own copy of the symbol files searched so far, and
+  // the copies are combined once all are done. Modules that reach the same
+  // symbol file (a Clang module, say) can both search it, so drop the types
+  // found twice.
+  struct ModuleTypes {
+    llvm::DenseSet<SymbolFile *> searched_symbol_files;
+    TypeList types;
+  };
+  std::vector<ModuleTypes> module_types(modules.size());
+  for (ModuleTypes &result : module_types)
+    result.searched_symbol_files = searched_symbol_files;
+  const size_t num_searched = SearchModules(
+      modules.size(),
+      [&](size_t idx) -> size_t {
+        ModuleTypes &result = module_types[idx];
+        return modules[idx]->FindTypes(name, name_is_fully_qualified,
+                                       max_matches,
+                                       result.searched_symbol_files,
+                                       result.types);
+      },
+      max_matches - total_matches);
+
+  // The search_first module, or the caller, may already have found some.
+  llvm::DenseSet<Type *> found_types;
+  types.ForEach([&](const TypeSP &type_sp) {
+    found_types.insert(type_sp.get());
+    return true;
+  });
+  for (size_t idx = 0; idx < num_searched; ++idx) {
+    ModuleTypes &result = module_types[idx];
+    searched_symbol_files.insert(result.searched_symbol_files.begin(),
+                                 result.searched_symbol_files.end());
+    result.types.ForEach([&](const TypeSP &type_sp) {
+      if (found_types.insert(type_sp.get()).second) {
+        types.Insert(type_sp);
+        ++total_matches;
+      }
+      return true;
+    });
   }
 
   return total_matches;
@@ -880,11 +1109,74 @@ size_t ModuleList::RemoveOrphanSharedModules(bool mandatory) {
   return GetSharedModuleList().RemoveOrphans(mandatory);
 }
 
+size_t ModuleList::ReleaseUnusedSharedModuleInfo() {
+  const uint64_t budget =
+      GetGlobalModuleListProperties().GetUnusedModuleMemoryBudget();
+  if (budget == 0)
+    return 0;
+
+  ModuleList &shared_module_list = GetSharedModuleList();
+  std::lock_guard<std::recursive_mutex> guard(
+      shared_module_list.m_modules_mutex);
+
+  struct UnusedModule {
+    ModuleSP module_sp;
+    uint64_t memory_usage;
+  };
+  std::vector<UnusedModule> unused_modules;
+  uint64_t total_usage = 0;
+  for (const ModuleSP &module_sp : shared_module_list.m_modules) {
+    // Only the shared module list refers to unused modules. Skip modules
+    // that are busy, they are most likely about to be used again.
+    if (!module_sp.unique())
+      continue;
+    std::unique_lock<std::recursive_mutex> lock(module_sp->GetMutex(),
+                                                std::try_to_lock);
+    if (!lock.owns_lock())
+      continue;
+    const uint64_t usage = module_sp->GetMemoryUsage().GetTotal();
+    if (usage == 0)
+      continue;
+    unused_modules.push_back({module_sp, usage});
+    total_usage += usage;
+  }
+  if (total_usage <= budget)
+    return 0;
+
+  std::sort(unused_modules.begin(), unused_modules.end(),
+            [](const UnusedModule &lhs, const UnusedModule &rhs) {
+              return lhs.module_sp->GetLastUse() <
+                     rhs.module_sp->GetLastUse();
+            });
+  size_t num_released = 0;
+  for (UnusedModule &unused : unused_modules) {
+    if (total_usage <= budget)
+      break;
+    // The copy in unused_modules is the only other reference.
+    if (unused.module_sp.use_count() != 2)
+      continue;
+    unused.module_sp->ReleaseParsedInfo();
+    total_usage -= unused.memory_usage;
+    ++num_released;
+  }
+
+  Log *log(lldb_private::GetLogIfAnyCategoriesSet(LIBLLDB_LOG_MODULES));
+  LLDB_LOG(log,
+           "released the parsed information of {0} unused modules, {1} bytes "
+           "are still kept",
+           num_released, total_usage);
+  return num_released;
+}
+
 Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
                                    ModuleSP &module_sp,
                                    const FileSpecList *module_search_paths_ptr,
                                    ModuleSP *old_module_sp_ptr,
                                    bool *did_create_ptr, bool always_create) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "ModuleList::GetSharedModule (file = %s)",
+                     module_spec.GetFileSpec().GetFilename().AsCString(""));
+
   ModuleList &shared_module_list = GetSharedModuleList();
   std::lock_guard<std::recursive_mutex> guard(
       shared_module_list.m_modules_mutex);
@@ -930,6 +1222,7 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
         } else {
           // The module matches and the module was not modified from when it
           // was last loaded.
+          module_sp->UpdateLastUse();
           return error;
         }
       }
@@ -939,6 +1232,9 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
   if (module_sp)
     return error;
 
+  // A new module is about to be parsed, make room for it.
+  ReleaseUnusedSharedModuleInfo();
+
   module_sp = std::make_shared<Module>(module_spec);
   // Make sure there are a module and an object file since we can specify a
   // valid file path with an architecture that might not be in that file. By
@@ -958,6 +1254,7 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
           *did_create_ptr = true;
         }
 
+        module_sp->UpdateLastUse();
         shared_module_list.ReplaceEquivalent(module_sp);
         return error;
       }
@@ -995,6 +1292,7 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
             if (did_create_ptr)
               *did_create_ptr = true;
 
+            module_sp->UpdateLastUse();
             shared_module_list.ReplaceEquivalent(module_sp);
             return Status();
           }
@@ -1093,6 +1391,7 @@ Status ModuleList::GetSharedModule(const ModuleSpec &module_spec,
           if (did_create_ptr)
             *did_create_ptr = true;
 
+          module_sp->UpdateLastUse();
           shared_module_list.ReplaceEquivalent(module_sp);
         }
       } else {
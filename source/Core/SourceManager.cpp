@@ -31,11 +31,13 @@
 
 #include "llvm/ADT/Twine.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 namespace lldb_private {
 class ExecutionContext;
@@ -86,20 +88,20 @@ SourceManager::FileSP SourceManager::GetFile(const FileSpec &file_spec) {
           target_sp->GetSourcePathMap().GetModificationID())
     file_sp.reset();
 
-  // Update the file contents if needed if we found a file
-  if (file_sp)
-    file_sp->UpdateIfNeeded();
-
-  // If file_sp is no good or it points to a non-existent file, reset it.
-  if (!file_sp || !FileSystem::Instance().Exists(file_sp->GetFileSpec())) {
+  // Update the file contents if needed if we found a file. If file_sp is no
+  // good or it points to a non-existent file, reset it.
+  if (!file_sp || !file_sp->UpdateIfNeeded()) {
     if (target_sp)
       file_sp = std::make_shared<File>(file_spec, target_sp.get());
     else
       file_sp = std::make_shared<File>(file_spec, debugger_sp);
-
-    if (debugger_sp)
-      debugger_sp->GetSourceFileCache().AddSourceFile(file_sp);
   }
+
+  // Add new files to the cache, and account for cached files having indexed
+  // more lines or been reloaded since they were last looked up.
+  if (debugger_sp)
+    debugger_sp->GetSourceFileCache().AddSourceFile(
+        file_spec, file_sp, debugger_sp->GetSourceCacheMaxSize());
   return file_sp;
 }
 
@@ -545,18 +547,40 @@ bool SourceManager::File::LineIsValid(uint32_t line) {
   return false;
 }
 
-void SourceManager::File::UpdateIfNeeded() {
+size_t SourceManager::File::GetByteSize() const {
+  size_t byte_size = m_offsets.capacity() * sizeof(LineOffsets::value_type);
+  if (m_data_sp)
+    byte_size += m_data_sp->GetByteSize();
+  return byte_size;
+}
+
+// How long to trust the last modification time we read for a file. Source
+// listings tend to come in bursts (stepping, "source list" repeated) and on
+// network file systems each stat can be slow.
+static const std::chrono::milliseconds g_mod_time_check_interval(500);
+
+bool SourceManager::File::UpdateIfNeeded() {
   // TODO: use host API to sign up for file modifications to anything in our
   // source cache and only update when we determine a file has been updated.
-  // For now we check each time we want to display info for the file.
+  // For now we check at most once per g_mod_time_check_interval.
+  auto now = std::chrono::steady_clock::now();
+  if (m_last_mod_time_check != std::chrono::steady_clock::time_point() &&
+      now - m_last_mod_time_check < g_mod_time_check_interval)
+    return m_mod_time != llvm::sys::TimePoint<>();
+  m_last_mod_time_check = now;
+
   auto curr_mod_time = FileSystem::Instance().GetModificationTime(m_file_spec);
+  if (curr_mod_time == llvm::sys::TimePoint<>())
+    return false;
 
-  if (curr_mod_time != llvm::sys::TimePoint<>() &&
-      m_mod_time != curr_mod_time) {
+  if (m_mod_time != curr_mod_time) {
     m_mod_time = curr_mod_time;
     m_data_sp = FileSystem::Instance().CreateDataBuffer(m_file_spec);
     m_offsets.clear();
+    m_offsets_scan_pos = 0;
+    m_offsets_complete = false;
   }
+  return true;
 }
 
 size_t SourceManager::File::DisplaySourceLines(uint32_t line,
@@ -652,56 +676,47 @@ bool lldb_private::operator==(const SourceManager::File &lhs,
 }
 
 bool SourceManager::File::CalculateLineOffsets(uint32_t line) {
-  line =
-      UINT32_MAX; // TODO: take this line out when we support partial indexing
-  if (line == UINT32_MAX) {
-    // Already done?
-    if (!m_offsets.empty() && m_offsets[0] == UINT32_MAX)
-      return true;
-
-    if (m_offsets.empty()) {
-      if (m_data_sp.get() == NULL)
-        return false;
-
-      const char *start = (char *)m_data_sp->GetBytes();
-      if (start) {
-        const char *end = start + m_data_sp->GetByteSize();
-
-        // Calculate all line offsets from scratch
-
-        // Push a 1 at index zero to indicate the file has been completely
-        // indexed.
-        m_offsets.push_back(UINT32_MAX);
-        const char *s;
-        for (s = start; s < end; ++s) {
-          char curr_ch = *s;
-          if (is_newline_char(curr_ch)) {
-            if (s + 1 < end) {
-              char next_ch = s[1];
-              if (is_newline_char(next_ch)) {
-                if (curr_ch != next_ch)
-                  ++s;
-              }
-            }
-            m_offsets.push_back(s + 1 - start);
-          }
-        }
-        if (!m_offsets.empty()) {
-          if (m_offsets.back() < size_t(end - start))
-            m_offsets.push_back(end - start);
-        }
-        return true;
-      }
-    } else {
-      // Some lines have been populated, start where we last left off
-      assert("Not implemented yet" && false);
+  if (m_offsets_complete)
+    return true;
+
+  if (m_data_sp.get() == NULL)
+    return false;
+
+  const char *start = (const char *)m_data_sp->GetBytes();
+  if (!start)
+    return false;
+  const char *end = start + m_data_sp->GetByteSize();
+
+  // Index zero is unused so that line N starts at m_offsets[N - 1].
+  if (m_offsets.empty())
+    m_offsets.push_back(UINT32_MAX);
+
+  // Only index as far as "line + 1" so that showing a few lines near the top
+  // of a large file doesn't require scanning all of it. The "line + 1" entry
+  // is needed to know where "line" ends.
+  const char *s = start + m_offsets_scan_pos;
+  while (s < end && m_offsets.size() <= line) {
+    // Look for either terminator in a single pass, so each byte is only
+    // looked at once whatever line endings the file uses.
+    const char *eol = std::find_if(s, end, is_newline_char);
+    if (eol == end) {
+      s = end;
+      break;
     }
+    // Treat "\r\n" and "\n\r" as a single line terminator.
+    if (eol + 1 < end && is_newline_char(eol[1]) && eol[1] != *eol)
+      ++eol;
+    s = eol + 1;
+    m_offsets.push_back(s - start);
+  }
+  m_offsets_scan_pos = s - start;
 
-  } else {
-    // Calculate all line offsets up to "line"
-    assert("Not implemented yet" && false);
+  if (s == end) {
+    if (m_offsets.back() < size_t(end - start))
+      m_offsets.push_back(end - start);
+    m_offsets_complete = true;
   }
-  return false;
+  return true;
 }
 
 bool SourceManager::File::GetLine(uint32_t line_no, std::string &buffer) {
@@ -719,22 +734,42 @@ bool SourceManager::File::GetLine(uint32_t line_no, std::string &buffer) {
   return true;
 }
 
-void SourceManager::SourceFileCache::AddSourceFile(const FileSP &file_sp) {
-  FileSpec file_spec;
+void SourceManager::SourceFileCache::AddSourceFile(const FileSpec &file_spec,
+                                                   const FileSP &file_sp,
+                                                   uint64_t max_byte_size) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  // A file grows as its lines are indexed and changes size when it is
+  // reloaded, so measure it again every time it is added.
+  const size_t byte_size = file_sp ? file_sp->GetByteSize() : 0;
   FileCache::iterator pos = m_file_cache.find(file_spec);
-  if (pos == m_file_cache.end())
-    m_file_cache[file_spec] = file_sp;
-  else {
-    if (file_sp != pos->second)
-      m_file_cache[file_spec] = file_sp;
+  if (pos != m_file_cache.end()) {
+    m_byte_size -= pos->second->byte_size;
+    pos->second->file_sp = file_sp;
+    pos->second->byte_size = byte_size;
+    m_entries.splice(m_entries.begin(), m_entries, pos->second);
+  } else {
+    m_entries.push_front({file_spec, file_sp, byte_size});
+    m_file_cache[file_spec] = m_entries.begin();
+  }
+  m_byte_size += byte_size;
+
+  // Evict the least recently used files, but always keep the one we just
+  // added.
+  while (m_byte_size > max_byte_size && m_entries.size() > 1) {
+    CacheEntry &oldest = m_entries.back();
+    m_byte_size -= oldest.byte_size;
+    m_file_cache.erase(oldest.file_spec);
+    m_entries.pop_back();
   }
 }
 
-SourceManager::FileSP SourceManager::SourceFileCache::FindSourceFile(
-    const FileSpec &file_spec) const {
-  FileSP file_sp;
-  FileCache::const_iterator pos = m_file_cache.find(file_spec);
-  if (pos != m_file_cache.end())
-    file_sp = pos->second;
-  return file_sp;
+SourceManager::FileSP
+SourceManager::SourceFileCache::FindSourceFile(const FileSpec &file_spec) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  FileCache::iterator pos = m_file_cache.find(file_spec);
+  if (pos == m_file_cache.end())
+    return FileSP();
+  // Move the entry to the front of the recently used list.
+  m_entries.splice(m_entries.begin(), m_entries, pos->second);
+  return pos->second->file_sp;
 }
@@ -521,6 +521,41 @@ ValueObjectSP ValueObject::GetChildAtIndex(size_t idx, bool can_create) {
   return child_sp;
 }
 
+size_t ValueObject::PrefetchChildren(size_t idx, size_t count) {
+  // Don't let a single request pin an unbounded amount of memory in the
+  // process memory cache.
+  static constexpr uint64_t g_max_prefetch_size = 1024 * 1024;
+
+  if (count == 0 || !UpdateValueIfNeeded(false))
+    return 0;
+  const size_t num_children = GetNumChildren();
+  if (idx >= num_children)
+    return 0;
+  count = std::min(count, num_children - idx);
+
+  uint64_t stride = 0;
+  CompilerType element_type = GetCompilerType().GetArrayElementType(&stride);
+  if (!element_type || stride == 0)
+    return 0;
+  count = std::min<uint64_t>(count, g_max_prefetch_size / stride);
+  if (count == 0)
+    return 0;
+
+  AddressType address_type = eAddressTypeInvalid;
+  const lldb::addr_t address = GetAddressOf(true, &address_type);
+  if (address == LLDB_INVALID_ADDRESS || address_type != eAddressTypeLoad)
+    return 0;
+  ProcessSP process_sp(GetProcessSP());
+  if (!process_sp)
+    return 0;
+
+  DataBufferHeap buffer(count * stride, 0);
+  Status error;
+  const size_t bytes_read = process_sp->ReadMemory(
+      address + idx * stride, buffer.GetBytes(), buffer.GetByteSize(), error);
+  return bytes_read / stride;
+}
+
 lldb::ValueObjectSP
 ValueObject::GetChildAtIndexPath(llvm::ArrayRef<size_t> idxs,
                                  size_t *index_of_error) {
@@ -24,6 +24,14 @@ uint32_t DataVisualization::GetCurrentRevision() {
   return GetFormatManager().GetCurrentRevision();
 }
 
+uint64_t DataVisualization::GetFormatCacheHits() {
+  return GetFormatManager().GetFormatCache().GetCacheHits();
+}
+
+uint64_t DataVisualization::GetFormatCacheMisses() {
+  return GetFormatManager().GetFormatCache().GetCacheMisses();
+}
+
 bool DataVisualization::ShouldPrintAsOneLiner(ValueObject &valobj) {
   return GetFormatManager().ShouldPrintAsOneLiner(valobj);
 }
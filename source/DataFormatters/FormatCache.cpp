@@ -58,25 +58,31 @@ FormatCache::Entry::Entry(lldb::TypeFormatImplSP format_sp,
   SetValidator(validator_sp);
 }
 
-bool FormatCache::Entry::IsFormatCached() { return m_format_cached; }
+bool FormatCache::Entry::IsFormatCached() const { return m_format_cached; }
 
-bool FormatCache::Entry::IsSummaryCached() { return m_summary_cached; }
+bool FormatCache::Entry::IsSummaryCached() const { return m_summary_cached; }
 
-bool FormatCache::Entry::IsSyntheticCached() { return m_synthetic_cached; }
+bool FormatCache::Entry::IsSyntheticCached() const {
+  return m_synthetic_cached;
+}
 
-bool FormatCache::Entry::IsValidatorCached() { return m_validator_cached; }
+bool FormatCache::Entry::IsValidatorCached() const {
+  return m_validator_cached;
+}
 
-lldb::TypeFormatImplSP FormatCache::Entry::GetFormat() { return m_format_sp; }
+lldb::TypeFormatImplSP FormatCache::Entry::GetFormat() const {
+  return m_format_sp;
+}
 
-lldb::TypeSummaryImplSP FormatCache::Entry::GetSummary() {
+lldb::TypeSummaryImplSP FormatCache::Entry::GetSummary() const {
   return m_summary_sp;
 }
 
-lldb::SyntheticChildrenSP FormatCache::Entry::GetSynthetic() {
+lldb::SyntheticChildrenSP FormatCache::Entry::GetSynthetic() const {
   return m_synthetic_sp;
 }
 
-lldb::TypeValidatorImplSP FormatCache::Entry::GetValidator() {
+lldb::TypeValidatorImplSP FormatCache::Entry::GetValidator() const {
   return m_validator_sp;
 }
 
@@ -101,119 +107,100 @@ void FormatCache::Entry::SetValidator(lldb::TypeValidatorImplSP validator_sp) {
 }
 
 FormatCache::FormatCache()
-    : m_map(), m_mutex()
-#ifdef LLDB_CONFIGURATION_DEBUG
-      ,
-      m_cache_hits(0), m_cache_misses(0)
-#endif
-{
-}
+    : m_map(), m_mutex(), m_cache_hits(0), m_cache_misses(0) {}
 
 FormatCache::Entry &FormatCache::GetEntry(ConstString type) {
-  auto i = m_map.find(type), e = m_map.end();
-  if (i != e)
-    return i->second;
-  m_map[type] = FormatCache::Entry();
-  return m_map[type];
+  return m_map[type.GetCString()];
+}
+
+const FormatCache::Entry *FormatCache::FindEntry(ConstString type) const {
+  auto pos = m_map.find(type.GetCString());
+  if (pos == m_map.end())
+    return nullptr;
+  return &pos->second;
 }
 
 bool FormatCache::GetFormat(ConstString type,
                             lldb::TypeFormatImplSP &format_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsFormatCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
+  llvm::sys::SmartScopedReader<false> guard(m_mutex);
+  const Entry *entry = FindEntry(type);
+  if (entry && entry->IsFormatCached()) {
     m_cache_hits++;
-#endif
-    format_sp = entry.GetFormat();
+    format_sp = entry->GetFormat();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   format_sp.reset();
   return false;
 }
 
 bool FormatCache::GetSummary(ConstString type,
                              lldb::TypeSummaryImplSP &summary_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsSummaryCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
+  llvm::sys::SmartScopedReader<false> guard(m_mutex);
+  const Entry *entry = FindEntry(type);
+  if (entry && entry->IsSummaryCached()) {
     m_cache_hits++;
-#endif
-    summary_sp = entry.GetSummary();
+    summary_sp = entry->GetSummary();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   summary_sp.reset();
   return false;
 }
 
 bool FormatCache::GetSynthetic(ConstString type,
                                lldb::SyntheticChildrenSP &synthetic_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsSyntheticCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
+  llvm::sys::SmartScopedReader<false> guard(m_mutex);
+  const Entry *entry = FindEntry(type);
+  if (entry && entry->IsSyntheticCached()) {
     m_cache_hits++;
-#endif
-    synthetic_sp = entry.GetSynthetic();
+    synthetic_sp = entry->GetSynthetic();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   synthetic_sp.reset();
   return false;
 }
 
 bool FormatCache::GetValidator(ConstString type,
                                lldb::TypeValidatorImplSP &validator_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsValidatorCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
+  llvm::sys::SmartScopedReader<false> guard(m_mutex);
+  const Entry *entry = FindEntry(type);
+  if (entry && entry->IsValidatorCached()) {
     m_cache_hits++;
-#endif
-    validator_sp = entry.GetValidator();
+    validator_sp = entry->GetValidator();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   validator_sp.reset();
   return false;
 }
 
 void FormatCache::SetFormat(ConstString type,
                             lldb::TypeFormatImplSP &format_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  llvm::sys::SmartScopedWriter<false> guard(m_mutex);
   GetEntry(type).SetFormat(format_sp);
 }
 
 void FormatCache::SetSummary(ConstString type,
                              lldb::TypeSummaryImplSP &summary_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  llvm::sys::SmartScopedWriter<false> guard(m_mutex);
   GetEntry(type).SetSummary(summary_sp);
 }
 
 void FormatCache::SetSynthetic(ConstString type,
                                lldb::SyntheticChildrenSP &synthetic_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  llvm::sys::SmartScopedWriter<false> guard(m_mutex);
   GetEntry(type).SetSynthetic(synthetic_sp);
 }
 
 void FormatCache::SetValidator(ConstString type,
                                lldb::TypeValidatorImplSP &validator_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  llvm::sys::SmartScopedWriter<false> guard(m_mutex);
   GetEntry(type).SetValidator(validator_sp);
 }
 
 void FormatCache::Clear() {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  llvm::sys::SmartScopedWriter<false> guard(m_mutex);
   m_map.clear();
 }
@@ -22,9 +22,8 @@ FormattersMatchData::FormattersMatchData(ValueObject &valobj,
                                          lldb::DynamicValueType use_dynamic)
     : m_valobj(valobj), m_dynamic_value_type(use_dynamic),
       m_formatters_match_vector({}, false), m_type_for_cache(),
-      m_candidate_languages() {
+      m_candidate_languages({}, false) {
   m_type_for_cache = FormatManager::GetTypeForCache(valobj, use_dynamic);
-  m_candidate_languages = FormatManager::GetCandidateLanguages(valobj);
 }
 
 FormattersMatchVector FormattersMatchData::GetMatchesVector() {
@@ -39,7 +38,13 @@ FormattersMatchVector FormattersMatchData::GetMatchesVector() {
 ConstString FormattersMatchData::GetTypeForCache() { return m_type_for_cache; }
 
 CandidateLanguagesVector FormattersMatchData::GetCandidateLanguages() {
-  return m_candidate_languages;
+  // Computing the runtime language of the value is not free, and it is not
+  // needed at all when the formatter comes out of the cache.
+  if (!m_candidate_languages.second) {
+    m_candidate_languages.second = true;
+    m_candidate_languages.first = FormatManager::GetCandidateLanguages(m_valobj);
+  }
+  return m_candidate_languages.first;
 }
 
 ValueObject &FormattersMatchData::GetValueObject() { return m_valobj; }
@@ -690,6 +690,9 @@ void ValueObjectPrinter::PrintChildren(
   if (num_children) {
     bool any_children_printed = false;
 
+    if (!m_options.m_pointer_as_array)
+      synth_m_valobj->PrefetchChildren(0, num_children);
+
     for (size_t idx = 0; idx < num_children; ++idx) {
       if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx)) {
         if (!any_children_printed) {
@@ -0,0 +1,126 @@
+//===-- ExpressionCache.cpp -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/ExpressionCache.h"
+#include "lldb/Expression/UserExpression.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+
+#include <iterator>
+#include <tuple>
+
+using namespace lldb;
+using namespace lldb_private;
+
+bool ExpressionCache::Key::operator<(const Key &rhs) const {
+  return std::tie(expr, prefix, language, desired_type, execution_policy,
+                  use_dynamic, generate_debug_info, block, pc) <
+         std::tie(rhs.expr, rhs.prefix, rhs.language, rhs.desired_type,
+                  rhs.execution_policy, rhs.use_dynamic,
+                  rhs.generate_debug_info, rhs.block, rhs.pc);
+}
+
+bool ExpressionCache::MakeKey(ExecutionContext &exe_ctx, llvm::StringRef expr,
+                              llvm::StringRef prefix, LanguageType language,
+                              Expression::ResultType desired_type,
+                              ExecutionPolicy execution_policy,
+                              const EvaluateExpressionOptions &options,
+                              Key &key) {
+  Target *target = exe_ctx.GetTargetPtr();
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  if (!target || !frame || !exe_ctx.GetProcessPtr())
+    return false;
+
+  // Swift expressions hold the scratch context lock for as long as they
+  // live, so keeping them around would block the context from being reset.
+  if (language == eLanguageTypeSwift)
+    return false;
+
+  // Expressions that declare or use persistent variables register them while
+  // parsing, and top level expressions only exist for their side effects.
+  if (expr.contains('$') || prefix.contains('$') ||
+      execution_policy == eExecutionPolicyTopLevel)
+    return false;
+
+  if (options.GetREPLEnabled() || options.GetPlaygroundTransformEnabled() ||
+      options.GetPoundLineFilePath())
+    return false;
+
+  key.expr = expr;
+  key.prefix = prefix;
+  key.language = language;
+  key.desired_type = desired_type;
+  key.execution_policy = execution_policy;
+  key.use_dynamic = options.GetUseDynamic();
+  key.generate_debug_info = options.GetGenerateDebugInfo();
+  key.block = frame->GetSymbolContext(eSymbolContextBlock).block;
+  key.pc = key.block ? LLDB_INVALID_ADDRESS
+                     : frame->GetFrameCodeAddress().GetLoadAddress(target);
+  return true;
+}
+
+UserExpressionSP ExpressionCache::Take(const Key &key,
+                                       ExecutionContext &exe_ctx) {
+  UserExpressionSP expr_sp;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto pos = m_map.find(key);
+    if (pos == m_map.end())
+      return UserExpressionSP();
+    expr_sp = pos->second->second;
+    m_entries.erase(pos->second);
+    m_map.erase(pos);
+  }
+
+  // An expression compiled for a process that has since gone away, or for a
+  // different block, is of no further use.
+  if (!expr_sp->MatchesContext(exe_ctx))
+    return UserExpressionSP();
+  return expr_sp;
+}
+
+void ExpressionCache::Insert(const Key &key, const UserExpressionSP &expr_sp,
+                             size_t max_size) {
+  // Release the expressions outside of the lock; destroying them frees JIT
+  // memory in the inferior.
+  EntryList evicted;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto pos = m_map.find(key);
+    if (pos != m_map.end()) {
+      evicted.splice(evicted.end(), m_entries, pos->second);
+      m_map.erase(pos);
+    }
+    if (max_size == 0)
+      return;
+
+    expr_sp->SetMatchAnyAddressInBlock(true);
+    m_entries.emplace_front(key, expr_sp);
+    m_map[key] = m_entries.begin();
+    while (m_entries.size() > max_size) {
+      m_map.erase(m_entries.back().first);
+      evicted.splice(evicted.end(), m_entries, std::prev(m_entries.end()));
+    }
+  }
+}
+
+void ExpressionCache::Clear() {
+  EntryList evicted;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_map.clear();
+    evicted.swap(m_entries);
+  }
+}
+
+size_t ExpressionCache::GetSize() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_entries.size();
+}
@@ -28,6 +28,8 @@
 #include "lldb/Target/ThreadPlan.h"
 #include "lldb/Target/ThreadPlanCallFunctionUsingABI.h"
 
+#include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/APSInt.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Function.h"
@@ -40,6 +42,8 @@
 
 #include <map>
 
+#include <string.h>
+
 using namespace llvm;
 
 static std::string PrintValue(const Value *value, bool truncate = false) {
@@ -88,6 +92,24 @@ static bool CanIgnoreCall(const CallInst *call) {
   return false;
 }
 
+// Intrinsics that only touch memory, which the interpreter can perform
+// itself instead of calling into the inferior.
+static bool IsMemoryIntrinsic(const CallInst *call) {
+  const llvm::Function *called_function = call->getCalledFunction();
+
+  if (!called_function || !called_function->isIntrinsic())
+    return false;
+
+  switch (called_function->getIntrinsicID()) {
+  default:
+    return false;
+  case llvm::Intrinsic::memcpy:
+  case llvm::Intrinsic::memmove:
+  case llvm::Intrinsic::memset:
+    return true;
+  }
+}
+
 class InterpreterStackFrame {
 public:
   typedef std::map<const Value *, lldb::addr_t> ValueMap;
@@ -196,6 +218,29 @@ public:
     return false;
   }
 
+  bool EvaluateFloat(APFloat &apfloat, const Value *value, Module &module) {
+    Type *type = value->getType();
+
+    if (!type->isFloatingPointTy() || type->getPrimitiveSizeInBits() > 64)
+      return false;
+
+    lldb_private::Scalar scalar;
+
+    if (!EvaluateValue(scalar, value, module))
+      return false;
+
+    apfloat = APFloat(type->getFltSemantics(),
+                      APInt(type->getPrimitiveSizeInBits(), scalar.ULongLong()));
+    return true;
+  }
+
+  bool AssignFloat(const Value *value, const APFloat &apfloat,
+                   Module &module) {
+    lldb_private::Scalar scalar(
+        (unsigned long long)apfloat.bitcastToAPInt().getZExtValue());
+    return AssignValue(value, scalar, module);
+  }
+
   bool AssignValue(const Value *value, lldb_private::Scalar &scalar,
                    Module &module) {
     lldb::addr_t process_address = ResolveValue(value, module);
@@ -447,6 +492,10 @@ static const char *infinite_loop_error = "Interpreter ran for too many cycles";
 static const char *too_many_functions_error =
     "Interpreter doesn't handle modules with multiple function bodies.";
 
+// Larger copies are almost certainly the result of a bad length; let the
+// JIT (and the inferior) deal with them.
+static const uint64_t max_memory_intrinsic_size = 1024 * 1024;
+
 static bool CanResolveConstant(llvm::Constant *constant) {
   switch (constant->getValueID()) {
   default:
@@ -530,7 +579,8 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
           return false;
         }
 
-        if (!CanIgnoreCall(call_inst) && !support_function_calls) {
+        if (!CanIgnoreCall(call_inst) && !IsMemoryIntrinsic(call_inst) &&
+            !support_function_calls) {
           if (log)
             log->Printf("Unsupported instruction: %s",
                         PrintValue(&*ii).c_str());
@@ -575,6 +625,16 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
       } break;
       case Instruction::And:
       case Instruction::AShr:
+      case Instruction::FAdd:
+      case Instruction::FCmp:
+      case Instruction::FDiv:
+      case Instruction::FMul:
+      case Instruction::FPExt:
+      case Instruction::FPToSI:
+      case Instruction::FPToUI:
+      case Instruction::FPTrunc:
+      case Instruction::FRem:
+      case Instruction::FSub:
       case Instruction::IntToPtr:
       case Instruction::PtrToInt:
       case Instruction::Load:
@@ -583,13 +643,17 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
       case Instruction::Or:
       case Instruction::Ret:
       case Instruction::SDiv:
+      case Instruction::Select:
       case Instruction::SExt:
       case Instruction::Shl:
+      case Instruction::SIToFP:
       case Instruction::SRem:
       case Instruction::Store:
       case Instruction::Sub:
+      case Instruction::Switch:
       case Instruction::Trunc:
       case Instruction::UDiv:
+      case Instruction::UIToFP:
       case Instruction::URem:
       case Instruction::Xor:
       case Instruction::ZExt:
@@ -1197,6 +1261,308 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
         log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
       }
     } break;
+    case Instruction::FAdd:
+    case Instruction::FSub:
+    case Instruction::FMul:
+    case Instruction::FDiv:
+    case Instruction::FRem: {
+      Value *lhs = inst->getOperand(0);
+      Value *rhs = inst->getOperand(1);
+
+      APFloat L(0.0);
+      APFloat R(0.0);
+
+      if (!frame.EvaluateFloat(L, lhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (!frame.EvaluateFloat(R, rhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      APFloat result = L;
+
+      switch (inst->getOpcode()) {
+      default:
+        break;
+      case Instruction::FAdd:
+        result.add(R, APFloat::rmNearestTiesToEven);
+        break;
+      case Instruction::FSub:
+        result.subtract(R, APFloat::rmNearestTiesToEven);
+        break;
+      case Instruction::FMul:
+        result.multiply(R, APFloat::rmNearestTiesToEven);
+        break;
+      case Instruction::FDiv:
+        result.divide(R, APFloat::rmNearestTiesToEven);
+        break;
+      case Instruction::FRem:
+        // LLVM's frem has the semantics of C's fmod.
+        result.mod(R);
+        break;
+      }
+
+      frame.AssignFloat(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+        log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+        log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::FCmp: {
+      const FCmpInst *fcmp_inst = dyn_cast<FCmpInst>(inst);
+
+      if (!fcmp_inst) {
+        if (log)
+          log->Printf(
+              "getOpcode() returns FCmp, but instruction is not an FCmpInst");
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      }
+
+      Value *lhs = inst->getOperand(0);
+      Value *rhs = inst->getOperand(1);
+
+      APFloat L(0.0);
+      APFloat R(0.0);
+
+      if (!frame.EvaluateFloat(L, lhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (!frame.EvaluateFloat(R, rhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      // The predicates are a bit mask of the outcomes they accept, in the
+      // order unordered, less than, greater than, equal (LSB is equal).
+      const APFloat::cmpResult cmp = L.compare(R);
+      unsigned outcome = 0;
+      switch (cmp) {
+      case APFloat::cmpEqual:
+        outcome = CmpInst::FCMP_OEQ;
+        break;
+      case APFloat::cmpGreaterThan:
+        outcome = CmpInst::FCMP_OGT;
+        break;
+      case APFloat::cmpLessThan:
+        outcome = CmpInst::FCMP_OLT;
+        break;
+      case APFloat::cmpUnordered:
+        outcome = CmpInst::FCMP_UNO;
+        break;
+      }
+
+      lldb_private::Scalar result =
+          (fcmp_inst->getPredicate() & outcome) != 0;
+
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted an FCmpInst");
+        log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+        log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+        log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::FPExt:
+    case Instruction::FPTrunc: {
+      Value *src_operand = inst->getOperand(0);
+
+      APFloat F(0.0);
+
+      if (!frame.EvaluateFloat(F, src_operand, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(src_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      bool loses_info;
+      F.convert(inst->getType()->getFltSemantics(),
+                APFloat::rmNearestTiesToEven, &loses_info);
+
+      frame.AssignFloat(inst, F, module);
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  Src : %s", frame.SummarizeValue(src_operand).c_str());
+        log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::SIToFP:
+    case Instruction::UIToFP: {
+      Value *src_operand = inst->getOperand(0);
+
+      lldb_private::Scalar I;
+
+      if (!frame.EvaluateValue(I, src_operand, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(src_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      Type *dst_ty = inst->getType();
+      if (!dst_ty->isFloatingPointTy()) {
+        error.SetErrorToGenericError();
+        error.SetErrorString(unsupported_operand_error);
+        return false;
+      }
+
+      APFloat F(dst_ty->getFltSemantics());
+      F.convertFromAPInt(APInt(src_operand->getType()->getIntegerBitWidth(),
+                               I.ULongLong()),
+                         inst->getOpcode() == Instruction::SIToFP,
+                         APFloat::rmNearestTiesToEven);
+
+      frame.AssignFloat(inst, F, module);
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  Src : %s", frame.SummarizeValue(src_operand).c_str());
+        log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::FPToSI:
+    case Instruction::FPToUI: {
+      Value *src_operand = inst->getOperand(0);
+
+      APFloat F(0.0);
+
+      if (!frame.EvaluateFloat(F, src_operand, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(src_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      APSInt I(inst->getType()->getIntegerBitWidth(),
+               inst->getOpcode() == Instruction::FPToUI);
+      bool is_exact;
+      F.convertToInteger(I, APFloat::rmTowardZero, &is_exact);
+
+      lldb_private::Scalar result((unsigned long long)I.getZExtValue());
+
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  Src : %s", frame.SummarizeValue(src_operand).c_str());
+        log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::Select: {
+      const SelectInst *select_inst = dyn_cast<SelectInst>(inst);
+
+      if (!select_inst) {
+        if (log)
+          log->Printf("getOpcode() returns Select, but instruction is not a "
+                      "SelectInst");
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      }
+
+      const Value *condition = select_inst->getCondition();
+
+      lldb_private::Scalar C;
+
+      if (!frame.EvaluateValue(C, condition, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const Value *value =
+          C.IsZero() ? select_inst->getFalseValue() : select_inst->getTrueValue();
+
+      lldb_private::Scalar result;
+
+      if (!frame.EvaluateValue(result, value, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(value).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted a SelectInst");
+        log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+        log->Printf("  =    : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::Switch: {
+      const SwitchInst *switch_inst = dyn_cast<SwitchInst>(inst);
+
+      if (!switch_inst) {
+        if (log)
+          log->Printf("getOpcode() returns Switch, but instruction is not a "
+                      "SwitchInst");
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      }
+
+      const Value *condition = switch_inst->getCondition();
+
+      lldb_private::Scalar C;
+
+      if (!frame.EvaluateValue(C, condition, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const APInt value(condition->getType()->getIntegerBitWidth(),
+                        C.ULongLong());
+
+      const BasicBlock *successor = switch_inst->getDefaultDest();
+      for (auto switch_case : switch_inst->cases()) {
+        if (switch_case.getCaseValue()->getValue() == value) {
+          successor = switch_case.getCaseSuccessor();
+          break;
+        }
+      }
+
+      frame.Jump(successor);
+
+      if (log) {
+        log->Printf("Interpreted a SwitchInst");
+        log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+      }
+    }
+      continue;
     case Instruction::IntToPtr: {
       const IntToPtrInst *int_to_ptr_inst = dyn_cast<IntToPtrInst>(inst);
 
@@ -1496,6 +1862,75 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
       if (CanIgnoreCall(call_inst))
         break;
 
+      if (IsMemoryIntrinsic(call_inst)) {
+        // memcpy/memmove(dst, src, len, isvolatile) and
+        // memset(dst, val, len, isvolatile)
+        lldb_private::Scalar dst;
+        lldb_private::Scalar src_or_val;
+        lldb_private::Scalar len;
+
+        if (!frame.EvaluateValue(dst, call_inst->getArgOperand(0), module) ||
+            !frame.EvaluateValue(src_or_val, call_inst->getArgOperand(1),
+                                 module) ||
+            !frame.EvaluateValue(len, call_inst->getArgOperand(2), module)) {
+          if (log)
+            log->Printf("Couldn't evaluate the arguments of %s",
+                        PrintValue(call_inst).c_str());
+          error.SetErrorToGenericError();
+          error.SetErrorString(bad_value_error);
+          return false;
+        }
+
+        const uint64_t size = len.ULongLong();
+        if (size > max_memory_intrinsic_size) {
+          if (log)
+            log->Printf("Refusing to interpret a %" PRIu64
+                        " byte memory intrinsic",
+                        size);
+          error.SetErrorToGenericError();
+          error.SetErrorString(memory_allocation_error);
+          return false;
+        }
+
+        lldb_private::DataBufferHeap buffer(size, 0);
+        if (call_inst->getCalledFunction()->getIntrinsicID() ==
+            llvm::Intrinsic::memset) {
+          ::memset(buffer.GetBytes(), (uint8_t)src_or_val.UInt(), size);
+        } else {
+          lldb_private::Status read_error;
+          execution_unit.ReadMemory(buffer.GetBytes(), src_or_val.ULongLong(),
+                                    size, read_error);
+          if (!read_error.Success()) {
+            if (log)
+              log->Printf("Couldn't read from a region on behalf of %s",
+                          PrintValue(call_inst).c_str());
+            error.SetErrorToGenericError();
+            error.SetErrorString(memory_read_error);
+            return false;
+          }
+        }
+
+        lldb_private::Status write_error;
+        execution_unit.WriteMemory(dst.ULongLong(), buffer.GetBytes(), size,
+                                   write_error);
+        if (!write_error.Success()) {
+          if (log)
+            log->Printf("Couldn't write to a region on behalf of %s",
+                        PrintValue(call_inst).c_str());
+          error.SetErrorToGenericError();
+          error.SetErrorString(memory_write_error);
+          return false;
+        }
+
+        if (log) {
+          log->Printf("Interpreted a %s",
+                      call_inst->getCalledFunction()->getName().str().c_str());
+          log->Printf("  dst : 0x%" PRIx64, dst.ULongLong());
+          log->Printf("  len : %" PRIu64, size);
+        }
+        break;
+      }
+
       // Get the return type
       llvm::Type *returnType = call_inst->getType();
       if (returnType == nullptr) {
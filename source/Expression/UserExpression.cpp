@@ -19,6 +19,7 @@
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/Expression/DiagnosticManager.h"
+#include "lldb/Expression/ExpressionCache.h"
 #include "lldb/Expression/ExpressionSourceCode.h"
 #include "lldb/Expression/ExpressionVariable.h"
 #include "lldb/Expression/IRExecutionUnit.h"
@@ -60,8 +61,10 @@ void UserExpression::InstallContext(ExecutionContext &exe_ctx) {
 
   lldb::StackFrameSP frame_sp = exe_ctx.GetFrameSP();
 
-  if (frame_sp)
+  if (frame_sp) {
     m_address = frame_sp->GetFrameCodeAddress();
+    m_block = frame_sp->GetSymbolContext(lldb::eSymbolContextBlock).block;
+  }
 }
 
 bool UserExpression::LockAndCheckContext(ExecutionContext &exe_ctx,
@@ -81,10 +84,17 @@ bool UserExpression::LockAndCheckContext(ExecutionContext &exe_ctx,
   if (m_address.IsValid()) {
     if (!frame_sp)
       return false;
-    else
-      return (0 == Address::CompareLoadAddress(m_address,
-                                               frame_sp->GetFrameCodeAddress(),
-                                               target_sp.get()));
+    if (0 == Address::CompareLoadAddress(m_address,
+                                         frame_sp->GetFrameCodeAddress(),
+                                         target_sp.get()))
+      return true;
+    // The same names are visible everywhere in a lexical block, so a cached
+    // expression can run anywhere in the block it was parsed in, as long as
+    // the frame still has what the parse found at the original pc.
+    if (m_match_any_address_in_block && m_block &&
+        frame_sp->GetSymbolContext(lldb::eSymbolContextBlock).block == m_block)
+      return ContextIsValidForFrame(*frame_sp);
+    return false;
   }
 
   return true;
@@ -216,19 +226,43 @@ lldb::ExpressionResults UserExpression::Evaluate(
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(exe_ctx, expr, full_prefix, language,
-                                           desired_type, options, error));
-  if (error.Fail()) {
-    if (log)
-      log->Printf("== [UserExpression::Evaluate] Getting expression: %s ==",
-                  error.AsCString());
-    return lldb::eExpressionSetupError;
+  // Look for an already compiled copy of this expression before parsing.
+  ExpressionCache::Key cache_key;
+  const size_t cache_size = target->GetExpressionCacheSize();
+  const bool use_cache =
+      cache_size &&
+      ExpressionCache::MakeKey(exe_ctx, expr, full_prefix, language,
+                               desired_type, execution_policy, options,
+                               cache_key);
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (use_cache) {
+    user_expression_sp = target->GetExpressionCache().Take(cache_key, exe_ctx);
+    target->IncrementStats(user_expression_sp
+                               ? StatisticKind::ExpressionCacheHit
+                               : StatisticKind::ExpressionCacheMiss);
   }
+  const bool from_cache = (bool)user_expression_sp;
 
-  if (log)
-    log->Printf("== [UserExpression::Evaluate] Parsing expression %s ==",
-                expr.str().c_str());
+  if (from_cache) {
+    if (log)
+      log->Printf("== [UserExpression::Evaluate] Reusing compiled expression "
+                  "%s ==",
+                  expr.str().c_str());
+  } else {
+    user_expression_sp = target->GetUserExpressionForLanguage(
+        exe_ctx, expr, full_prefix, language, desired_type, options, error);
+    if (error.Fail()) {
+      if (log)
+        log->Printf("== [UserExpression::Evaluate] Getting expression: %s ==",
+                    error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+
+    if (log)
+      log->Printf("== [UserExpression::Evaluate] Parsing expression %s ==",
+                  expr.str().c_str());
+  }
 
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
@@ -243,6 +277,7 @@ lldb::ExpressionResults UserExpression::Evaluate(
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      from_cache ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -366,6 +401,14 @@ lldb::ExpressionResults UserExpression::Evaluate(
 
           error.SetError(UserExpression::kNoResult, lldb::eErrorTypeGeneric);
         }
+
+        // Only cache what was parsed from the text the key was made from,
+        // not a fixed-up version of it.
+        if (use_cache &&
+            user_expression_sp->Language() != lldb::eLanguageTypeSwift &&
+            llvm::StringRef(user_expression_sp->GetUserText()) == expr)
+          target->GetExpressionCache().Insert(cache_key, user_expression_sp,
+                                              cache_size);
       }
     }
   }
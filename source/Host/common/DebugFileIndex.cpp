@@ -0,0 +1,240 @@
+//===-- DebugFileIndex.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/DebugFileIndex.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <map>
+#include <memory>
+
+using namespace lldb_private;
+
+// Bump this whenever the file format changes.
+static const char g_magic[] = "lldb-debug-file-index 1";
+static const char g_file_name[] = "debug-file-index";
+
+// How long a listing is trusted before the modification time of its
+// directory is checked again.
+static const std::chrono::seconds g_revalidate_interval(1);
+
+std::atomic<uint64_t> DebugFileIndex::g_lookups_avoided(0);
+std::atomic<uint64_t> DebugFileIndex::g_directories_scanned(0);
+
+namespace {
+struct OpenIndexes {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<DebugFileIndex>> indexes;
+};
+} // namespace
+
+static OpenIndexes &GetOpenIndexes() {
+  static OpenIndexes *g_open_indexes = new OpenIndexes();
+  return *g_open_indexes;
+}
+
+DebugFileIndex &DebugFileIndex::Get(const FileSpec &cache_dir) {
+  OpenIndexes &open_indexes = GetOpenIndexes();
+  std::lock_guard<std::mutex> guard(open_indexes.mutex);
+  std::unique_ptr<DebugFileIndex> &index =
+      open_indexes.indexes[cache_dir.GetPath()];
+  if (!index)
+    index.reset(new DebugFileIndex(cache_dir));
+  return *index;
+}
+
+void DebugFileIndex::SaveAll() {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_HOST));
+  OpenIndexes &open_indexes = GetOpenIndexes();
+  std::lock_guard<std::mutex> guard(open_indexes.mutex);
+  for (const auto &entry : open_indexes.indexes) {
+    Status error = entry.second->Save();
+    if (error.Fail())
+      LLDB_LOG(log, "couldn't save debug file index: {0}", error);
+  }
+}
+
+static FileSpec GetIndexFileSpec(const FileSpec &cache_dir) {
+  if (!cache_dir)
+    return FileSpec();
+  FileSpec file_spec = cache_dir;
+  file_spec.AppendPathComponent(g_file_name);
+  return file_spec;
+}
+
+DebugFileIndex::DebugFileIndex(const FileSpec &cache_dir)
+    : m_cache_dir(cache_dir), m_file_spec(GetIndexFileSpec(cache_dir)) {}
+
+const DebugFileIndex::Directory &
+DebugFileIndex::GetDirectory(llvm::StringRef path) {
+  if (!m_loaded) {
+    m_loaded = true;
+    Load();
+  }
+
+  Directory &dir = m_directories[path];
+  const Clock::time_point now = Clock::now();
+  if (now - dir.validated < g_revalidate_interval)
+    return dir;
+  dir.validated = now;
+
+  llvm::sys::fs::file_status status;
+  const bool exists = !llvm::sys::fs::status(path, status) &&
+                      status.type() == llvm::sys::fs::file_type::directory_file;
+  const int64_t mtime =
+      exists ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   status.getLastModificationTime().time_since_epoch())
+                   .count()
+             : 0;
+  if (exists == dir.exists && mtime == dir.mtime)
+    return dir;
+
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_HOST));
+  LLDB_LOG(log, "listing debug file directory {0}", path);
+  ++g_directories_scanned;
+  m_dirty = true;
+  dir.exists = exists;
+  dir.mtime = mtime;
+  dir.entries.clear();
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(path, ec), end; it != end && !ec;
+       it.increment(ec))
+    dir.entries.insert(llvm::sys::path::filename(it->path()));
+  return dir;
+}
+
+bool DebugFileIndex::MayExist(llvm::StringRef path) {
+  llvm::StringRef parent = llvm::sys::path::parent_path(path);
+  if (parent.empty())
+    return true;
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const Directory &dir = GetDirectory(parent);
+  if (dir.exists && dir.entries.count(llvm::sys::path::filename(path)))
+    return true;
+  ++g_lookups_avoided;
+  return false;
+}
+
+bool DebugFileIndex::IsDirectory(llvm::StringRef path) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return GetDirectory(path).exists;
+}
+
+void DebugFileIndex::Load() {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_HOST));
+  if (!m_file_spec)
+    return;
+
+  const std::string path = m_file_spec.GetPath();
+  auto buffer_or_error = llvm::MemoryBuffer::getFile(path);
+  if (!buffer_or_error)
+    return;
+
+  llvm::StringRef contents = (*buffer_or_error)->getBuffer();
+  llvm::StringRef line;
+  std::tie(line, contents) = contents.split('\n');
+  if (line != g_magic) {
+    LLDB_LOG(log, "ignoring debug file index {0}: unknown format", path);
+    return;
+  }
+
+  // Listings start out unvalidated, so each directory is compared to the
+  // file system once before its listing is used.
+  Directory *dir = nullptr;
+  while (!contents.empty()) {
+    std::tie(line, contents) = contents.split('\n');
+    llvm::StringRef kind, rest;
+    std::tie(kind, rest) = line.split(' ');
+    if (kind == "d") {
+      llvm::StringRef mtime_str, dir_path;
+      std::tie(mtime_str, dir_path) = rest.split(' ');
+      int64_t mtime;
+      if (mtime_str.getAsInteger(10, mtime) || dir_path.empty()) {
+        LLDB_LOG(log, "ignoring debug file index {0}: malformed entry", path);
+        m_directories.clear();
+        return;
+      }
+      dir = &m_directories[dir_path];
+      dir->exists = true;
+      dir->mtime = mtime;
+    } else if (kind == "e" && dir) {
+      dir->entries.insert(rest);
+    } else if (!kind.empty()) {
+      LLDB_LOG(log, "ignoring debug file index {0}: malformed entry", path);
+      m_directories.clear();
+      return;
+    }
+  }
+
+  LLDB_LOG(log, "loaded debug file index {0}: {1} directories", path,
+           m_directories.size());
+}
+
+Status DebugFileIndex::Save() {
+  Status error;
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (!m_dirty || !m_file_spec)
+    return error;
+
+  const std::string path = m_file_spec.GetPath();
+  if (std::error_code ec =
+          llvm::sys::fs::create_directories(m_cache_dir.GetPath())) {
+    error.SetErrorStringWithFormat("couldn't create %s: %s",
+                                   m_cache_dir.GetPath().c_str(),
+                                   ec.message().c_str());
+    return error;
+  }
+
+  // Write a temporary file and rename it over the index so that concurrent
+  // debuggers never read a partially written index.
+  int fd;
+  llvm::SmallString<128> temp_path;
+  if (std::error_code ec =
+          llvm::sys::fs::createUniqueFile(path + "-%%%%%%", fd, temp_path)) {
+    error.SetErrorStringWithFormat("couldn't create a temporary file for %s: "
+                                   "%s",
+                                   path.c_str(), ec.message().c_str());
+    return error;
+  }
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << g_magic << '\n';
+    for (const auto &dir : m_directories) {
+      // Missing directories are cheap to check again.
+      if (!dir.second.exists)
+        continue;
+      os << "d " << dir.second.mtime << ' ' << dir.first() << '\n';
+      for (const auto &entry : dir.second.entries)
+        os << "e " << entry.first() << '\n';
+    }
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      error.SetErrorStringWithFormat("couldn't write %s", path.c_str());
+      return error;
+    }
+  }
+
+  if (std::error_code ec = llvm::sys::fs::rename(temp_path, path)) {
+    llvm::sys::fs::remove(temp_path);
+    error.SetErrorStringWithFormat("couldn't write %s: %s", path.c_str(),
+                                   ec.message().c_str());
+    return error;
+  }
+  m_dirty = false;
+  return error;
+}
@@ -11,8 +11,10 @@
 #include "lldb/Host/common/NativeBreakpointList.h"
 #include "lldb/Host/common/NativeRegisterContext.h"
 #include "lldb/Host/common/NativeThreadProtocol.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/RegisterValue.h"
 #include "lldb/Utility/State.h"
 #include "lldb/lldb-enumerations.h"
 
@@ -633,6 +635,92 @@ Status NativeProcessProtocol::RemoveBreakpoint(lldb::addr_t addr,
     return RemoveSoftwareBreakpoint(addr);
 }
 
+Status NativeProcessProtocol::SetBreakpointConditions(
+    lldb::addr_t addr, std::vector<AgentExpression> conditions) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  LLDB_LOG(log, "addr = {0:x}, {1} conditions", addr, conditions.size());
+
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+  it->second.conditions = std::move(conditions);
+  return Status();
+}
+
+bool NativeProcessProtocol::ShouldReportBreakpointHit(
+    NativeThreadProtocol &thread, lldb::addr_t addr) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || it->second.conditions.empty())
+    return true;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  NativeRegisterContext &context = thread.GetRegisterContext();
+
+  auto read_register = [&](uint32_t regnum) -> llvm::Optional<uint64_t> {
+    const RegisterInfo *reg_info = context.GetRegisterInfoAtIndex(regnum);
+    if (!reg_info)
+      return llvm::None;
+    RegisterValue reg_value;
+    if (context.ReadRegister(reg_info, reg_value).Fail())
+      return llvm::None;
+    bool success = false;
+    const uint64_t value = reg_value.GetAsUInt64(0, &success);
+    if (!success)
+      return llvm::None;
+    return value;
+  };
+
+  auto read_memory = [&](lldb::addr_t load_addr,
+                         size_t size) -> llvm::Optional<uint64_t> {
+    uint8_t buffer[8];
+    size_t bytes_read = 0;
+    if (ReadMemoryWithoutTrap(load_addr, buffer, size, bytes_read).Fail() ||
+        bytes_read != size)
+      return llvm::None;
+    DataExtractor data(buffer, size, GetByteOrder(),
+                       GetArchitecture().GetAddressByteSize());
+    lldb::offset_t offset = 0;
+    return data.GetMaxU64(&offset, size);
+  };
+
+  for (const AgentExpression &condition : it->second.conditions) {
+    llvm::Expected<uint64_t> result =
+        condition.Evaluate(read_register, read_memory);
+    if (!result) {
+      LLDB_LOG(log, "pid {0} tid {1}: breakpoint at {2:x}: {3}", GetID(),
+               thread.GetID(), addr, llvm::toString(result.takeError()));
+      return true;
+    }
+    if (*result != 0)
+      return true;
+  }
+
+  LLDB_LOG(log, "pid {0} tid {1}: conditions at {2:x} are false", GetID(),
+           thread.GetID(), addr);
+  return false;
+}
+
+Status NativeProcessProtocol::WriteSoftwareBreakpointOpcodes(lldb::addr_t addr,
+                                                             bool trap) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+
+  llvm::ArrayRef<uint8_t> opcodes =
+      trap ? it->second.breakpoint_opcodes
+           : llvm::makeArrayRef(it->second.saved_opcodes);
+  size_t bytes_written = 0;
+  Status error = WriteMemory(addr, opcodes.data(), opcodes.size(),
+                             bytes_written);
+  if (error.Fail())
+    return error;
+  if (bytes_written != opcodes.size())
+    return Status("addr=0x%" PRIx64
+                  ": tried to write %zu bytes but only wrote %zu",
+                  addr, opcodes.size(), bytes_written);
+  return Status();
+}
+
 Status NativeProcessProtocol::ReadMemoryWithoutTrap(lldb::addr_t addr,
                                                     void *buf, size_t size,
                                                     size_t &bytes_read) {
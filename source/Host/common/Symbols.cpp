@@ -7,7 +7,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Host/Symbols.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/DebugFileIndex.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/Target.h"
@@ -311,11 +313,16 @@ FileSpec Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec) {
       uuid_str = uuid_str + ".debug";
     }
 
+    // Candidates that aren't listed in their directory are rejected without
+    // a stat each.
+    DebugFileIndex &index = DebugFileIndex::Get(
+        ModuleList::GetGlobalModuleListProperties().GetDebugFileIndexPath());
+
     size_t num_directories = debug_file_search_paths.GetSize();
     for (size_t idx = 0; idx < num_directories; ++idx) {
       FileSpec dirspec = debug_file_search_paths.GetFileSpecAtIndex(idx);
       FileSystem::Instance().Resolve(dirspec);
-      if (!FileSystem::Instance().IsDirectory(dirspec))
+      if (!index.IsDirectory(dirspec.GetPath()))
         continue;
 
       std::vector<std::string> files;
@@ -336,6 +343,9 @@ FileSpec Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec) {
         FileSpec file_spec(filename);
         FileSystem::Instance().Resolve(file_spec);
 
+        if (!index.MayExist(file_spec.GetPath()))
+          continue;
+
         if (llvm::sys::fs::equivalent(file_spec.GetPath(),
                                       module_file_spec.GetPath()))
           continue;
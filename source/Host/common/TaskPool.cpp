@@ -9,6 +9,7 @@
 #include "lldb/Host/TaskPool.h"
 #include "lldb/Host/ThreadLauncher.h"
 
+#include <condition_variable>
 #include <cstdint>
 #include <queue>
 #include <thread>
@@ -37,8 +38,11 @@ private:
 } // end of anonymous namespace
 
 TaskPoolImpl &TaskPoolImpl::GetInstance() {
-  static TaskPoolImpl g_task_pool_impl;
-  return g_task_pool_impl;
+  // Leaked on purpose: TaskMapOverInt can leave tasks that have nothing left
+  // to do in the queue, and the workers running them must not find the pool
+  // destroyed when the process exits.
+  static TaskPoolImpl *g_task_pool_impl = new TaskPoolImpl();
+  return *g_task_pool_impl;
 }
 
 void TaskPool::AddTaskImpl(std::function<void()> &&task_fn) {
@@ -92,26 +96,57 @@ void TaskPoolImpl::Worker(TaskPoolImpl *pool) {
   }
 }
 
-void TaskMapOverInt(size_t begin, size_t end,
-                    const llvm::function_ref<void(size_t)> &func) {
-  const size_t num_workers = std::min<size_t>(end, GetHardwareConcurrencyHint());
-  std::atomic<size_t> idx{begin};
-  
-  auto wrapper = [&idx, end, &func]() {
+namespace {
+// Shared between the caller of TaskMapOverInt and the pool tasks helping it.
+// Tasks that only start once every value was taken never touch 'func', which
+// may be gone by then.
+struct TaskMapState {
+  TaskMapState(size_t begin, size_t end,
+               const llvm::function_ref<void(size_t)> &func)
+      : next(begin), end(end), num_values(end - begin), func(func) {}
+
+  // Work on values until there are none left.
+  void Work() {
     while (true) {
-      size_t i = idx.fetch_add(1);
+      const size_t i = next.fetch_add(1);
       if (i >= end)
-        break;
+        return;
       func(i);
+      if (num_done.fetch_add(1) + 1 == num_values) {
+        std::lock_guard<std::mutex> guard(mutex);
+        done_cv.notify_all();
+      }
     }
-  };
-
-  std::vector<std::future<void>> futures;
-  futures.reserve(num_workers);
-  for (size_t i = 0; i < num_workers; i++)
-    futures.push_back(TaskPool::AddTask(wrapper));
-  for (size_t i = 0; i < num_workers; i++)
-    futures[i].wait();
+  }
+
+  std::atomic<size_t> next;
+  const size_t end;
+  const size_t num_values;
+  std::atomic<size_t> num_done{0};
+  const llvm::function_ref<void(size_t)> &func;
+  std::mutex mutex;
+  std::condition_variable done_cv;
+};
+} // namespace
+
+void TaskMapOverInt(size_t begin, size_t end,
+                    const llvm::function_ref<void(size_t)> &func) {
+  if (begin >= end)
+    return;
+
+  auto state = std::make_shared<TaskMapState>(begin, end, func);
+  // The calling thread is one of the workers.
+  const size_t num_helpers =
+      std::min<size_t>(end - begin, GetHardwareConcurrencyHint()) - 1;
+  for (size_t i = 0; i < num_helpers; i++)
+    TaskPool::AddTask([state]() { state->Work(); });
+
+  state->Work();
+
+  // Every value is taken, wait for the ones other threads are working on.
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done_cv.wait(
+      lock, [&state]() { return state->num_done == state->num_values; });
 }
 
 } // namespace lldb_private
@@ -9,6 +9,7 @@
 #include "lldb/Initialization/SystemInitializerCommon.h"
 
 #include "Plugins/Process/gdb-remote/ProcessGDBRemoteLog.h"
+#include "lldb/Host/DebugFileIndex.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/HostInfo.h"
@@ -110,6 +111,7 @@ void SystemInitializerCommon::Terminate() {
   ProcessWindowsLog::Terminate();
 #endif
 
+  DebugFileIndex::SaveAll();
   HostInfo::Terminate();
   Log::DisableAllLogChannels();
   FileSystem::Terminate();
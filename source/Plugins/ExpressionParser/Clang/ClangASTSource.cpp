@@ -813,9 +813,22 @@ void ClangASTSource::FindExternalVisibleDecls(
                       module_sp->GetFileSpec().GetFilename().GetCString());
       }
     }
+  } else if (ClangASTImporter::NamespaceMapSP cached_namespaces =
+                 m_ast_importer_sp
+                     ? m_ast_importer_sp->LookupCachedNamespaces(name)
+                     : nullptr) {
+    context.m_namespace_map->insert(context.m_namespace_map->end(),
+                                    cached_namespaces->begin(),
+                                    cached_namespaces->end());
+
+    if (log)
+      log->Printf("  CAS::FEVD[%u] Found %d cached namespaces named %s",
+                  current_id, static_cast<int>(cached_namespaces->size()),
+                  name.GetCString());
   } else if (!HasMerger()) {
     const ModuleList &target_images = m_target->GetImages();
     std::lock_guard<std::recursive_mutex> guard(target_images.GetMutex());
+    const size_t num_namespaces_before = context.m_namespace_map->size();
 
     for (size_t i = 0, e = target_images.GetSize(); i < e; ++i) {
       lldb::ModuleSP image = target_images.GetModuleAtIndexUnlocked(i);
@@ -844,6 +857,12 @@ void ClangASTSource::FindExternalVisibleDecls(
                       image->GetFileSpec().GetFilename().GetCString());
       }
     }
+
+    if (m_ast_importer_sp)
+      m_ast_importer_sp->CacheNamespaceLookup(
+          name, std::make_shared<ClangASTImporter::NamespaceMap>(
+                    context.m_namespace_map->begin() + num_namespaces_before,
+                    context.m_namespace_map->end()));
   }
 
   do {
@@ -853,11 +872,19 @@ void ClangASTSource::FindExternalVisibleDecls(
     TypeList types;
     const bool exact_match = true;
     llvm::DenseSet<lldb_private::SymbolFile *> searched_symbol_files;
+    lldb::TypeSP cached_type_sp;
     if (module_sp && namespace_decl)
       module_sp->FindTypesInNamespace(name, &namespace_decl, 1, types);
-    else {
+    else if (!module_sp && m_ast_importer_sp &&
+             m_ast_importer_sp->LookupCachedType(name, cached_type_sp)) {
+      if (cached_type_sp)
+        types.Insert(cached_type_sp);
+    } else {
       m_target->GetImages().FindTypes(module_sp.get(), name, exact_match, 1,
                                       searched_symbol_files, types);
+      if (!module_sp && m_ast_importer_sp)
+        m_ast_importer_sp->CacheTypeLookup(
+            name, types.GetSize() ? types.GetTypeAtIndex(0) : lldb::TypeSP());
     }
 
     if (size_t num_types = types.GetSize()) {
@@ -872,7 +899,12 @@ void ClangASTSource::FindExternalVisibleDecls(
                       (name_string ? name_string : "<anonymous>"));
         }
 
-        CompilerType full_type = type_sp->GetFullCompilerType();
+        // In lazy mode, the parser gets a forward declaration that is only
+        // completed, through CompleteType(), if the expression needs the
+        // definition.
+        CompilerType full_type = m_target->GetLazyClangTypeImport()
+                                     ? type_sp->GetForwardCompilerType()
+                                     : type_sp->GetFullCompilerType();
 
         CompilerType copied_clang_type(GuardedCopyType(full_type));
 
@@ -294,6 +294,30 @@ void ClangUserExpression::ScanContext(ExecutionContext &exe_ctx, Status &err) {
   }
 }
 
+bool ClangUserExpression::ContextIsValidForFrame(StackFrame &frame) {
+  // ScanContext made sure the object pointer was usable at the pc the
+  // expression was parsed at. Its location may only be valid for part of the
+  // block.
+  if (!(m_language_flags & eLanguageFlagNeedsObjectPointer))
+    return true;
+
+  SymbolContext sym_ctx = frame.GetSymbolContext(lldb::eSymbolContextFunction |
+                                                 lldb::eSymbolContextBlock);
+  Block *function_block = sym_ctx.GetFunctionBlock();
+  if (!function_block)
+    return false;
+  lldb::VariableListSP variable_list_sp(
+      function_block->GetBlockVariableList(true));
+  if (!variable_list_sp)
+    return false;
+
+  ConstString object_name(
+      (m_language_flags & eLanguageFlagInCPlusPlusMethod) ? "this" : "self");
+  lldb::VariableSP object_var_sp(variable_list_sp->FindVariable(object_name));
+  return object_var_sp && object_var_sp->IsInScope(&frame) &&
+         object_var_sp->LocationIsValidForFrame(&frame);
+}
+
 // This is a really nasty hack, meant to fix Objective-C expressions of the
 // form (int)[myArray count].  Right now, because the type information for
 // count is not available, [myArray count] returns id, which can't be directly
@@ -181,6 +181,8 @@ private:
   void ScanContext(ExecutionContext &exe_ctx,
                    lldb_private::Status &err) override;
 
+  bool ContextIsValidForFrame(StackFrame &frame) override;
+
   bool AddArguments(ExecutionContext &exe_ctx, std::vector<lldb::addr_t> &args,
                     lldb::addr_t struct_address,
                     DiagnosticManager &diagnostic_manager) override;
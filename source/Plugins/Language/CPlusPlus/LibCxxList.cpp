@@ -131,6 +131,7 @@ protected:
   ListEntry m_fast_runner; // Used for loop detection
 
   size_t m_list_capping_size;
+  size_t m_node_cache_limit;
   CompilerType m_element_type;
   std::map<size_t, ListIterator> m_iterators;
 
@@ -181,6 +182,11 @@ bool AbstractListFrontEnd::Update() {
   if (m_list_capping_size == 0)
     m_list_capping_size = 255;
 
+  m_node_cache_limit = 0;
+  if (m_backend.GetTargetSP())
+    m_node_cache_limit =
+        m_backend.GetTargetSP()->GetMaximumSyntheticNodeCacheSize();
+
   CompilerType list_type = m_backend.GetCompilerType();
   if (list_type.IsReferenceType())
     list_type = list_type.GetNonReferenceType();
@@ -229,15 +235,17 @@ bool AbstractListFrontEnd::HasLoop(size_t count) {
 ValueObjectSP AbstractListFrontEnd::GetItem(size_t idx) {
   size_t advance = idx;
   ListIterator current(m_head);
-  if (idx > 0) {
-    auto cached_iterator = m_iterators.find(idx - 1);
-    if (cached_iterator != m_iterators.end()) {
-      current = cached_iterator->second;
-      advance = 1;
-    }
+  // Start from the closest element we have already visited, so that paging
+  // through a long list in any order does not re-walk it from the head.
+  auto cached_iterator = m_iterators.upper_bound(idx);
+  if (cached_iterator != m_iterators.begin()) {
+    --cached_iterator;
+    current = cached_iterator->second;
+    advance = idx - cached_iterator->first;
   }
   ValueObjectSP value_sp = current.advance(advance);
-  m_iterators[idx] = current;
+  if (m_iterators.size() < m_node_cache_limit)
+    m_iterators[idx] = current;
   return value_sp;
 }
 
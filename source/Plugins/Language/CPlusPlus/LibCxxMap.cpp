@@ -12,161 +12,31 @@
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/DataFormatters/FormattersHelpers.h"
 #include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Endian.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/Stream.h"
 
+#include "llvm/ADT/DenseMap.h"
+
 using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::formatters;
 
-class MapEntry {
-public:
-  MapEntry() = default;
-  explicit MapEntry(ValueObjectSP entry_sp) : m_entry_sp(entry_sp) {}
-  MapEntry(const MapEntry &rhs) = default;
-  explicit MapEntry(ValueObject *entry)
-      : m_entry_sp(entry ? entry->GetSP() : ValueObjectSP()) {}
-
-  ValueObjectSP left() const {
-    static ConstString g_left("__left_");
-    if (!m_entry_sp)
-      return m_entry_sp;
-    return m_entry_sp->GetSyntheticChildAtOffset(
-        0, m_entry_sp->GetCompilerType(), true);
-  }
-
-  ValueObjectSP right() const {
-    static ConstString g_right("__right_");
-    if (!m_entry_sp)
-      return m_entry_sp;
-    return m_entry_sp->GetSyntheticChildAtOffset(
-        m_entry_sp->GetProcessSP()->GetAddressByteSize(),
-        m_entry_sp->GetCompilerType(), true);
-  }
-
-  ValueObjectSP parent() const {
-    static ConstString g_parent("__parent_");
-    if (!m_entry_sp)
-      return m_entry_sp;
-    return m_entry_sp->GetSyntheticChildAtOffset(
-        2 * m_entry_sp->GetProcessSP()->GetAddressByteSize(),
-        m_entry_sp->GetCompilerType(), true);
-  }
-
-  uint64_t value() const {
-    if (!m_entry_sp)
-      return 0;
-    return m_entry_sp->GetValueAsUnsigned(0);
-  }
-
-  bool error() const {
-    if (!m_entry_sp)
-      return true;
-    return m_entry_sp->GetError().Fail();
-  }
-
-  bool null() const { return (value() == 0); }
-
-  ValueObjectSP GetEntry() const { return m_entry_sp; }
-
-  void SetEntry(ValueObjectSP entry) { m_entry_sp = entry; }
-
-  bool operator==(const MapEntry &rhs) const {
-    return (rhs.m_entry_sp.get() == m_entry_sp.get());
-  }
-
-private:
-  ValueObjectSP m_entry_sp;
-};
-
-class MapIterator {
-public:
-  MapIterator() = default;
-  MapIterator(MapEntry entry, size_t depth = 0)
-      : m_entry(entry), m_max_depth(depth), m_error(false) {}
-  MapIterator(ValueObjectSP entry, size_t depth = 0)
-      : m_entry(entry), m_max_depth(depth), m_error(false) {}
-  MapIterator(const MapIterator &rhs)
-      : m_entry(rhs.m_entry), m_max_depth(rhs.m_max_depth), m_error(false) {}
-  MapIterator(ValueObject *entry, size_t depth = 0)
-      : m_entry(entry), m_max_depth(depth), m_error(false) {}
-
-  ValueObjectSP value() { return m_entry.GetEntry(); }
-
-  ValueObjectSP advance(size_t count) {
-    ValueObjectSP fail;
-    if (m_error)
-      return fail;
-    size_t steps = 0;
-    while (count > 0) {
-      next();
-      count--, steps++;
-      if (m_error || m_entry.null() || (steps > m_max_depth))
-        return fail;
-    }
-    return m_entry.GetEntry();
-  }
-
-protected:
-  void next() {
-    if (m_entry.null())
-      return;
-    MapEntry right(m_entry.right());
-    if (!right.null()) {
-      m_entry = tree_min(std::move(right));
-      return;
-    }
-    size_t steps = 0;
-    while (!is_left_child(m_entry)) {
-      if (m_entry.error()) {
-        m_error = true;
-        return;
-      }
-      m_entry.SetEntry(m_entry.parent());
-      steps++;
-      if (steps > m_max_depth) {
-        m_entry = MapEntry();
-        return;
-      }
-    }
-    m_entry = MapEntry(m_entry.parent());
-  }
-
-private:
-  MapEntry tree_min(MapEntry &&x) {
-    if (x.null())
-      return MapEntry();
-    MapEntry left(x.left());
-    size_t steps = 0;
-    while (!left.null()) {
-      if (left.error()) {
-        m_error = true;
-        return MapEntry();
-      }
-      x = left;
-      left.SetEntry(x.left());
-      steps++;
-      if (steps > m_max_depth)
-        return MapEntry();
-    }
-    return x;
-  }
-
-  bool is_left_child(const MapEntry &x) {
-    if (x.null())
-      return false;
-    MapEntry rhs(x.parent());
-    rhs.SetEntry(rhs.left());
-    return x.value() == rhs.value();
-  }
-
-  MapEntry m_entry;
-  size_t m_max_depth;
-  bool m_error;
+namespace {
+// The links at the start of every libc++ __tree_node_base. __left_, __right_
+// and __parent_ are laid out consecutively, so all three are fetched from the
+// inferior with a single memory read. The tree's end node only has a __left_
+// member, so the other two may be LLDB_INVALID_ADDRESS for it.
+struct MapNodeLinks {
+  lldb::addr_t left = LLDB_INVALID_ADDRESS;
+  lldb::addr_t right = LLDB_INVALID_ADDRESS;
+  lldb::addr_t parent = LLDB_INVALID_ADDRESS;
 };
+} // namespace
 
 namespace lldb_private {
 namespace formatters {
@@ -191,12 +61,39 @@ private:
 
   void GetValueOffset(const lldb::ValueObjectSP &node);
 
+  size_t ReadNodeMemory(lldb::addr_t addr, void *dst, size_t size);
+
+  bool GetNodeLinks(lldb::addr_t node, MapNodeLinks &links);
+
+  lldb::addr_t GetNextNode(lldb::addr_t node);
+
+  lldb::addr_t GetNodeAddressAtIndex(size_t idx);
+
+  void ClearNodeCache();
+
   ValueObject *m_tree;
   ValueObject *m_root_node;
   CompilerType m_element_type;
   uint32_t m_skip_size;
   size_t m_count;
-  std::map<size_t, MapIterator> m_iterators;
+  // In-order node addresses discovered so far; m_node_addresses[i] is the
+  // node holding child i. Together with m_node_links this lets children be
+  // fetched in any order without re-walking the tree from __begin_node_.
+  // Both stay valid as long as the process memory generation (m_mod_id) and
+  // the address of the tree are unchanged.
+  std::vector<lldb::addr_t> m_node_addresses;
+  llvm::DenseMap<lldb::addr_t, MapNodeLinks> m_node_links;
+  size_t m_node_cache_limit;
+  // The last node visited past the end of m_node_addresses, so that paging
+  // through a map larger than the cache resumes from there.
+  size_t m_cursor_index;
+  lldb::addr_t m_cursor_node;
+  // The inferior memory last read for nodes. Nodes are read a batch at a
+  // time, since the nodes of a map are often allocated next to each other.
+  std::vector<uint8_t> m_node_batch;
+  lldb::addr_t m_node_batch_address;
+  ProcessModID m_mod_id;
+  lldb::addr_t m_tree_address;
 };
 } // namespace formatters
 } // namespace lldb_private
@@ -205,7 +102,11 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::
     LibcxxStdMapSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp)
     : SyntheticChildrenFrontEnd(*valobj_sp), m_tree(nullptr),
       m_root_node(nullptr), m_element_type(), m_skip_size(UINT32_MAX),
-      m_count(UINT32_MAX), m_iterators() {
+      m_count(UINT32_MAX), m_node_addresses(), m_node_links(),
+      m_node_cache_limit(0), m_cursor_index(0),
+      m_cursor_node(LLDB_INVALID_ADDRESS), m_node_batch(),
+      m_node_batch_address(LLDB_INVALID_ADDRESS), m_mod_id(),
+      m_tree_address(LLDB_INVALID_ADDRESS) {
   if (valobj_sp)
     Update();
 }
@@ -326,86 +227,220 @@ void lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetValueOffset(
   }
 }
 
+size_t lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::ReadNodeMemory(
+    lldb::addr_t addr, void *dst, size_t size) {
+  if (m_node_batch_address != LLDB_INVALID_ADDRESS &&
+      addr >= m_node_batch_address &&
+      addr + size <= m_node_batch_address + m_node_batch.size()) {
+    memcpy(dst, m_node_batch.data() + (addr - m_node_batch_address), size);
+    return size;
+  }
+
+  ProcessSP process_sp(m_backend.GetProcessSP());
+  if (!process_sp)
+    return 0;
+
+  // Read enough for the nodes that follow this one as well.
+  static const size_t g_nodes_per_batch = 32;
+  static const size_t g_max_batch_size = 4096;
+  size_t node_size = 3 * process_sp->GetAddressByteSize();
+  if (m_skip_size != UINT32_MAX) {
+    if (llvm::Optional<uint64_t> value_size =
+            m_element_type.GetByteSize(process_sp.get()))
+      node_size = std::max<size_t>(node_size, m_skip_size + *value_size);
+  }
+  const size_t batch_size =
+      std::max(size, std::min(g_nodes_per_batch * node_size, g_max_batch_size));
+
+  Status error;
+  m_node_batch.resize(batch_size);
+  size_t bytes_read =
+      process_sp->ReadMemory(addr, m_node_batch.data(), batch_size, error);
+  if (bytes_read < size && batch_size > size) {
+    // The batch ran into unreadable memory, read only what was asked for.
+    bytes_read = process_sp->ReadMemory(addr, m_node_batch.data(), size, error);
+  }
+  m_node_batch.resize(bytes_read);
+  m_node_batch_address = addr;
+  const size_t bytes_copied = std::min(size, bytes_read);
+  memcpy(dst, m_node_batch.data(), bytes_copied);
+  return bytes_copied;
+}
+
+bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetNodeLinks(
+    lldb::addr_t node, MapNodeLinks &links) {
+  auto pos = m_node_links.find(node);
+  if (pos != m_node_links.end()) {
+    links = pos->second;
+    return true;
+  }
+
+  ProcessSP process_sp(m_backend.GetProcessSP());
+  if (!process_sp)
+    return false;
+  const uint32_t addr_size = process_sp->GetAddressByteSize();
+  uint8_t buffer[3 * sizeof(lldb::addr_t)];
+  // A short read is expected when the end node sits at the very end of a
+  // mapped region; only its __left_ member is ever looked at.
+  size_t bytes_read = ReadNodeMemory(node, buffer, 3 * addr_size);
+  if (bytes_read < addr_size)
+    return false;
+
+  DataExtractor data(buffer, bytes_read, process_sp->GetByteOrder(),
+                     addr_size);
+  lldb::offset_t offset = 0;
+  links = MapNodeLinks();
+  links.left = data.GetAddress(&offset);
+  if (bytes_read >= 2 * addr_size)
+    links.right = data.GetAddress(&offset);
+  if (bytes_read >= 3 * addr_size)
+    links.parent = data.GetAddress(&offset);
+
+  if (m_node_links.size() >= m_node_cache_limit)
+    m_node_links.clear();
+  m_node_links[node] = links;
+  return true;
+}
+
+lldb::addr_t
+lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetNextNode(
+    lldb::addr_t node) {
+  // This follows std::__tree_next_iter, bounding every loop by the number of
+  // elements so that a corrupt tree cannot make us walk forever.
+  const size_t max_depth = CalculateNumChildren();
+  MapNodeLinks links;
+  if (!GetNodeLinks(node, links) || links.right == LLDB_INVALID_ADDRESS)
+    return LLDB_INVALID_ADDRESS;
+
+  if (links.right != 0) {
+    node = links.right;
+    for (size_t steps = 0; steps <= max_depth; ++steps) {
+      if (!GetNodeLinks(node, links) || links.left == LLDB_INVALID_ADDRESS)
+        return LLDB_INVALID_ADDRESS;
+      if (links.left == 0)
+        return node;
+      node = links.left;
+    }
+    return LLDB_INVALID_ADDRESS;
+  }
+
+  for (size_t steps = 0; steps <= max_depth; ++steps) {
+    const lldb::addr_t parent = links.parent;
+    MapNodeLinks parent_links;
+    if (parent == 0 || parent == LLDB_INVALID_ADDRESS ||
+        !GetNodeLinks(parent, parent_links))
+      return LLDB_INVALID_ADDRESS;
+    if (parent_links.left == node)
+      return parent;
+    node = parent;
+    links = parent_links;
+  }
+  return LLDB_INVALID_ADDRESS;
+}
+
+lldb::addr_t lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::
+    GetNodeAddressAtIndex(size_t idx) {
+  if (m_node_addresses.empty()) {
+    lldb::addr_t begin_node = m_root_node->GetValueAsUnsigned(0);
+    if (begin_node == 0)
+      return LLDB_INVALID_ADDRESS;
+    m_node_addresses.push_back(begin_node);
+  }
+  if (idx < m_node_addresses.size())
+    return m_node_addresses[idx];
+
+  // Resume the walk from the last node we know about. Once the cache is full
+  // keep walking without remembering the nodes we pass, but resume from the
+  // last node visited when it comes before the one asked for, so that paging
+  // through the rest of the map only walks each node once.
+  size_t node_idx = m_node_addresses.size() - 1;
+  lldb::addr_t node = m_node_addresses.back();
+  if (m_cursor_node != LLDB_INVALID_ADDRESS && m_cursor_index > node_idx &&
+      m_cursor_index <= idx) {
+    node_idx = m_cursor_index;
+    node = m_cursor_node;
+  }
+  for (; node_idx < idx; ++node_idx) {
+    node = GetNextNode(node);
+    if (node == LLDB_INVALID_ADDRESS || node == 0)
+      return LLDB_INVALID_ADDRESS;
+    if (m_node_addresses.size() < m_node_cache_limit)
+      m_node_addresses.push_back(node);
+  }
+  m_cursor_index = idx;
+  m_cursor_node = node;
+  return node;
+}
+
+void lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::
+    ClearNodeCache() {
+  m_node_addresses.clear();
+  m_node_links.clear();
+  m_cursor_index = 0;
+  m_cursor_node = LLDB_INVALID_ADDRESS;
+  m_node_batch.clear();
+  m_node_batch_address = LLDB_INVALID_ADDRESS;
+}
+
 lldb::ValueObjectSP
 lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     size_t idx) {
   static ConstString g___cc("__cc");
   static ConstString g___nc("__nc");
-  static ConstString g___value_("__value_");
 
   if (idx >= CalculateNumChildren())
     return lldb::ValueObjectSP();
   if (m_tree == nullptr || m_root_node == nullptr)
     return lldb::ValueObjectSP();
 
-  MapIterator iterator(m_root_node, CalculateNumChildren());
+  if (!GetDataType()) {
+    m_tree = nullptr;
+    return lldb::ValueObjectSP();
+  }
 
-  const bool need_to_skip = (idx > 0);
-  size_t actual_advancde = idx;
-  if (need_to_skip) {
-    auto cached_iterator = m_iterators.find(idx - 1);
-    if (cached_iterator != m_iterators.end()) {
-      iterator = cached_iterator->second;
-      actual_advancde = 1;
+  // because of the way our debug info is made, we need to look at the first
+  // node so that we can cache the offset of the value within a node
+  if (m_skip_size == UINT32_MAX) {
+    Status error;
+    ValueObjectSP first_node_sp = m_root_node->Dereference(error);
+    if (!first_node_sp || error.Fail()) {
+      m_tree = nullptr;
+      return lldb::ValueObjectSP();
+    }
+    GetValueOffset(first_node_sp);
+    if (m_skip_size == UINT32_MAX) {
+      m_tree = nullptr;
+      return lldb::ValueObjectSP();
     }
   }
 
-  ValueObjectSP iterated_sp(iterator.advance(actual_advancde));
-  if (!iterated_sp) {
+  lldb::addr_t node_addr = GetNodeAddressAtIndex(idx);
+  if (node_addr == LLDB_INVALID_ADDRESS) {
     // this tree is garbage - stop
     m_tree =
         nullptr; // this will stop all future searches until an Update() happens
-    return iterated_sp;
+    return lldb::ValueObjectSP();
   }
-  if (GetDataType()) {
-    if (!need_to_skip) {
-      Status error;
-      iterated_sp = iterated_sp->Dereference(error);
-      if (!iterated_sp || error.Fail()) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-      GetValueOffset(iterated_sp);
-      auto child_sp = iterated_sp->GetChildMemberWithName(g___value_, true);
-      if (child_sp)
-        iterated_sp = child_sp;
-      else
-        iterated_sp = iterated_sp->GetSyntheticChildAtOffset(
-            m_skip_size, m_element_type, true);
-      if (!iterated_sp) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-    } else {
-      // because of the way our debug info is made, we need to read item 0
-      // first so that we can cache information used to generate other elements
-      if (m_skip_size == UINT32_MAX)
-        GetChildAtIndex(0);
-      if (m_skip_size == UINT32_MAX) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-      iterated_sp = iterated_sp->GetSyntheticChildAtOffset(
-          m_skip_size, m_element_type, true);
-      if (!iterated_sp) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-    }
-  } else {
+
+  // we need to copy the value into a new object so that it does not change
+  // under us if the node is later reused. The value usually comes from the
+  // batch of memory read while walking to the node.
+  ProcessSP process_sp(m_backend.GetProcessSP());
+  llvm::Optional<uint64_t> value_size =
+      m_element_type.GetByteSize(process_sp.get());
+  if (!process_sp || !value_size) {
     m_tree = nullptr;
     return lldb::ValueObjectSP();
   }
-  // at this point we have a valid
-  // we need to copy current_sp into a new object otherwise we will end up with
-  // all items named __value_
-  DataExtractor data;
-  Status error;
-  iterated_sp->GetData(data, error);
-  if (error.Fail()) {
+  DataBufferSP buffer_sp(new DataBufferHeap(*value_size, 0));
+  if (ReadNodeMemory(node_addr + m_skip_size, buffer_sp->GetBytes(),
+                     *value_size) < *value_size) {
     m_tree = nullptr;
     return lldb::ValueObjectSP();
   }
+  DataExtractor data(buffer_sp, process_sp->GetByteOrder(),
+                     process_sp->GetAddressByteSize());
+
   StreamString name;
   name.Printf("[%" PRIu64 "]", (uint64_t)idx);
   auto potential_child_sp = CreateValueObjectFromData(
@@ -429,7 +464,6 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     }
     }
   }
-  m_iterators[idx] = iterator;
   return potential_child_sp;
 }
 
@@ -438,11 +472,26 @@ bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::Update() {
   static ConstString g___begin_node_("__begin_node_");
   m_count = UINT32_MAX;
   m_tree = m_root_node = nullptr;
-  m_iterators.clear();
   m_tree = m_backend.GetChildMemberWithName(g___tree_, true).get();
-  if (!m_tree)
+  if (!m_tree) {
+    ClearNodeCache();
     return false;
+  }
   m_root_node = m_tree->GetChildMemberWithName(g___begin_node_, true).get();
+
+  if (TargetSP target_sp = m_backend.GetTargetSP())
+    m_node_cache_limit = target_sp->GetMaximumSyntheticNodeCacheSize();
+
+  // The node index only needs to be rebuilt if the inferior could have
+  // touched the tree, or if we are now looking at a different tree.
+  ProcessSP process_sp(m_backend.GetProcessSP());
+  ProcessModID mod_id = process_sp ? process_sp->GetModID() : ProcessModID();
+  lldb::addr_t tree_address = m_tree->GetAddressOf();
+  if (!process_sp || mod_id != m_mod_id || tree_address != m_tree_address) {
+    ClearNodeCache();
+    m_mod_id = mod_id;
+    m_tree_address = tree_address;
+  }
   return false;
 }
 
@@ -12,6 +12,7 @@
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/DataFormatters/FormattersHelpers.h"
 #include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/Endian.h"
@@ -48,6 +49,10 @@ private:
   size_t m_num_elements;
   ValueObject *m_next_element;
   std::vector<std::pair<ValueObject *, uint64_t>> m_elements_cache;
+  // The elements found so far stay valid while the inferior hasn't run and
+  // we are still looking at the same table.
+  ProcessModID m_mod_id;
+  lldb::addr_t m_table_address;
 };
 } // namespace formatters
 } // namespace lldb_private
@@ -55,7 +60,8 @@ private:
 lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::
     LibcxxStdUnorderedMapSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp)
     : SyntheticChildrenFrontEnd(*valobj_sp), m_element_type(), m_tree(nullptr),
-      m_num_elements(0), m_next_element(nullptr), m_elements_cache() {
+      m_num_elements(0), m_next_element(nullptr), m_elements_cache(),
+      m_mod_id(), m_table_address(LLDB_INVALID_ADDRESS) {
   if (valobj_sp)
     Update();
 }
@@ -160,11 +166,26 @@ lldb::ValueObjectSP lldb_private::formatters::
 
 bool lldb_private::formatters::LibcxxStdUnorderedMapSyntheticFrontEnd::
     Update() {
+  ValueObjectSP table_sp =
+      m_backend.GetChildMemberWithName(ConstString("__table_"), true);
+
+  // Keep walking the bucket list from where we stopped if nothing could have
+  // changed it, instead of walking it again from the start.
+  ProcessSP process_sp(m_backend.GetProcessSP());
+  ProcessModID mod_id = process_sp ? process_sp->GetModID() : ProcessModID();
+  lldb::addr_t table_address =
+      table_sp ? table_sp->GetAddressOf() : LLDB_INVALID_ADDRESS;
+  if (process_sp && table_sp && m_tree && mod_id == m_mod_id &&
+      table_address != LLDB_INVALID_ADDRESS &&
+      table_address == m_table_address)
+    return false;
+  m_mod_id = mod_id;
+  m_table_address = table_address;
+
   m_num_elements = UINT32_MAX;
+  m_tree = nullptr;
   m_next_element = nullptr;
   m_elements_cache.clear();
-  ValueObjectSP table_sp =
-      m_backend.GetChildMemberWithName(ConstString("__table_"), true);
   if (!table_sp)
     return false;
 
@@ -10,16 +10,21 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <unordered_map>
 
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/RangeMap.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/Config.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
+#include "lldb/Symbol/FileCRCCache.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/SwiftLanguageRuntime.h"
@@ -40,6 +45,10 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MipsABIFlags.h"
 
+#if defined(HAVE_LIBZSTD)
+#include <zstd.h>
+#endif
+
 #define CASE_AND_STREAM(s, def, width)                                         \
   case def:                                                                    \
     s->Printf("%-*s", width, #def);                                            \
@@ -70,6 +79,9 @@ const elf_word LLDB_NT_GNU_ABI_SIZE = 16;
 
 const elf_word LLDB_NT_GNU_BUILD_ID_TAG = 0x03;
 
+// ELF compression types missing from llvm::ELF.
+const elf_word LLDB_ELFCOMPRESS_ZSTD = 2;
+
 const elf_word LLDB_NT_NETBSD_ABI_TAG = 0x01;
 const elf_word LLDB_NT_NETBSD_ABI_SIZE = 4;
 
@@ -429,67 +441,20 @@ bool ObjectFileELF::MagicBytesMatch(DataBufferSP &data_sp,
   return false;
 }
 
-/*
- * crc function from http://svnweb.freebsd.org/base/head/sys/libkern/crc32.c
- *
- *   COPYRIGHT (C) 1986 Gary S. Brown. You may use this program, or
- *   code or tables extracted from it, as desired without restriction.
- */
 static uint32_t calc_crc32(uint32_t crc, const void *buf, size_t size) {
-  static const uint32_t g_crc32_tab[] = {
-      0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
-      0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
-      0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
-      0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
-      0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9,
-      0xfa0f3d63, 0x8d080df5, 0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172,
-      0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b, 0x35b5a8fa, 0x42b2986c,
-      0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
-      0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423,
-      0xcfba9599, 0xb8bda50f, 0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924,
-      0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d, 0x76dc4190, 0x01db7106,
-      0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
-      0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d,
-      0x91646c97, 0xe6635c01, 0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e,
-      0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457, 0x65b0d9c6, 0x12b7e950,
-      0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
-      0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7,
-      0xa4d1c46d, 0xd3d6f4fb, 0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0,
-      0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9, 0x5005713c, 0x270241aa,
-      0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
-      0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81,
-      0xb7bd5c3b, 0xc0ba6cad, 0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a,
-      0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683, 0xe3630b12, 0x94643b84,
-      0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
-      0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb,
-      0x196c3671, 0x6e6b06e7, 0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc,
-      0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5, 0xd6d6a3e8, 0xa1d1937e,
-      0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
-      0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55,
-      0x316e8eef, 0x4669be79, 0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236,
-      0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f, 0xc5ba3bbe, 0xb2bd0b28,
-      0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
-      0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f,
-      0x72076785, 0x05005713, 0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38,
-      0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21, 0x86d3d2d4, 0xf1d4e242,
-      0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
-      0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69,
-      0x616bffd3, 0x166ccf45, 0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2,
-      0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db, 0xaed16a4a, 0xd9d65adc,
-      0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
-      0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693,
-      0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94,
-      0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
-  const uint8_t *p = (const uint8_t *)buf;
-
-  crc = crc ^ ~0U;
-  while (size--)
-    crc = g_crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
-  return crc ^ ~0U;
-}
-
-static uint32_t calc_gnu_debuglink_crc32(const void *buf, size_t size) {
-  return calc_crc32(0U, buf, size);
+  return FileCRCCache::CalculateCRC32(
+      crc, llvm::makeArrayRef(static_cast<const uint8_t *>(buf), size));
+}
+
+// The crc32 of a whole file, remembered across debug sessions as long as the
+// file doesn't change.
+static uint32_t calc_gnu_debuglink_crc32(const FileSpec &file,
+                                         lldb::offset_t file_offset,
+                                         const DataExtractor &data) {
+  return FileCRCCache::Get(ModuleList::GetGlobalModuleListProperties()
+                               .GetModuleCRCCachePath())
+      .GetCRC32(file, file_offset,
+                llvm::makeArrayRef(data.GetDataStart(), data.GetByteSize()));
 }
 
 uint32_t ObjectFileELF::CalculateELFNotesSegmentsCRC32(
@@ -682,8 +647,8 @@ size_t ObjectFileELF::GetModuleSpecifications(
                 core_notes_crc =
                     CalculateELFNotesSegmentsCRC32(program_headers, data);
               } else {
-                gnu_debuglink_crc = calc_gnu_debuglink_crc32(
-                    data.GetDataStart(), data.GetByteSize());
+                gnu_debuglink_crc =
+                    calc_gnu_debuglink_crc32(file, file_offset, data);
               }
             }
             using u32le = llvm::support::ulittle32_t;
@@ -745,7 +710,16 @@ ObjectFileELF::ObjectFileELF(const lldb::ModuleSP &module_sp,
   ::memset(&m_header, 0, sizeof(m_header));
 }
 
-ObjectFileELF::~ObjectFileELF() {}
+ObjectFileELF::~ObjectFileELF() {
+  // Prefetch tasks that haven't started must leave this object file alone;
+  // wait for the ones that did.
+  if (m_prefetch_state) {
+    std::unique_lock<std::mutex> lock(m_prefetch_state->mutex);
+    m_prefetch_state->cancelled = true;
+    m_prefetch_state->cond.wait(
+        lock, [this] { return m_prefetch_state->num_running == 0; });
+  }
+}
 
 bool ObjectFileELF::IsExecutable() const {
   return ((m_header.e_type & ET_EXEC) != 0) || (m_header.e_entry != 0);
@@ -877,9 +851,10 @@ bool ObjectFileELF::GetUUID(lldb_private::UUID *uuid) {
       m_uuid = UUID::fromData(data, sizeof(data));
     }
   } else {
+    // An image read from memory isn't the file on disk; don't cache its crc.
     if (!m_gnu_debuglink_crc)
-      m_gnu_debuglink_crc =
-          calc_gnu_debuglink_crc32(m_data.GetDataStart(), m_data.GetByteSize());
+      m_gnu_debuglink_crc = calc_gnu_debuglink_crc32(
+          IsInMemory() ? FileSpec() : m_file, m_file_offset, m_data);
     if (m_gnu_debuglink_crc) {
       // Use 4 bytes of crc from the .gnu_debuglink section.
       u32le data(m_gnu_debuglink_crc);
@@ -1974,15 +1949,38 @@ static char FindArmAarch64MappingSymbol(const char *symbol_name) {
 #define STO_MICROMIPS (2 << 6)
 #define IS_MICROMIPS(ST_OTHER) (((ST_OTHER)&STO_MIPS_ISA) == STO_MICROMIPS)
 
-// private
-unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
-                                     SectionList *section_list,
-                                     const size_t num_symbols,
-                                     const DataExtractor &symtab_data,
-                                     const DataExtractor &strtab_data) {
+namespace {
+// A symbol table entry with everything that can be worked out without
+// touching the object file: its name, type and section.
+struct DecodedELFSymbol {
   ELFSymbol symbol;
-  lldb::offset_t offset = 0;
+  unsigned index;
+  const char *name;
+  SymbolType type;
+  SectionSP section_sp;
+  Mangled mangled;
+  bool has_suffix;
+};
 
+struct DecodedELFSymbolChunk {
+  std::vector<DecodedELFSymbol> symbols;
+  // The index of the first entry that couldn't be parsed, or the end of the
+  // chunk.
+  unsigned end;
+  bool complete;
+};
+} // namespace
+
+// Symbol tables with fewer entries than this per thread are decoded on the
+// calling thread.
+static const size_t g_min_symbols_per_chunk = 16 * 1024;
+
+static DecodedELFSymbolChunk
+DecodeELFSymbols(unsigned first, unsigned last,
+                 const DataExtractor &symtab_data,
+                 const DataExtractor &strtab_data, lldb::offset_t entsize,
+                 llvm::ArrayRef<SectionSP> sections_by_id,
+                 bool skip_oatdata_oatexec) {
   static ConstString text_section_name(".text");
   static ConstString init_section_name(".init");
   static ConstString fini_section_name(".fini");
@@ -1996,32 +1994,13 @@ unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
   static ConstString bss_section_name(".bss");
   static ConstString opd_section_name(".opd"); // For ppc64
 
-  // On Android the oatdata and the oatexec symbols in the oat and odex files
-  // covers the full .text section what causes issues with displaying unusable
-  // symbol name to the user and very slow unwinding speed because the
-  // instruction emulation based unwind plans try to emulate all instructions
-  // in these symbols. Don't add these symbols to the symbol list as they have
-  // no use for the debugger and they are causing a lot of trouble. Filtering
-  // can't be restricted to Android because this special object file don't
-  // contain the note section specifying the environment to Android but the
-  // custom extension and file name makes it highly unlikely that this will
-  // collide with anything else.
-  ConstString file_extension = m_file.GetFileNameExtension();
-  bool skip_oatdata_oatexec = file_extension == ConstString(".oat") ||
-                              file_extension == ConstString(".odex");
-
-  ArchSpec arch = GetArchitecture();
-  ModuleSP module_sp(GetModule());
-  SectionList *module_section_list =
-      module_sp ? module_sp->GetSectionList() : nullptr;
-
-  // Local cache to avoid doing a FindSectionByName for each symbol. The "const
-  // char*" key must came from a ConstString object so they can be compared by
-  // pointer
-  std::unordered_map<const char *, lldb::SectionSP> section_name_to_section;
+  DecodedELFSymbolChunk chunk;
+  chunk.symbols.reserve(last - first);
+  lldb::offset_t offset = first * entsize;
+  ELFSymbol symbol;
 
   unsigned i;
-  for (i = 0; i < num_symbols; ++i) {
+  for (i = first; i < last; ++i) {
     if (!symbol.Parse(symtab_data, &offset))
       break;
 
@@ -2052,7 +2031,8 @@ unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
       symbol_type = eSymbolTypeUndefined;
       break;
     default:
-      symbol_section_sp = section_list->FindSectionByID(shndx);
+      if (shndx < sections_by_id.size())
+        symbol_section_sp = sections_by_id[shndx];
       break;
     }
 
@@ -2115,149 +2095,6 @@ unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
       }
     }
 
-    int64_t symbol_value_offset = 0;
-    uint32_t additional_flags = 0;
-
-    if (arch.IsValid()) {
-      if (arch.GetMachine() == llvm::Triple::arm) {
-        if (symbol.getBinding() == STB_LOCAL) {
-          char mapping_symbol = FindArmAarch64MappingSymbol(symbol_name);
-          if (symbol_type == eSymbolTypeCode) {
-            switch (mapping_symbol) {
-            case 'a':
-              // $a[.<any>]* - marks an ARM instruction sequence
-              m_address_class_map[symbol.st_value] = AddressClass::eCode;
-              break;
-            case 'b':
-            case 't':
-              // $b[.<any>]* - marks a THUMB BL instruction sequence
-              // $t[.<any>]* - marks a THUMB instruction sequence
-              m_address_class_map[symbol.st_value] =
-                  AddressClass::eCodeAlternateISA;
-              break;
-            case 'd':
-              // $d[.<any>]* - marks a data item sequence (e.g. lit pool)
-              m_address_class_map[symbol.st_value] = AddressClass::eData;
-              break;
-            }
-          }
-          if (mapping_symbol)
-            continue;
-        }
-      } else if (arch.GetMachine() == llvm::Triple::aarch64) {
-        if (symbol.getBinding() == STB_LOCAL) {
-          char mapping_symbol = FindArmAarch64MappingSymbol(symbol_name);
-          if (symbol_type == eSymbolTypeCode) {
-            switch (mapping_symbol) {
-            case 'x':
-              // $x[.<any>]* - marks an A64 instruction sequence
-              m_address_class_map[symbol.st_value] = AddressClass::eCode;
-              break;
-            case 'd':
-              // $d[.<any>]* - marks a data item sequence (e.g. lit pool)
-              m_address_class_map[symbol.st_value] = AddressClass::eData;
-              break;
-            }
-          }
-          if (mapping_symbol)
-            continue;
-        }
-      }
-
-      if (arch.GetMachine() == llvm::Triple::arm) {
-        if (symbol_type == eSymbolTypeCode) {
-          if (symbol.st_value & 1) {
-            // Subtracting 1 from the address effectively unsets the low order
-            // bit, which results in the address actually pointing to the
-            // beginning of the symbol. This delta will be used below in
-            // conjunction with symbol.st_value to produce the final
-            // symbol_value that we store in the symtab.
-            symbol_value_offset = -1;
-            m_address_class_map[symbol.st_value ^ 1] =
-                AddressClass::eCodeAlternateISA;
-          } else {
-            // This address is ARM
-            m_address_class_map[symbol.st_value] = AddressClass::eCode;
-          }
-        }
-      }
-
-      /*
-       * MIPS:
-       * The bit #0 of an address is used for ISA mode (1 for microMIPS, 0 for
-       * MIPS).
-       * This allows processor to switch between microMIPS and MIPS without any
-       * need
-       * for special mode-control register. However, apart from .debug_line,
-       * none of
-       * the ELF/DWARF sections set the ISA bit (for symbol or section). Use
-       * st_other
-       * flag to check whether the symbol is microMIPS and then set the address
-       * class
-       * accordingly.
-      */
-      const llvm::Triple::ArchType llvm_arch = arch.GetMachine();
-      if (llvm_arch == llvm::Triple::mips ||
-          llvm_arch == llvm::Triple::mipsel ||
-          llvm_arch == llvm::Triple::mips64 ||
-          llvm_arch == llvm::Triple::mips64el) {
-        if (IS_MICROMIPS(symbol.st_other))
-          m_address_class_map[symbol.st_value] = AddressClass::eCodeAlternateISA;
-        else if ((symbol.st_value & 1) && (symbol_type == eSymbolTypeCode)) {
-          symbol.st_value = symbol.st_value & (~1ull);
-          m_address_class_map[symbol.st_value] = AddressClass::eCodeAlternateISA;
-        } else {
-          if (symbol_type == eSymbolTypeCode)
-            m_address_class_map[symbol.st_value] = AddressClass::eCode;
-          else if (symbol_type == eSymbolTypeData)
-            m_address_class_map[symbol.st_value] = AddressClass::eData;
-          else
-            m_address_class_map[symbol.st_value] = AddressClass::eUnknown;
-        }
-      }
-    }
-
-    // symbol_value_offset may contain 0 for ARM symbols or -1 for THUMB
-    // symbols. See above for more details.
-    uint64_t symbol_value = symbol.st_value + symbol_value_offset;
-
-    if (symbol_section_sp == nullptr && shndx == SHN_ABS &&
-        symbol.st_size != 0) {
-      // We don't have a section for a symbol with non-zero size. Create a new
-      // section for it so the address range covered by the symbol is also
-      // covered by the module (represented through the section list). It is
-      // needed so module lookup for the addresses covered by this symbol will
-      // be successfull. This case happens for absolute symbols.
-      ConstString fake_section_name(std::string(".absolute.") + symbol_name);
-      symbol_section_sp =
-          std::make_shared<Section>(module_sp, this, SHN_ABS, fake_section_name,
-                                    eSectionTypeAbsoluteAddress, symbol_value,
-                                    symbol.st_size, 0, 0, 0, SHF_ALLOC);
-
-      module_section_list->AddSection(symbol_section_sp);
-      section_list->AddSection(symbol_section_sp);
-    }
-
-    if (symbol_section_sp &&
-        CalculateType() != ObjectFile::Type::eTypeObjectFile)
-      symbol_value -= symbol_section_sp->GetFileAddress();
-
-    if (symbol_section_sp && module_section_list &&
-        module_section_list != section_list) {
-      ConstString sect_name = symbol_section_sp->GetName();
-      auto section_it = section_name_to_section.find(sect_name.GetCString());
-      if (section_it == section_name_to_section.end())
-        section_it =
-            section_name_to_section
-                .emplace(sect_name.GetCString(),
-                         module_section_list->FindSectionByName(sect_name))
-                .first;
-      if (section_it->second)
-        symbol_section_sp = section_it->second;
-    }
-
-    bool is_global = symbol.getBinding() == STB_GLOBAL;
-    uint32_t flags = symbol.st_other << 8 | symbol.st_info | additional_flags;
     bool is_mangled =
         (symbol_name && symbol_name[0] == '_' && symbol_name[1] == 'Z');
 
@@ -2292,30 +2129,262 @@ unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
         mangled.SetDemangledName(ConstString((demangled_name + suffix).str()));
     }
 
-    // In ELF all symbol should have a valid size but it is not true for some
-    // function symbols coming from hand written assembly. As none of the
-    // function symbol should have 0 size we try to calculate the size for
-    // these symbols in the symtab with saying that their original size is not
-    // valid.
-    bool symbol_size_valid =
-        symbol.st_size != 0 || symbol.getType() != STT_FUNC;
-
-    Symbol dc_symbol(
-        i + start_id, // ID is the original symbol table index.
-        mangled,
-        symbol_type,                    // Type of this symbol
-        is_global,                      // Is this globally visible?
-        false,                          // Is this symbol debug info?
-        false,                          // Is this symbol a trampoline?
-        false,                          // Is this symbol artificial?
-        AddressRange(symbol_section_sp, // Section in which this symbol is
-                                        // defined or null.
-                     symbol_value,      // Offset in section or symbol value.
-                     symbol.st_size),   // Size in bytes of this symbol.
-        symbol_size_valid,              // Symbol size is valid
-        has_suffix,                     // Contains linker annotations?
-        flags);                         // Symbol flags.
-    symtab->AddSymbol(dc_symbol);
+    chunk.symbols.push_back({symbol, i, symbol_name, symbol_type,
+                             std::move(symbol_section_sp), mangled,
+                             has_suffix});
+  }
+  chunk.end = i;
+  chunk.complete = i == last;
+  return chunk;
+}
+
+// private
+unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
+                                     SectionList *section_list,
+                                     const size_t num_symbols,
+                                     const DataExtractor &symtab_data,
+                                     const DataExtractor &strtab_data) {
+  // On Android the oatdata and the oatexec symbols in the oat and odex files
+  // covers the full .text section what causes issues with displaying unusable
+  // symbol name to the user and very slow unwinding speed because the
+  // instruction emulation based unwind plans try to emulate all instructions
+  // in these symbols. Don't add these symbols to the symbol list as they have
+  // no use for the debugger and they are causing a lot of trouble. Filtering
+  // can't be restricted to Android because this special object file don't
+  // contain the note section specifying the environment to Android but the
+  // custom extension and file name makes it highly unlikely that this will
+  // collide with anything else.
+  ConstString file_extension = m_file.GetFileNameExtension();
+  bool skip_oatdata_oatexec = file_extension == ConstString(".oat") ||
+                              file_extension == ConstString(".odex");
+
+  ArchSpec arch = GetArchitecture();
+  ModuleSP module_sp(GetModule());
+  SectionList *module_section_list =
+      module_sp ? module_sp->GetSectionList() : nullptr;
+
+  // Resolve section indexes through a table rather than searching the
+  // section list for every symbol.
+  std::vector<SectionSP> sections_by_id(m_section_headers.size());
+  for (size_t id = 1; id < sections_by_id.size(); ++id)
+    sections_by_id[id] = section_list->FindSectionByID(id);
+
+  // Decoding the entries, interning their names and working out which
+  // language they're mangled in doesn't touch the object file, so large
+  // tables are split into chunks that are decoded concurrently.
+  const lldb::offset_t entsize =
+      symtab_data.GetAddressByteSize() == 4 ? sizeof(Elf32_Sym)
+                                            : sizeof(Elf64_Sym);
+  const size_t num_chunks = std::max<size_t>(
+      1, std::min<size_t>(GetHardwareConcurrencyHint(),
+                          num_symbols / g_min_symbols_per_chunk));
+  const size_t chunk_size = (num_symbols + num_chunks - 1) / num_chunks;
+  std::vector<DecodedELFSymbolChunk> chunks(num_chunks);
+  TaskMapOverInt(0, num_chunks, [&](size_t idx) {
+    const size_t first = std::min(idx * chunk_size, num_symbols);
+    chunks[idx] = DecodeELFSymbols(
+        first, std::min(first + chunk_size, num_symbols), symtab_data,
+        strtab_data, entsize, sections_by_id, skip_oatdata_oatexec);
+  });
+
+  size_t num_decoded = 0;
+  for (const DecodedELFSymbolChunk &chunk : chunks)
+    num_decoded += chunk.symbols.size();
+  symtab->Reserve(symtab->GetNumSymbols() + num_decoded);
+
+  // Local cache to avoid doing a FindSectionByName for each symbol. The "const
+  // char*" key must came from a ConstString object so they can be compared by
+  // pointer
+  std::unordered_map<const char *, lldb::SectionSP> section_name_to_section;
+
+  // Everything else updates the object file and the symbol table, and
+  // happens in symbol table order.
+  unsigned i = 0;
+  for (DecodedELFSymbolChunk &chunk : chunks) {
+    for (DecodedELFSymbol &decoded : chunk.symbols) {
+      ELFSymbol &symbol = decoded.symbol;
+      const char *symbol_name = decoded.name;
+      SymbolType symbol_type = decoded.type;
+      SectionSP symbol_section_sp = std::move(decoded.section_sp);
+      Elf64_Half shndx = symbol.st_shndx;
+
+      int64_t symbol_value_offset = 0;
+      uint32_t additional_flags = 0;
+
+      if (arch.IsValid()) {
+        if (arch.GetMachine() == llvm::Triple::arm) {
+          if (symbol.getBinding() == STB_LOCAL) {
+            char mapping_symbol = FindArmAarch64MappingSymbol(symbol_name);
+            if (symbol_type == eSymbolTypeCode) {
+              switch (mapping_symbol) {
+              case 'a':
+                // $a[.<any>]* - marks an ARM instruction sequence
+                m_address_class_map[symbol.st_value] = AddressClass::eCode;
+                break;
+              case 'b':
+              case 't':
+                // $b[.<any>]* - marks a THUMB BL instruction sequence
+                // $t[.<any>]* - marks a THUMB instruction sequence
+                m_address_class_map[symbol.st_value] =
+                    AddressClass::eCodeAlternateISA;
+                break;
+              case 'd':
+                // $d[.<any>]* - marks a data item sequence (e.g. lit pool)
+                m_address_class_map[symbol.st_value] = AddressClass::eData;
+                break;
+              }
+            }
+            if (mapping_symbol)
+              continue;
+          }
+        } else if (arch.GetMachine() == llvm::Triple::aarch64) {
+          if (symbol.getBinding() == STB_LOCAL) {
+            char mapping_symbol = FindArmAarch64MappingSymbol(symbol_name);
+            if (symbol_type == eSymbolTypeCode) {
+              switch (mapping_symbol) {
+              case 'x':
+                // $x[.<any>]* - marks an A64 instruction sequence
+                m_address_class_map[symbol.st_value] = AddressClass::eCode;
+                break;
+              case 'd':
+                // $d[.<any>]* - marks a data item sequence (e.g. lit pool)
+                m_address_class_map[symbol.st_value] = AddressClass::eData;
+                break;
+              }
+            }
+            if (mapping_symbol)
+              continue;
+          }
+        }
+
+        if (arch.GetMachine() == llvm::Triple::arm) {
+          if (symbol_type == eSymbolTypeCode) {
+            if (symbol.st_value & 1) {
+              // Subtracting 1 from the address effectively unsets the low
+              // order bit, which results in the address actually pointing to
+              // the beginning of the symbol. This delta will be used below in
+              // conjunction with symbol.st_value to produce the final
+              // symbol_value that we store in the symtab.
+              symbol_value_offset = -1;
+              m_address_class_map[symbol.st_value ^ 1] =
+                  AddressClass::eCodeAlternateISA;
+            } else {
+              // This address is ARM
+              m_address_class_map[symbol.st_value] = AddressClass::eCode;
+            }
+          }
+        }
+
+        /*
+         * MIPS:
+         * The bit #0 of an address is used for ISA mode (1 for microMIPS, 0
+         * for MIPS).
+         * This allows processor to switch between microMIPS and MIPS without
+         * any need
+         * for special mode-control register. However, apart from .debug_line,
+         * none of
+         * the ELF/DWARF sections set the ISA bit (for symbol or section). Use
+         * st_other
+         * flag to check whether the symbol is microMIPS and then set the
+         * address class
+         * accordingly.
+        */
+        const llvm::Triple::ArchType llvm_arch = arch.GetMachine();
+        if (llvm_arch == llvm::Triple::mips ||
+            llvm_arch == llvm::Triple::mipsel ||
+            llvm_arch == llvm::Triple::mips64 ||
+            llvm_arch == llvm::Triple::mips64el) {
+          if (IS_MICROMIPS(symbol.st_other))
+            m_address_class_map[symbol.st_value] =
+                AddressClass::eCodeAlternateISA;
+          else if ((symbol.st_value & 1) &&
+                   (symbol_type == eSymbolTypeCode)) {
+            symbol.st_value = symbol.st_value & (~1ull);
+            m_address_class_map[symbol.st_value] =
+                AddressClass::eCodeAlternateISA;
+          } else {
+            if (symbol_type == eSymbolTypeCode)
+              m_address_class_map[symbol.st_value] = AddressClass::eCode;
+            else if (symbol_type == eSymbolTypeData)
+              m_address_class_map[symbol.st_value] = AddressClass::eData;
+            else
+              m_address_class_map[symbol.st_value] = AddressClass::eUnknown;
+          }
+        }
+      }
+
+      // symbol_value_offset may contain 0 for ARM symbols or -1 for THUMB
+      // symbols. See above for more details.
+      uint64_t symbol_value = symbol.st_value + symbol_value_offset;
+
+      if (symbol_section_sp == nullptr && shndx == SHN_ABS &&
+          symbol.st_size != 0) {
+        // We don't have a section for a symbol with non-zero size. Create a
+        // new section for it so the address range covered by the symbol is
+        // also covered by the module (represented through the section list).
+        // It is needed so module lookup for the addresses covered by this
+        // symbol will be successfull. This case happens for absolute symbols.
+        ConstString fake_section_name(std::string(".absolute.") + symbol_name);
+        symbol_section_sp = std::make_shared<Section>(
+            module_sp, this, SHN_ABS, fake_section_name,
+            eSectionTypeAbsoluteAddress, symbol_value, symbol.st_size, 0, 0, 0,
+            SHF_ALLOC);
+
+        module_section_list->AddSection(symbol_section_sp);
+        section_list->AddSection(symbol_section_sp);
+      }
+
+      if (symbol_section_sp &&
+          CalculateType() != ObjectFile::Type::eTypeObjectFile)
+        symbol_value -= symbol_section_sp->GetFileAddress();
+
+      if (symbol_section_sp && module_section_list &&
+          module_section_list != section_list) {
+        ConstString sect_name = symbol_section_sp->GetName();
+        auto section_it = section_name_to_section.find(sect_name.GetCString());
+        if (section_it == section_name_to_section.end())
+          section_it =
+              section_name_to_section
+                  .emplace(sect_name.GetCString(),
+                           module_section_list->FindSectionByName(sect_name))
+                  .first;
+        if (section_it->second)
+          symbol_section_sp = section_it->second;
+      }
+
+      bool is_global = symbol.getBinding() == STB_GLOBAL;
+      uint32_t flags = symbol.st_other << 8 | symbol.st_info | additional_flags;
+
+      // In ELF all symbol should have a valid size but it is not true for some
+      // function symbols coming from hand written assembly. As none of the
+      // function symbol should have 0 size we try to calculate the size for
+      // these symbols in the symtab with saying that their original size is
+      // not valid.
+      bool symbol_size_valid =
+          symbol.st_size != 0 || symbol.getType() != STT_FUNC;
+
+      Symbol dc_symbol(
+          decoded.index + start_id, // ID is the original symbol table index.
+          decoded.mangled,
+          symbol_type,                    // Type of this symbol
+          is_global,                      // Is this globally visible?
+          false,                          // Is this symbol debug info?
+          false,                          // Is this symbol a trampoline?
+          false,                          // Is this symbol artificial?
+          AddressRange(symbol_section_sp, // Section in which this symbol is
+                                          // defined or null.
+                       symbol_value,      // Offset in section or symbol value.
+                       symbol.st_size),   // Size in bytes of this symbol.
+          symbol_size_valid,              // Symbol size is valid
+          decoded.has_suffix,             // Contains linker annotations?
+          flags);                         // Symbol flags.
+      symtab->AddSymbol(dc_symbol);
+    }
+
+    // Like a serial parse, stop at the first entry that couldn't be parsed.
+    i = chunk.end;
+    if (!chunk.complete)
+      break;
   }
   return i;
 }
@@ -2491,6 +2560,8 @@ static unsigned ParsePLTRelocations(
     reloc_symbol = ELFRelocation::RelocSymbol64;
   }
 
+  symbol_table->Reserve(symbol_table->GetNumSymbols() + num_relocations);
+
   unsigned slot_type = hdr->GetRelocationJumpSlotType();
   unsigned i;
   for (i = 0; i < num_relocations; ++i) {
@@ -2758,6 +2829,9 @@ Symtab *ObjectFileELF::GetSymtab() {
     if (!section_list)
       return NULL;
 
+    static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+    Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+
     uint64_t symbol_id = 0;
     std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
 
@@ -3349,18 +3423,172 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
   if (result == 0 || !section->Test(SHF_COMPRESSED))
     return result;
 
+  DataBufferSP buffer_sp = GetDecompressedSectionData(section);
+  if (!buffer_sp) {
+    section_data.Clear();
+    return 0;
+  }
+  section_data.SetData(buffer_sp);
+  return buffer_sp->GetByteSize();
+}
+
+// The sections that parsing any DWARF unit reads. The others, like line
+// tables, ranges or accelerator tables, are only decompressed if they are
+// actually read.
+static bool IsPrefetchedSection(const Section &section) {
+  switch (section.GetType()) {
+  case eSectionTypeDWARFDebugAbbrev:
+  case eSectionTypeDWARFDebugInfo:
+  case eSectionTypeDWARFDebugStr:
+  case eSectionTypeDWARFDebugStrOffsets:
+    return true;
+  default:
+    return false;
+  }
+}
+
+DataBufferSP ObjectFileELF::GetDecompressedSectionData(Section *section) {
+  std::unique_lock<std::mutex> lock(m_decompressed_sections_mutex);
+  if (!m_prefetched_compressed_sections && IsPrefetchedSection(*section)) {
+    m_prefetched_compressed_sections = true;
+    PrefetchCompressedSections(section);
+  }
+
+  // Wait if another thread, possibly a prefetch task, is decompressing it.
+  DecompressedSection *entry;
+  m_decompressed_sections_cond.wait(lock, [&] {
+    entry = &m_decompressed_sections[section];
+    return entry->state != DecompressedSection::eRunning;
+  });
+  if (entry->state == DecompressedSection::eDone)
+    return entry->data_sp;
+  entry->state = DecompressedSection::eRunning;
+  lock.unlock();
+
+  DataBufferSP data_sp = DecompressSection(section);
+
+  lock.lock();
+  entry = &m_decompressed_sections[section];
+  entry->state = DecompressedSection::eDone;
+  entry->data_sp = data_sp;
+  m_decompressed_sections_cond.notify_all();
+  return data_sp;
+}
+
+void ObjectFileELF::PrefetchCompressedSections(const Section *section) {
+  // Relocating a section needs the symbol table, and so the module lock,
+  // which the thread waiting for the decompressed data might hold.
+  ModuleSP module_sp = GetModule();
+  if (!module_sp || CalculateType() == eTypeObjectFile || !m_sections_up)
+    return;
+
+  std::vector<SectionSP> sections;
+  std::function<void(const SectionList &)> collect =
+      [&](const SectionList &section_list) {
+        for (size_t i = 0; i < section_list.GetSize(); ++i) {
+          SectionSP section_sp = section_list.GetSectionAtIndex(i);
+          collect(section_sp->GetChildren());
+          if (section_sp.get() != section &&
+              section_sp->Test(SHF_COMPRESSED) &&
+              IsPrefetchedSection(*section_sp) &&
+              !m_decompressed_sections.count(section_sp.get()))
+            sections.push_back(section_sp);
+        }
+      };
+  collect(*m_sections_up);
+  if (sections.empty())
+    return;
+
+  // The tasks share the global task pool with the rest of the debugger. A
+  // task holds on to the module while it runs, so that the module can't be
+  // destroyed from underneath it; one that starts after this object file is
+  // gone does nothing.
+  m_prefetch_state = std::make_shared<PrefetchState>();
+  std::shared_ptr<PrefetchState> state = m_prefetch_state;
+  ModuleWP module_wp = module_sp;
+  for (const SectionSP &section_sp : sections) {
+    TaskPool::AddTask([this, state, module_wp, section_sp] {
+      ModuleSP module_sp;
+      {
+        std::lock_guard<std::mutex> guard(state->mutex);
+        module_sp = module_wp.lock();
+        if (state->cancelled || !module_sp)
+          return;
+        ++state->num_running;
+      }
+      GetDecompressedSectionData(section_sp.get());
+      std::lock_guard<std::mutex> guard(state->mutex);
+      --state->num_running;
+      state->cond.notify_all();
+    });
+  }
+}
+
+DataBufferSP ObjectFileELF::DecompressSection(Section *section) {
+  // The object file can outlive its module, so there may be nobody to warn.
+  ModuleSP module_sp = GetModule();
+  DataExtractor section_data;
+  if (ObjectFile::ReadSectionData(section, section_data) == 0)
+    return nullptr;
+
+  lldb::offset_t offset = 0;
+  if (section_data.GetU32(&offset) == LLDB_ELFCOMPRESS_ZSTD) {
+    // The rest of the Elf32_Chdr/Elf64_Chdr.
+    uint64_t size;
+    if (GetAddressByteSize() == 8) {
+      offset = 8;
+      size = section_data.GetU64(&offset);
+      offset = 24;
+    } else {
+      size = section_data.GetU32(&offset);
+      offset = 12;
+    }
+    if (offset > section_data.GetByteSize()) {
+      if (module_sp)
+        module_sp->ReportWarning(
+            "Unable to initialize decompressor for section '%s': corrupted "
+            "compressed section header",
+            section->GetName().GetCString());
+      return nullptr;
+    }
+#if defined(HAVE_LIBZSTD)
+    auto buffer_sp = std::make_shared<DataBufferHeap>(size, 0);
+    size_t result = ZSTD_decompress(
+        buffer_sp->GetBytes(), buffer_sp->GetByteSize(),
+        section_data.GetDataStart() + offset,
+        section_data.GetByteSize() - offset);
+    if (ZSTD_isError(result) || result != size) {
+      if (module_sp)
+        module_sp->ReportWarning(
+            "Decompression of section '%s' failed: %s",
+            section->GetName().GetCString(),
+            ZSTD_isError(result) ? ZSTD_getErrorName(result)
+                                 : "unexpected decompressed size");
+      return nullptr;
+    }
+    return buffer_sp;
+#else
+    if (module_sp)
+      module_sp->ReportWarning(
+          "Unable to decompress section '%s': LLDB was built without zstd "
+          "support",
+          section->GetName().GetCString());
+    return nullptr;
+#endif
+  }
+
   auto Decompressor = llvm::object::Decompressor::create(
       section->GetName().GetStringRef(),
       {reinterpret_cast<const char *>(section_data.GetDataStart()),
        size_t(section_data.GetByteSize())},
       GetByteOrder() == eByteOrderLittle, GetAddressByteSize() == 8);
   if (!Decompressor) {
-    GetModule()->ReportWarning(
-        "Unable to initialize decompressor for section '%s': %s",
-        section->GetName().GetCString(),
-        llvm::toString(Decompressor.takeError()).c_str());
-    section_data.Clear();
-    return 0;
+    std::string message = llvm::toString(Decompressor.takeError());
+    if (module_sp)
+      module_sp->ReportWarning(
+          "Unable to initialize decompressor for section '%s': %s",
+          section->GetName().GetCString(), message.c_str());
+    return nullptr;
   }
 
   auto buffer_sp =
@@ -3368,16 +3596,14 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
   if (auto error = Decompressor->decompress(
           {reinterpret_cast<char *>(buffer_sp->GetBytes()),
            size_t(buffer_sp->GetByteSize())})) {
-    GetModule()->ReportWarning(
-        "Decompression of section '%s' failed: %s",
-        section->GetName().GetCString(),
-        llvm::toString(std::move(error)).c_str());
-    section_data.Clear();
-    return 0;
+    std::string message = llvm::toString(std::move(error));
+    if (module_sp)
+      module_sp->ReportWarning("Decompression of section '%s' failed: %s",
+                               section->GetName().GetCString(),
+                               message.c_str());
+    return nullptr;
   }
-
-  section_data.SetData(buffer_sp);
-  return buffer_sp->GetByteSize();
+  return buffer_sp;
 }
 
 llvm::ArrayRef<ELFProgramHeader> ObjectFileELF::ProgramHeaders() {
@@ -11,6 +11,9 @@
 
 #include <stdint.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "lldb/Symbol/ObjectFile.h"
@@ -18,6 +21,7 @@
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/UUID.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/DenseMap.h"
 
 #include "ELFHeader.h"
 
@@ -221,6 +225,30 @@ private:
   /// The address class for each symbol in the elf file
   FileAddressToAddressClassMap m_address_class_map;
 
+  /// Decompressed contents of the SHF_COMPRESSED sections, or null for the
+  /// ones that couldn't be decompressed. Debug info readers ask for small
+  /// pieces of the same sections over and over.
+  struct DecompressedSection {
+    enum State { ePending, eRunning, eDone };
+    State state = ePending;
+    lldb::DataBufferSP data_sp;
+  };
+  llvm::DenseMap<const lldb_private::Section *, DecompressedSection>
+      m_decompressed_sections;
+  std::mutex m_decompressed_sections_mutex;
+  std::condition_variable m_decompressed_sections_cond;
+  bool m_prefetched_compressed_sections = false;
+
+  /// Tracks the prefetch tasks on the task pool, which can outlive this
+  /// object file when they haven't started yet.
+  struct PrefetchState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool cancelled = false;
+    size_t num_running = 0;
+  };
+  std::shared_ptr<PrefetchState> m_prefetch_state;
+
   /// Returns the index of the given section header.
   size_t SectionIndex(const SectionHeaderCollIter &I);
 
@@ -314,6 +342,17 @@ private:
                             lldb_private::DataExtractor &debug_data,
                             lldb_private::Section *rel_section);
 
+  /// Returns the contents of the SHF_COMPRESSED \a section, decompressing it
+  /// on first use, or null if it can't be decompressed.
+  lldb::DataBufferSP GetDecompressedSectionData(lldb_private::Section *section);
+
+  lldb::DataBufferSP DecompressSection(lldb_private::Section *section);
+
+  /// Starts decompressing the other compressed sections that are read along
+  /// with \a section, in the background. Must be called with
+  /// m_decompressed_sections_mutex held.
+  void PrefetchCompressedSections(const lldb_private::Section *section);
+
   /// Loads the section name string table into m_shstr_data.  Returns the
   /// number of bytes constituting the table.
   size_t GetSectionHeaderStringTable();
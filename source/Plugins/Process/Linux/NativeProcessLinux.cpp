@@ -598,6 +598,11 @@ void NativeProcessLinux::MonitorSIGTRAP(const siginfo_t &info,
 
     // Exec clears any pending notifications.
     m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+    m_step_over_tid = LLDB_INVALID_THREAD_ID;
+    m_step_over_addr = LLDB_INVALID_ADDRESS;
+    m_step_over_stepping = false;
+    m_step_over_held_threads.clear();
+    m_abandoned_step_over_tid = LLDB_INVALID_THREAD_ID;
 
     // Remove all but the main thread here.  Linux fork creates a new process
     // which only copies the main thread.
@@ -662,6 +667,13 @@ void NativeProcessLinux::MonitorSIGTRAP(const siginfo_t &info,
   case TRAP_TRACE:  // We receive this on single stepping.
   case TRAP_HWBKPT: // We receive this on watchpoint hit
   {
+    const bool stepped_over_breakpoint =
+        m_step_over_stepping && thread.GetID() == m_step_over_tid;
+    const bool abandoned_step_over =
+        thread.GetID() == m_abandoned_step_over_tid;
+    if (abandoned_step_over)
+      m_abandoned_step_over_tid = LLDB_INVALID_THREAD_ID;
+
     // If a watchpoint was hit, report it
     uint32_t wp_index;
     Status error = thread.GetRegisterContext().GetWatchpointHitIndex(
@@ -689,6 +701,19 @@ void NativeProcessLinux::MonitorSIGTRAP(const siginfo_t &info,
       break;
     }
 
+    // The step was ours, the client thinks the threads are running.
+    if (stepped_over_breakpoint) {
+      FinishBreakpointStepOver(/*resume_threads=*/true);
+      break;
+    }
+
+    // The step was ours, but another thread's stop is being reported.
+    if (abandoned_step_over) {
+      thread.SetStoppedWithNoReason();
+      SignalIfAllThreadsStopped();
+      break;
+    }
+
     // Otherwise, report step over
     MonitorTrace(thread);
     break;
@@ -753,6 +778,8 @@ void NativeProcessLinux::MonitorBreakpoint(NativeThreadLinux &thread) {
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
   LLDB_LOG(log, "received breakpoint event, pid = {0}", thread.GetID());
 
+  const StateType resume_state = thread.GetState();
+
   // Mark the thread as stopped at breakpoint.
   thread.SetStoppedByBreakpoint();
   FixupBreakpointPCAsNeeded(thread);
@@ -760,10 +787,128 @@ void NativeProcessLinux::MonitorBreakpoint(NativeThreadLinux &thread) {
   if (m_threads_stepping_with_breakpoint.find(thread.GetID()) !=
       m_threads_stepping_with_breakpoint.end())
     thread.SetStoppedByTrace();
+  else if (resume_state == eStateRunning &&
+           StepOverFalseBreakpointCondition(thread))
+    return;
 
   StopRunningThreads(thread.GetID());
 }
 
+bool NativeProcessLinux::StepOverFalseBreakpointCondition(
+    NativeThreadLinux &thread) {
+  // Don't get in the way of a stop that is already under way, and step over
+  // one breakpoint at a time.
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID ||
+      m_step_over_tid != LLDB_INVALID_THREAD_ID ||
+      !SupportHardwareSingleStepping())
+    return false;
+
+  const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+  if (ShouldReportBreakpointHit(thread, pc))
+    return false;
+
+  // The trap has to be out of memory while this thread steps over the
+  // original instruction. Stop every other thread first, so that none of
+  // them can run through the breakpoint unnoticed in the meantime.
+  m_step_over_tid = thread.GetID();
+  m_step_over_addr = pc;
+  m_step_over_stepping = false;
+  for (const auto &thread_up : m_threads) {
+    if (StateIsRunningState(thread_up->GetState())) {
+      m_step_over_held_threads.insert(thread_up->GetID());
+      static_cast<NativeThreadLinux *>(thread_up.get())->RequestStop();
+    }
+  }
+
+  StepOverBreakpointIfThreadsStopped();
+  return true;
+}
+
+void NativeProcessLinux::StepOverBreakpointIfThreadsStopped() {
+  if (m_step_over_tid == LLDB_INVALID_THREAD_ID || m_step_over_stepping)
+    return;
+
+  for (lldb::tid_t tid : m_step_over_held_threads) {
+    NativeThreadLinux *held_thread = GetThreadByID(tid);
+    if (held_thread && StateIsRunningState(held_thread->GetState()))
+      return; // Some threads are still running. Don't step yet.
+  }
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  const lldb::tid_t tid = m_step_over_tid;
+  NativeThreadLinux *thread = GetThreadByID(tid);
+  if (!thread) {
+    FinishBreakpointStepOver(/*resume_threads=*/true);
+    return;
+  }
+
+  Status error = WriteSoftwareBreakpointOpcodes(m_step_over_addr,
+                                                /*trap=*/false);
+  if (error.Success()) {
+    m_step_over_stepping = true;
+    error = ResumeThread(*thread, eStateStepping, LLDB_INVALID_SIGNAL_NUMBER);
+  }
+  if (error.Fail()) {
+    // Let the client decide about the breakpoint instead. Everything else is
+    // stopped already, so this reports the hit right away.
+    LLDB_LOG(log, "pid {0} tid {1}: failed to step over {2:x}: {3}", GetID(),
+             tid, m_step_over_addr, error);
+    StopRunningThreads(tid);
+  }
+}
+
+void NativeProcessLinux::FinishBreakpointStepOver(bool resume_threads) {
+  if (m_step_over_tid == LLDB_INVALID_THREAD_ID)
+    return;
+
+  if (m_step_over_stepping && m_software_breakpoints.count(m_step_over_addr)) {
+    Status error = WriteSoftwareBreakpointOpcodes(m_step_over_addr,
+                                                  /*trap=*/true);
+    if (error.Fail()) {
+      Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+      LLDB_LOG(log, "pid {0}: failed to reinsert trap at {1:x}: {2}", GetID(),
+               m_step_over_addr, error);
+    }
+  }
+
+  const lldb::tid_t tid = m_step_over_tid;
+  std::unordered_set<lldb::tid_t> held_threads;
+  held_threads.swap(m_step_over_held_threads);
+  m_step_over_tid = LLDB_INVALID_THREAD_ID;
+  m_step_over_addr = LLDB_INVALID_ADDRESS;
+  m_step_over_stepping = false;
+  if (!resume_threads)
+    return;
+
+  // The client thinks all of these are running.
+  if (NativeThreadLinux *thread = GetThreadByID(tid))
+    ResumeThread(*thread, eStateRunning, LLDB_INVALID_SIGNAL_NUMBER);
+  for (lldb::tid_t held_tid : held_threads) {
+    NativeThreadLinux *held_thread = GetThreadByID(held_tid);
+    if (held_thread && !StateIsRunningState(held_thread->GetState()))
+      ResumeThread(*held_thread, eStateRunning, LLDB_INVALID_SIGNAL_NUMBER);
+  }
+}
+
+void NativeProcessLinux::AbandonBreakpointStepOver(
+    lldb::tid_t triggering_tid) {
+  const lldb::tid_t tid = m_step_over_tid;
+  FinishBreakpointStepOver(/*resume_threads=*/false);
+  if (tid == LLDB_INVALID_THREAD_ID || tid == triggering_tid)
+    return;
+
+  // The thread stopped at a breakpoint whose condition was false, which
+  // isn't a reason to report it as stopped there. If it is still stepping,
+  // it stops either at the end of its step or through the stop request.
+  NativeThreadLinux *thread = GetThreadByID(tid);
+  if (!thread)
+    return;
+  if (StateIsRunningState(thread->GetState()))
+    m_abandoned_step_over_tid = tid;
+  else
+    thread->SetStoppedWithNoReason();
+}
+
 void NativeProcessLinux::MonitorWatchpoint(NativeThreadLinux &thread,
                                            uint32_t wp_index) {
   Log *log(
@@ -808,6 +953,10 @@ void NativeProcessLinux::MonitorSignal(const siginfo_t &info,
     // This is a tgkill()-based stop.
     LLDB_LOG(log, "pid {0} tid {1}, thread stopped", GetID(), thread.GetID());
 
+    // The thread stopped before its step did, so the step won't end.
+    if (thread.GetID() == m_abandoned_step_over_tid)
+      m_abandoned_step_over_tid = LLDB_INVALID_THREAD_ID;
+
     // Check that we're not already marked with a stop reason. Note this thread
     // really shouldn't already be marked as stopped - if we were, that would
     // imply that the kernel signaled us with the thread stopping which we
@@ -832,6 +981,10 @@ void NativeProcessLinux::MonitorSignal(const siginfo_t &info,
 
         SetCurrentThreadID(thread.GetID());
         SignalIfAllThreadsStopped();
+      } else if (m_step_over_held_threads.count(thread.GetID())) {
+        // Another thread is stepping over a breakpoint once this one stops.
+        thread.SetStoppedWithNoReason();
+        StepOverBreakpointIfThreadsStopped();
       } else {
         // We can end up here if stop was initiated by LLGS but by this time a
         // thread stop has occurred - maybe initiated by another event.
@@ -1596,6 +1749,15 @@ bool NativeProcessLinux::StopTrackingThread(lldb::tid_t thread_id) {
 
   if (found)
     StopTracingForThread(thread_id);
+
+  // A thread that is gone can't hold up or take part in a breakpoint step
+  // over.
+  if (thread_id == m_abandoned_step_over_tid)
+    m_abandoned_step_over_tid = LLDB_INVALID_THREAD_ID;
+  if (thread_id == m_step_over_tid)
+    FinishBreakpointStepOver(/*resume_threads=*/true);
+  else if (m_step_over_held_threads.erase(thread_id))
+    StepOverBreakpointIfThreadsStopped();
   SignalIfAllThreadsStopped();
   return found;
 }
@@ -1718,6 +1880,10 @@ void NativeProcessLinux::StopRunningThreads(const lldb::tid_t triggering_tid) {
   LLDB_LOG(log, "about to process event: (triggering_tid: {0})",
            triggering_tid);
 
+  // A real stop takes over from a breakpoint step over. The threads held for
+  // it stay stopped and the stepping thread is stopped like the others.
+  AbandonBreakpointStepOver(triggering_tid);
+
   m_pending_notification_tid = triggering_tid;
 
   // Request a stop for all the thread stops that need to be stopped and are
@@ -1769,6 +1935,11 @@ void NativeProcessLinux::ThreadWasCreated(NativeThreadLinux &thread) {
     // We will need to wait for this new thread to stop as well before firing
     // the notification.
     thread.RequestStop();
+  } else if (m_step_over_tid != LLDB_INVALID_THREAD_ID &&
+             StateIsRunningState(thread.GetState())) {
+    // Hold it like the others while a breakpoint is being stepped over.
+    m_step_over_held_threads.insert(thread.GetID());
+    thread.RequestStop();
   }
 }
 
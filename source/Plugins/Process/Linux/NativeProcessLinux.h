@@ -146,6 +146,18 @@ private:
   // the relevan breakpoint
   std::map<lldb::tid_t, lldb::addr_t> m_threads_stepping_with_breakpoint;
 
+  // The thread stepping over a breakpoint whose condition was false, and the
+  // address of the breakpoint. The other threads that were running are held
+  // stopped until the step finishes, so that none of them can run past the
+  // breakpoint while its trap is out of memory.
+  lldb::tid_t m_step_over_tid = LLDB_INVALID_THREAD_ID;
+  lldb::addr_t m_step_over_addr = LLDB_INVALID_ADDRESS;
+  bool m_step_over_stepping = false;
+  std::unordered_set<lldb::tid_t> m_step_over_held_threads;
+  // A thread whose step over was given up for another thread's stop while
+  // it was still stepping. The end of that step isn't a stop reason.
+  lldb::tid_t m_abandoned_step_over_tid = LLDB_INVALID_THREAD_ID;
+
   // ---------------------------------------------------------------------
   // Private Instance Methods
   // ---------------------------------------------------------------------
@@ -168,6 +180,14 @@ private:
 
   void MonitorBreakpoint(NativeThreadLinux &thread);
 
+  bool StepOverFalseBreakpointCondition(NativeThreadLinux &thread);
+
+  void StepOverBreakpointIfThreadsStopped();
+
+  void FinishBreakpointStepOver(bool resume_threads);
+
+  void AbandonBreakpointStepOver(lldb::tid_t triggering_tid);
+
   void MonitorWatchpoint(NativeThreadLinux &thread, uint32_t wp_index);
 
   void MonitorSignal(const siginfo_t &info, NativeThreadLinux &thread,
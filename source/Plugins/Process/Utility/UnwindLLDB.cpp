@@ -16,6 +16,7 @@
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/Timer.h"
 
 #include "RegisterContextLLDB.h"
 #include "UnwindLLDB.h"
@@ -332,6 +333,9 @@ bool UnwindLLDB::AddOneMoreFrame(ABI *abi) {
   if (m_unwind_complete)
     return false;
 
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+
   CursorSP new_frame = m_candidate_frame;
   if (new_frame == nullptr)
     new_frame = GetOneMoreFrame(abi);
@@ -0,0 +1,699 @@
+//===-- GDBRemoteBreakpointCondition.cpp ------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "GDBRemoteBreakpointCondition.h"
+
+#include "Plugins/Process/Utility/DynamicRegisterInfo.h"
+#include "lldb/Core/Address.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Expression/DWARFExpression.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/CompilerType.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/Language.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/DataExtractor.h"
+
+#include "llvm/ADT/StringExtras.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::process_gdb_remote;
+
+namespace {
+
+// The C type of a value on the agent expression stack. The stack is 64 bits
+// wide; narrower values are kept sign or zero extended to 64 bits according
+// to their type, so only operations that can carry into the upper bits
+// need to extend their result again.
+struct ValueType {
+  ValueType(unsigned bits = 32, bool is_signed = true)
+      : bits(bits), is_signed(is_signed) {}
+
+  unsigned bits;
+  bool is_signed;
+  bool is_pointer = false;
+  // The integer a pointer points to, or 0 if it can't be dereferenced.
+  size_t pointee_size = 0;
+  bool pointee_signed = false;
+};
+
+enum class BinaryOp {
+  LogicalOr,
+  LogicalAnd,
+  BitOr,
+  BitXor,
+  BitAnd,
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+  Shl,
+  Shr,
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Rem,
+};
+
+struct BinaryOperator {
+  llvm::StringLiteral token;
+  BinaryOp op;
+  unsigned precedence;
+};
+
+// Longer tokens come first so that "<=" isn't lexed as "<".
+static const BinaryOperator g_binary_operators[] = {
+    {"||", BinaryOp::LogicalOr, 1},   {"&&", BinaryOp::LogicalAnd, 2},
+    {"==", BinaryOp::Equal, 6},       {"!=", BinaryOp::NotEqual, 6},
+    {"<=", BinaryOp::LessEqual, 7},   {">=", BinaryOp::GreaterEqual, 7},
+    {"<<", BinaryOp::Shl, 8},         {">>", BinaryOp::Shr, 8},
+    {"|", BinaryOp::BitOr, 3},        {"^", BinaryOp::BitXor, 4},
+    {"&", BinaryOp::BitAnd, 5},       {"<", BinaryOp::Less, 7},
+    {">", BinaryOp::Greater, 7},      {"+", BinaryOp::Add, 9},
+    {"-", BinaryOp::Sub, 9},          {"*", BinaryOp::Mul, 10},
+    {"/", BinaryOp::Div, 10},         {"%", BinaryOp::Rem, 10},
+};
+
+static llvm::Error MakeError(const llvm::Twine &message) {
+  return llvm::make_error<llvm::StringError>(message,
+                                             llvm::inconvertibleErrorCode());
+}
+
+class ConditionCompiler {
+public:
+  ConditionCompiler(llvm::StringRef text, const Address &address,
+                    Target &target, const DynamicRegisterInfo &register_info)
+      : m_text(text), m_target(target), m_register_info(register_info) {
+    address.CalculateSymbolContext(&m_sc);
+  }
+
+  llvm::Expected<AgentExpression> Compile() {
+    if (!m_sc.comp_unit ||
+        !Language::LanguageIsCFamily(m_sc.comp_unit->GetLanguage()))
+      return MakeError("only C family languages are supported");
+
+    ValueType type;
+    if (llvm::Error error = ParseBinary(1, type))
+      return std::move(error);
+    SkipSpaces();
+    if (m_pos != m_text.size())
+      return MakeError("unsupported syntax at '" + m_text.substr(m_pos) +
+                       "'");
+    m_expr.Emit(AgentExpression::eOpEnd);
+    // Jump targets are 16 bits.
+    if (m_expr.GetSize() > UINT16_MAX)
+      return MakeError("condition is too long");
+    return std::move(m_expr);
+  }
+
+private:
+  //------------------------------------------------------------------
+  // Lexing
+  //------------------------------------------------------------------
+  void SkipSpaces() {
+    while (m_pos < m_text.size() && llvm::isSpace(m_text[m_pos]))
+      ++m_pos;
+  }
+
+  bool Consume(llvm::StringRef token) {
+    SkipSpaces();
+    if (!m_text.substr(m_pos).startswith(token))
+      return false;
+    m_pos += token.size();
+    return true;
+  }
+
+  llvm::StringRef ConsumeWhile(bool (*predicate)(char)) {
+    const size_t start = m_pos;
+    while (m_pos < m_text.size() && predicate(m_text[m_pos]))
+      ++m_pos;
+    return m_text.slice(start, m_pos);
+  }
+
+  static bool IsIdentifierChar(char c) {
+    return llvm::isAlnum(c) || c == '_';
+  }
+
+  const BinaryOperator *PeekBinaryOperator() {
+    SkipSpaces();
+    llvm::StringRef rest = m_text.substr(m_pos);
+    for (const BinaryOperator &op : g_binary_operators)
+      if (rest.startswith(op.token))
+        return &op;
+    return nullptr;
+  }
+
+  //------------------------------------------------------------------
+  // Parsing. Each Parse function emits the code for what it parsed and
+  // returns the type of the value it left on the stack.
+  //------------------------------------------------------------------
+  llvm::Error ParseBinary(unsigned min_precedence, ValueType &lhs) {
+    if (llvm::Error error = ParseUnary(lhs))
+      return error;
+
+    while (const BinaryOperator *op = PeekBinaryOperator()) {
+      if (op->precedence < min_precedence)
+        break;
+      m_pos += op->token.size();
+
+      // && and || only evaluate their right hand side when they have to, so
+      // that "ptr && *ptr" doesn't read through a null pointer.
+      size_t short_circuit_jump = 0;
+      if (op->op == BinaryOp::LogicalOr || op->op == BinaryOp::LogicalAnd)
+        short_circuit_jump = m_expr.EmitJump(AgentExpression::eOpIfGoto);
+      if (op->op == BinaryOp::LogicalAnd) {
+        // lhs was false: the result is 0.
+        m_expr.EmitConstant(0);
+        const size_t end_jump = m_expr.EmitJump(AgentExpression::eOpGoto);
+        m_expr.PatchJump(short_circuit_jump, m_expr.GetSize());
+        short_circuit_jump = end_jump;
+      }
+
+      ValueType rhs;
+      if (llvm::Error error = ParseBinary(op->precedence + 1, rhs))
+        return error;
+
+      switch (op->op) {
+      case BinaryOp::LogicalOr: {
+        EmitBool();
+        const size_t end_jump = m_expr.EmitJump(AgentExpression::eOpGoto);
+        // lhs was true: the result is 1.
+        m_expr.PatchJump(short_circuit_jump, m_expr.GetSize());
+        m_expr.EmitConstant(1);
+        m_expr.PatchJump(end_jump, m_expr.GetSize());
+        lhs = ValueType();
+      } break;
+      case BinaryOp::LogicalAnd:
+        EmitBool();
+        m_expr.PatchJump(short_circuit_jump, m_expr.GetSize());
+        lhs = ValueType();
+        break;
+      default:
+        if (llvm::Error error = EmitBinary(op->op, lhs, rhs))
+          return error;
+        break;
+      }
+    }
+    return llvm::Error::success();
+  }
+
+  llvm::Error ParseUnary(ValueType &type) {
+    if (Consume("!")) {
+      if (llvm::Error error = ParseUnary(type))
+        return error;
+      m_expr.Emit(AgentExpression::eOpLogNot);
+      type = ValueType();
+      return llvm::Error::success();
+    }
+
+    if (Consume("-")) {
+      if (llvm::Error error = ParseUnary(type))
+        return error;
+      if (type.is_pointer)
+        return MakeError("can't negate a pointer");
+      // 0 - value
+      m_expr.EmitConstant(0);
+      m_expr.Emit(AgentExpression::eOpSwap);
+      m_expr.Emit(AgentExpression::eOpSub);
+      Normalize(type);
+      return llvm::Error::success();
+    }
+
+    if (Consume("~")) {
+      if (llvm::Error error = ParseUnary(type))
+        return error;
+      if (type.is_pointer)
+        return MakeError("can't complement a pointer");
+      m_expr.Emit(AgentExpression::eOpBitNot);
+      Normalize(type);
+      return llvm::Error::success();
+    }
+
+    if (Consume("*")) {
+      ValueType pointer;
+      if (llvm::Error error = ParseUnary(pointer))
+        return error;
+      if (!pointer.is_pointer || pointer.pointee_size == 0)
+        return MakeError("can only dereference pointers to integers");
+      if (!m_expr.EmitLoad(pointer.pointee_size))
+        return MakeError("unsupported pointee size");
+      type = EmitInteger(pointer.pointee_size, pointer.pointee_signed,
+                         /*needs_mask=*/false);
+      return llvm::Error::success();
+    }
+
+    return ParsePrimary(type);
+  }
+
+  llvm::Error ParsePrimary(ValueType &type) {
+    SkipSpaces();
+    if (m_pos == m_text.size())
+      return MakeError("unexpected end of condition");
+
+    const char c = m_text[m_pos];
+    if (c == '(') {
+      ++m_pos;
+      if (llvm::Error error = ParseBinary(1, type))
+        return error;
+      if (!Consume(")"))
+        return MakeError("expected ')'");
+      return llvm::Error::success();
+    }
+
+    if (llvm::isDigit(c))
+      return ParseNumber(type);
+
+    if (c == '$') {
+      ++m_pos;
+      return ParseRegister(ConsumeWhile(IsIdentifierChar), type);
+    }
+
+    if (IsIdentifierChar(c))
+      return ParseVariable(ConsumeWhile(IsIdentifierChar), type);
+
+    return MakeError("unsupported syntax at '" + m_text.substr(m_pos) + "'");
+  }
+
+  llvm::Error ParseNumber(ValueType &type) {
+    llvm::StringRef token = ConsumeWhile(IsIdentifierChar);
+    llvm::StringRef digits = token.rtrim("uUlL");
+    llvm::StringRef suffix = token.drop_front(digits.size());
+    const bool is_unsigned = suffix.find_first_of("uU") != llvm::StringRef::npos;
+    const bool is_long = suffix.find_first_of("lL") != llvm::StringRef::npos;
+    // Decimal literals without a 'u' suffix never become unsigned int.
+    const bool is_decimal = !digits.startswith("0") || digits == "0";
+
+    uint64_t value;
+    if (digits.getAsInteger(0, value))
+      return MakeError("invalid number '" + token + "'");
+
+    // Pick the first type that can hold the value, as C does.
+    if (!is_long && !is_unsigned && value <= uint64_t(INT32_MAX))
+      type = ValueType(32, true);
+    else if (!is_long && (is_unsigned || !is_decimal) && value <= UINT32_MAX)
+      type = ValueType(32, false);
+    else if (!is_unsigned && value <= uint64_t(INT64_MAX))
+      type = ValueType(64, true);
+    else
+      type = ValueType(64, false);
+    m_expr.EmitConstant(value);
+    return llvm::Error::success();
+  }
+
+  llvm::Error ParseRegister(llvm::StringRef name, ValueType &type) {
+    const RegisterInfo *reg_info = nullptr;
+    const size_t num_registers = m_register_info.GetNumRegisters();
+    for (size_t i = 0; i < num_registers && !reg_info; ++i) {
+      const RegisterInfo *info = m_register_info.GetRegisterInfoAtIndex(i);
+      if (info && ((info->name && name == info->name) ||
+                   (info->alt_name && name == info->alt_name)))
+        reg_info = info;
+    }
+    if (!reg_info)
+      return MakeError("unknown register '" + name + "'");
+    if (reg_info->encoding != eEncodingUint &&
+        reg_info->encoding != eEncodingSint)
+      return MakeError("register '" + name + "' isn't an integer");
+    if (llvm::Error error = EmitRegister(*reg_info))
+      return error;
+    type = EmitInteger(reg_info->byte_size,
+                       reg_info->encoding == eEncodingSint,
+                       /*needs_mask=*/true);
+    return llvm::Error::success();
+  }
+
+  llvm::Error ParseVariable(llvm::StringRef name, ValueType &type) {
+    VariableSP var_sp = FindVariable(ConstString(name));
+    if (!var_sp)
+      return MakeError("unknown variable '" + name + "'");
+
+    Type *var_type = var_sp->GetType();
+    if (!var_type)
+      return MakeError("variable '" + name + "' has no type");
+    CompilerType compiler_type = var_type->GetLayoutCompilerType();
+    llvm::Optional<uint64_t> byte_size = compiler_type.GetByteSize(nullptr);
+    if (!byte_size || (*byte_size != 1 && *byte_size != 2 &&
+                       *byte_size != 4 && *byte_size != 8))
+      return MakeError("variable '" + name + "' has an unsupported size");
+
+    bool is_signed = false;
+    CompilerType pointee_type;
+    ValueType pointer_type;
+    if (compiler_type.IsPointerType(&pointee_type)) {
+      pointer_type.is_pointer = true;
+      bool pointee_signed = false;
+      llvm::Optional<uint64_t> pointee_size =
+          pointee_type.GetByteSize(nullptr);
+      if (pointee_type.IsIntegerOrEnumerationType(pointee_signed) &&
+          pointee_size && *pointee_size <= 8 &&
+          llvm::isPowerOf2_64(*pointee_size)) {
+        pointer_type.pointee_size = *pointee_size;
+        pointer_type.pointee_signed = pointee_signed;
+      }
+    } else if (!compiler_type.IsIntegerOrEnumerationType(is_signed)) {
+      return MakeError("variable '" + name + "' isn't an integer or pointer");
+    }
+
+    bool in_register = false;
+    if (llvm::Error error = EmitLocation(*var_sp, in_register))
+      return error;
+    if (!in_register)
+      m_expr.EmitLoad(*byte_size);
+    type = EmitInteger(*byte_size, is_signed, in_register);
+    if (pointer_type.is_pointer) {
+      pointer_type.bits = type.bits;
+      pointer_type.is_signed = false;
+      type = pointer_type;
+    }
+    return llvm::Error::success();
+  }
+
+  //------------------------------------------------------------------
+  // Variables
+  //------------------------------------------------------------------
+  VariableSP FindVariable(ConstString name) {
+    if (m_sc.block) {
+      VariableList variables;
+      m_sc.block->AppendVariables(
+          /*can_create=*/true, /*get_parent_variables=*/true,
+          /*stop_if_block_is_inlined_function=*/true,
+          [](Variable *) { return true; }, &variables);
+      if (VariableSP var_sp = variables.FindVariable(name))
+        return var_sp;
+    }
+
+    if (VariableListSP globals_sp = m_sc.comp_unit->GetVariableList(true))
+      if (VariableSP var_sp = globals_sp->FindVariable(name))
+        return var_sp;
+
+    if (m_sc.module_sp) {
+      VariableList variables;
+      if (m_sc.module_sp->FindGlobalVariables(name, nullptr, 1, variables))
+        return variables.GetVariableAtIndex(0);
+    }
+    return VariableSP();
+  }
+
+  // Emit the address of the variable, or its value if \a in_register comes
+  // back true. Only single operation locations are supported.
+  llvm::Error EmitLocation(Variable &var, bool &in_register) {
+    DWARFExpression &location = var.LocationExpression();
+    auto unsupported = [&var]() {
+      return MakeError("variable '" + var.GetName().GetStringRef() +
+                       "' has an unsupported location");
+    };
+    DataExtractor data;
+    if (location.IsLocationList() || !location.GetExpressionData(data))
+      return unsupported();
+
+    const RegisterKind reg_kind = RegisterKind(location.GetRegisterKind());
+    lldb::offset_t offset = 0;
+    const uint8_t op = data.GetU8(&offset);
+    uint32_t regnum = LLDB_INVALID_REGNUM;
+    int64_t reg_offset = 0;
+    in_register = false;
+
+    if (op == DW_OP_addr) {
+      const lldb::addr_t file_addr = data.GetAddress(&offset);
+      if (offset != data.GetByteSize())
+        return unsupported();
+      Address so_addr;
+      lldb::addr_t load_addr = LLDB_INVALID_ADDRESS;
+      if (m_sc.module_sp &&
+          m_sc.module_sp->ResolveFileAddress(file_addr, so_addr))
+        load_addr = so_addr.GetLoadAddress(&m_target);
+      if (load_addr == LLDB_INVALID_ADDRESS)
+        return MakeError("variable '" + var.GetName().GetStringRef() +
+                         "' isn't loaded");
+      m_expr.EmitConstant(load_addr);
+      return llvm::Error::success();
+    }
+
+    if (op == DW_OP_fbreg) {
+      const int64_t var_offset = data.GetSLEB128(&offset);
+      if (offset != data.GetByteSize())
+        return unsupported();
+      if (llvm::Error error = EmitFrameBase())
+        return error;
+      EmitAddOffset(var_offset);
+      return llvm::Error::success();
+    }
+
+    if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+      regnum = op - DW_OP_breg0;
+      reg_offset = data.GetSLEB128(&offset);
+    } else if (op == DW_OP_bregx) {
+      regnum = data.GetULEB128(&offset);
+      reg_offset = data.GetSLEB128(&offset);
+    } else if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+      regnum = op - DW_OP_reg0;
+      in_register = true;
+    } else if (op == DW_OP_regx) {
+      regnum = data.GetULEB128(&offset);
+      in_register = true;
+    }
+    if (regnum == LLDB_INVALID_REGNUM || offset != data.GetByteSize())
+      return unsupported();
+
+    if (llvm::Error error = EmitDWARFRegister(reg_kind, regnum))
+      return error;
+    EmitAddOffset(reg_offset);
+    return llvm::Error::success();
+  }
+
+  // Only frame bases that are a register, optionally plus an offset, are
+  // supported. DW_OP_call_frame_cfa would need the unwinder.
+  llvm::Error EmitFrameBase() {
+    if (!m_sc.function)
+      return MakeError("no frame base outside of a function");
+    DWARFExpression &frame_base = m_sc.function->GetFrameBaseExpression();
+    DataExtractor data;
+    if (frame_base.IsLocationList() || !frame_base.GetExpressionData(data))
+      return MakeError("unsupported frame base");
+
+    const RegisterKind reg_kind = RegisterKind(frame_base.GetRegisterKind());
+    lldb::offset_t offset = 0;
+    const uint8_t op = data.GetU8(&offset);
+    uint32_t regnum = LLDB_INVALID_REGNUM;
+    int64_t base_offset = 0;
+    if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+      regnum = op - DW_OP_reg0;
+    } else if (op == DW_OP_regx) {
+      regnum = data.GetULEB128(&offset);
+    } else if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+      regnum = op - DW_OP_breg0;
+      base_offset = data.GetSLEB128(&offset);
+    } else if (op == DW_OP_bregx) {
+      regnum = data.GetULEB128(&offset);
+      base_offset = data.GetSLEB128(&offset);
+    }
+    if (regnum == LLDB_INVALID_REGNUM || offset != data.GetByteSize())
+      return MakeError("unsupported frame base");
+
+    if (llvm::Error error = EmitDWARFRegister(reg_kind, regnum))
+      return error;
+    EmitAddOffset(base_offset);
+    return llvm::Error::success();
+  }
+
+  //------------------------------------------------------------------
+  // Code generation
+  //------------------------------------------------------------------
+  llvm::Error EmitDWARFRegister(RegisterKind kind, uint32_t regnum) {
+    const uint32_t reg_index =
+        m_register_info.ConvertRegisterKindToRegisterNumber(kind, regnum);
+    const RegisterInfo *reg_info =
+        reg_index == LLDB_INVALID_REGNUM
+            ? nullptr
+            : m_register_info.GetRegisterInfoAtIndex(reg_index);
+    if (!reg_info)
+      return MakeError("unknown DWARF register " + llvm::Twine(regnum));
+    return EmitRegister(*reg_info);
+  }
+
+  llvm::Error EmitRegister(const RegisterInfo &reg_info) {
+    const uint32_t remote_regnum = reg_info.kinds[eRegisterKindProcessPlugin];
+    if (remote_regnum == LLDB_INVALID_REGNUM ||
+        !llvm::isUInt<16>(remote_regnum) || reg_info.byte_size > 8)
+      return MakeError(llvm::Twine("register '") + reg_info.name +
+                       "' can't be read by the stub");
+    m_expr.EmitRegister(remote_regnum);
+    return llvm::Error::success();
+  }
+
+  void EmitAddOffset(int64_t offset) {
+    if (offset > 0) {
+      m_expr.EmitConstant(offset);
+      m_expr.Emit(AgentExpression::eOpAdd);
+    } else if (offset < 0) {
+      m_expr.EmitConstant(0 - uint64_t(offset));
+      m_expr.Emit(AgentExpression::eOpSub);
+    }
+  }
+
+  // The top of the stack holds a \a byte_size byte integer. Bring it into
+  // the 64 bit representation and apply the integer promotions. Values
+  // loaded from memory are already zero extended, register values may need
+  // masking.
+  ValueType EmitInteger(size_t byte_size, bool is_signed, bool needs_mask) {
+    const unsigned bits = byte_size * 8;
+    if (is_signed || needs_mask)
+      m_expr.EmitExtend(bits, is_signed);
+    if (bits < 32)
+      return ValueType(32, true);
+    return ValueType(bits, is_signed);
+  }
+
+  // Restore the representation invariant after an operation that can
+  // overflow into the upper 32 bits.
+  void Normalize(const ValueType &type) {
+    if (type.bits < 64)
+      m_expr.EmitExtend(type.bits, type.is_signed);
+  }
+
+  // Turn the top of the stack into 0 or 1.
+  void EmitBool() {
+    m_expr.Emit(AgentExpression::eOpLogNot);
+    m_expr.Emit(AgentExpression::eOpLogNot);
+  }
+
+  // The usual arithmetic conversions. 64 bit values need no code: the
+  // representation of a 32 bit value is already its 64 bit value.
+  void EmitConvert(const ValueType &from, const ValueType &to) {
+    if (to.bits == 32 && from.is_signed != to.is_signed)
+      m_expr.EmitExtend(32, to.is_signed);
+  }
+
+  llvm::Error EmitBinary(BinaryOp op, ValueType &lhs, const ValueType &rhs) {
+    // Shifts don't convert their operands, the result has the type of the
+    // left hand side.
+    if (op == BinaryOp::Shl || op == BinaryOp::Shr) {
+      if (lhs.is_pointer || rhs.is_pointer)
+        return MakeError("can't shift a pointer");
+      if (op == BinaryOp::Shl) {
+        m_expr.Emit(AgentExpression::eOpLsh);
+        Normalize(lhs);
+      } else {
+        m_expr.Emit(lhs.is_signed ? AgentExpression::eOpRshSigned
+                                  : AgentExpression::eOpRshUnsigned);
+      }
+      return llvm::Error::success();
+    }
+
+    const bool is_comparison =
+        op == BinaryOp::Equal || op == BinaryOp::NotEqual ||
+        op == BinaryOp::Less || op == BinaryOp::LessEqual ||
+        op == BinaryOp::Greater || op == BinaryOp::GreaterEqual;
+    if ((lhs.is_pointer || rhs.is_pointer) && !is_comparison)
+      return MakeError("pointer arithmetic isn't supported");
+
+    ValueType common;
+    if (lhs.bits == rhs.bits)
+      common = ValueType(lhs.bits, lhs.is_signed && rhs.is_signed);
+    else
+      common = lhs.bits > rhs.bits ? ValueType(lhs.bits, lhs.is_signed)
+                                   : ValueType(rhs.bits, rhs.is_signed);
+    EmitConvert(rhs, common);
+    if (common.bits == 32 && lhs.is_signed != common.is_signed) {
+      m_expr.Emit(AgentExpression::eOpSwap);
+      EmitConvert(lhs, common);
+      m_expr.Emit(AgentExpression::eOpSwap);
+    }
+
+    const AgentExpression::Opcode less = common.is_signed
+                                             ? AgentExpression::eOpLessSigned
+                                             : AgentExpression::eOpLessUnsigned;
+    switch (op) {
+    case BinaryOp::Add:
+      m_expr.Emit(AgentExpression::eOpAdd);
+      Normalize(common);
+      break;
+    case BinaryOp::Sub:
+      m_expr.Emit(AgentExpression::eOpSub);
+      Normalize(common);
+      break;
+    case BinaryOp::Mul:
+      m_expr.Emit(AgentExpression::eOpMul);
+      Normalize(common);
+      break;
+    case BinaryOp::Div:
+      m_expr.Emit(common.is_signed ? AgentExpression::eOpDivSigned
+                                   : AgentExpression::eOpDivUnsigned);
+      Normalize(common);
+      break;
+    case BinaryOp::Rem:
+      m_expr.Emit(common.is_signed ? AgentExpression::eOpRemSigned
+                                   : AgentExpression::eOpRemUnsigned);
+      break;
+    case BinaryOp::BitAnd:
+      m_expr.Emit(AgentExpression::eOpBitAnd);
+      break;
+    case BinaryOp::BitOr:
+      m_expr.Emit(AgentExpression::eOpBitOr);
+      break;
+    case BinaryOp::BitXor:
+      m_expr.Emit(AgentExpression::eOpBitXor);
+      break;
+    case BinaryOp::Equal:
+      m_expr.Emit(AgentExpression::eOpEqual);
+      break;
+    case BinaryOp::NotEqual:
+      m_expr.Emit(AgentExpression::eOpEqual);
+      m_expr.Emit(AgentExpression::eOpLogNot);
+      break;
+    case BinaryOp::Less:
+      m_expr.Emit(less);
+      break;
+    case BinaryOp::Greater:
+      m_expr.Emit(AgentExpression::eOpSwap);
+      m_expr.Emit(less);
+      break;
+    case BinaryOp::LessEqual:
+      m_expr.Emit(AgentExpression::eOpSwap);
+      m_expr.Emit(less);
+      m_expr.Emit(AgentExpression::eOpLogNot);
+      break;
+    case BinaryOp::GreaterEqual:
+      m_expr.Emit(less);
+      m_expr.Emit(AgentExpression::eOpLogNot);
+      break;
+    default:
+      llvm_unreachable("handled by the caller");
+    }
+
+    lhs = is_comparison ? ValueType() : common;
+    return llvm::Error::success();
+  }
+
+  llvm::StringRef m_text;
+  size_t m_pos = 0;
+  Target &m_target;
+  const DynamicRegisterInfo &m_register_info;
+  SymbolContext m_sc;
+  AgentExpression m_expr;
+};
+
+} // namespace
+
+llvm::Expected<AgentExpression> lldb_private::process_gdb_remote::
+    CompileBreakpointCondition(llvm::StringRef condition,
+                               const Address &address, Target &target,
+                               const DynamicRegisterInfo &register_info) {
+  return ConditionCompiler(condition, address, target, register_info)
+      .Compile();
+}
@@ -0,0 +1,47 @@
+//===-- GDBRemoteBreakpointCondition.h --------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef lldb_GDBRemoteBreakpointCondition_h_
+#define lldb_GDBRemoteBreakpointCondition_h_
+
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/lldb-forward.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+class DynamicRegisterInfo;
+
+namespace lldb_private {
+namespace process_gdb_remote {
+
+//----------------------------------------------------------------------
+/// Compile a breakpoint condition into an agent expression the stub can
+/// evaluate when the breakpoint at \a address is hit.
+///
+/// Only a small side effect free subset of C is supported: integer
+/// literals, scalar variables that live in memory or in a register,
+/// registers ($name), the dereference of pointers to integers and the
+/// arithmetic, bitwise, comparison and logical operators. Anything else,
+/// including function calls, casts, member access and variables with
+/// location lists, returns an error; the client evaluates those conditions
+/// itself.
+///
+/// @param[in] register_info
+///     The stub's registers. Registers are referred to by the numbers the
+///     stub uses for them.
+//----------------------------------------------------------------------
+llvm::Expected<AgentExpression>
+CompileBreakpointCondition(llvm::StringRef condition, const Address &address,
+                           Target &target,
+                           const DynamicRegisterInfo &register_info);
+
+} // namespace process_gdb_remote
+} // namespace lldb_private
+
+#endif // lldb_GDBRemoteBreakpointCondition_h_
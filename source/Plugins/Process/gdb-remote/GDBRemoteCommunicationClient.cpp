@@ -84,6 +84,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_conditional_breakpoints(eLazyBoolCalculate),
       m_supports_error_string_reply(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
@@ -155,6 +156,13 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported() {
+  if (m_supports_conditional_breakpoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_conditional_breakpoints == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -296,6 +304,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supports_qXfer_features_read = eLazyBoolCalculate;
     m_supports_qXfer_memory_map_read = eLazyBoolCalculate;
     m_supports_augmented_libraries_svr4_read = eLazyBoolCalculate;
+    m_supports_conditional_breakpoints = eLazyBoolCalculate;
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
     m_supports_qUserName = true;
@@ -431,6 +440,11 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "ConditionalBreakpoints+"))
+      m_supports_conditional_breakpoints = eLazyBoolYes;
+    else
+      m_supports_conditional_breakpoints = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -2672,7 +2686,8 @@ bool GDBRemoteCommunicationClient::GetThreadStopInfo(
 }
 
 uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
-    GDBStoppointType type, bool insert, addr_t addr, uint32_t length) {
+    GDBStoppointType type, bool insert, addr_t addr, uint32_t length,
+    llvm::ArrayRef<AgentExpression> conditions) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
   if (log)
     log->Printf("GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64,
@@ -2682,19 +2697,24 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   if (!SupportsGDBStoppointPacket(type))
     return UINT8_MAX;
   // Construct the breakpoint packet
-  char packet[64];
-  const int packet_len =
-      ::snprintf(packet, sizeof(packet), "%c%i,%" PRIx64 ",%x",
-                 insert ? 'Z' : 'z', type, addr, length);
-  // Check we haven't overwritten the end of the packet buffer
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
+  StreamString packet;
+  packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr,
+                length);
+  // Append the condition list: ";X<len>,<bytecode>X<len>,<bytecode>..."
+  if (insert && !conditions.empty()) {
+    packet.PutChar(';');
+    for (const AgentExpression &condition : conditions) {
+      packet.Printf("X%zx,", condition.GetSize());
+      packet.PutBytesAsRawHex8(condition.GetBytes().data(),
+                               condition.GetSize());
+    }
+  }
   StringExtractorGDBRemote response;
   // Make sure the response is either "OK", "EXX" where XX are two hex digits,
   // or "" (unsupported)
   response.SetResponseValidatorToOKErrorNotSupported();
   // Try to send the breakpoint packet, and check that it was correctly sent
-  if (SendPacketAndWaitForResponse(packet, response, true) ==
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) ==
       PacketResult::Success) {
     // Receive and OK packet when the breakpoint successfully placed
     if (response.IsOKResponse())
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "lldb/Target/Process.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/StreamGDBRemote.h"
 #include "lldb/Utility/StructuredData.h"
@@ -317,7 +318,10 @@ public:
       GDBStoppointType type, // Type of breakpoint or watchpoint
       bool insert,           // Insert or remove?
       lldb::addr_t addr,     // Address of breakpoint or watchpoint
-      uint32_t length);      // Byte Size of breakpoint or watchpoint
+      uint32_t length,       // Byte Size of breakpoint or watchpoint
+      // Conditions for the stub to evaluate, see
+      // GetConditionalBreakpointsSupported()
+      llvm::ArrayRef<AgentExpression> conditions = {});
 
   bool SetNonStopMode(const bool enable);
 
@@ -350,6 +354,8 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  bool GetConditionalBreakpointsSupported();
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -551,6 +557,7 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_conditional_breakpoints;
   LazyBool m_supports_error_string_reply;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
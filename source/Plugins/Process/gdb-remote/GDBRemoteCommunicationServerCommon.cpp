@@ -850,6 +850,9 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
   response.PutCString(";QPassSignals+");
   response.PutCString(";qXfer:auxv:read+");
 #endif
+#if defined(__linux__)
+  response.PutCString(";ConditionalBreakpoints+");
+#endif
 
   return SendPacketNoLock(response.GetString());
 }
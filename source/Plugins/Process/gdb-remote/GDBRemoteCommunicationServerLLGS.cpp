@@ -29,6 +29,7 @@
 #include "lldb/Host/common/NativeThreadProtocol.h"
 #include "lldb/Target/FileAction.h"
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/DataBuffer.h"
 #include "lldb/Utility/Endian.h"
@@ -2532,13 +2533,45 @@ GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
     return SendIllFormedResponse(
         packet, "Malformed Z packet, failed to parse size argument");
 
+  // Parse out the breakpoint conditions, if any: ";X<len>,<bytecode>...". As
+  // in gdbserver, the conditions may or may not be separated by semicolons.
+  std::vector<AgentExpression> conditions;
+  while (packet.GetBytesLeft() > 0) {
+    if (packet.PeekChar() == ';')
+      packet.GetChar();
+    if (packet.GetChar() != 'X')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, unsupported breakpoint parameter");
+    const uint32_t cond_size = packet.GetHexMaxU32(false, 0);
+    if (cond_size == 0 || packet.GetChar() != ',')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition size");
+    std::vector<uint8_t> bytes(cond_size);
+    if (packet.GetHexBytes(bytes, 0) != cond_size)
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, truncated condition");
+    conditions.emplace_back(bytes);
+  }
+
   if (want_breakpoint) {
     // Try to set the breakpoint.
     const Status error =
         m_debugged_process_up->SetBreakpoint(addr, size, want_hardware);
-    if (error.Success())
-      return SendOKResponse();
     Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+    if (error.Success()) {
+      // Conditions are only evaluated for software breakpoints. Any other
+      // hit is reported unconditionally, and the client checks the condition
+      // itself.
+      if (!want_hardware) {
+        const Status cond_error =
+            m_debugged_process_up->SetBreakpointConditions(
+                addr, std::move(conditions));
+        if (cond_error.Fail())
+          LLDB_LOG(log, "pid {0} failed to set breakpoint conditions: {1}",
+                   m_debugged_process_up->GetID(), cond_error);
+      }
+      return SendOKResponse();
+    }
     LLDB_LOG(log, "pid {0} failed to set breakpoint: {1}",
              m_debugged_process_up->GetID(), error);
     return SendErrorResponse(0x09);
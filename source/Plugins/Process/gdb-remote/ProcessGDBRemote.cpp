@@ -27,6 +27,8 @@
 #include <mutex>
 #include <sstream>
 
+#include "lldb/Breakpoint/Breakpoint.h"
+#include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
@@ -70,6 +72,7 @@
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
 
+#include "GDBRemoteBreakpointCondition.h"
 #include "GDBRemoteRegisterContext.h"
 #include "Plugins/Platform/MacOSX/PlatformRemoteiOS.h"
 #include "Plugins/Process/Utility/GDBRemoteSignals.h"
@@ -120,9 +123,18 @@ static constexpr PropertyDefinition g_properties[] = {
       , NULL, {},
      "Specify the default packet timeout in seconds."},
     {"target-definition-file", OptionValue::eTypeFileSpec, true, 0, NULL, {},
-     "The file that provides the description for remote target registers."}};
-
-enum { ePropertyPacketTimeout, ePropertyTargetDefinitionFile };
+     "The file that provides the description for remote target registers."},
+    {"use-stub-breakpoint-conditions", OptionValue::eTypeBoolean, true, false,
+     NULL, {},
+     "If true, simple breakpoint conditions are sent to stubs that support "
+     "them, so that hits where the condition is false don't stop the "
+     "process."}};
+
+enum {
+  ePropertyPacketTimeout,
+  ePropertyTargetDefinitionFile,
+  ePropertyUseStubBreakpointConditions
+};
 
 class PluginProperties : public Properties {
 public:
@@ -152,6 +164,12 @@ public:
     const uint32_t idx = ePropertyTargetDefinitionFile;
     return m_collection_sp->GetPropertyAtIndexAsFileSpec(NULL, idx);
   }
+
+  bool GetUseStubBreakpointConditions() const {
+    const uint32_t idx = ePropertyUseStubBreakpointConditions;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        NULL, idx, g_properties[idx].default_uint_value != 0);
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -1342,6 +1360,8 @@ Status ProcessGDBRemote::DoResume() {
   if (log)
     log->Printf("ProcessGDBRemote::Resume()");
 
+  UpdateStubBreakpointConditions();
+
   ListenerSP listener_sp(
       Listener::MakeListener("gdb-remote.resume-packet-sent"));
   if (listener_sp->StartListeningForEvents(
@@ -3185,12 +3205,15 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) &&
       (!bp_site->HardwareRequired())) {
     // Try to send off a software breakpoint packet ($Z0)
+    StubBreakpointConditions conditions =
+        GetStubBreakpointConditions(*bp_site);
     uint8_t error_no = m_gdb_comm.SendGDBStoppointTypePacket(
-        eBreakpointSoftware, true, addr, bp_op_size);
+        eBreakpointSoftware, true, addr, bp_op_size, conditions.expressions);
     if (error_no == 0) {
       // The breakpoint was placed successfully
       bp_site->SetEnabled(true);
       bp_site->SetType(BreakpointSite::eExternal);
+      m_stub_breakpoint_conditions[site_id] = std::move(conditions);
       return error;
     }
 
@@ -3308,8 +3331,10 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
         error.SetErrorToGenericError();
     } break;
     }
-    if (error.Success())
+    if (error.Success()) {
       bp_site->SetEnabled(false);
+      m_stub_breakpoint_conditions.erase(site_id);
+    }
   } else {
     if (log)
       log->Printf("ProcessGDBRemote::DisableBreakpointSite (site_id = %" PRIu64
@@ -3323,6 +3348,112 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
   return error;
 }
 
+ProcessGDBRemote::StubBreakpointConditions
+ProcessGDBRemote::GetStubBreakpointConditions(BreakpointSite &bp_site) {
+  StubBreakpointConditions conditions;
+  if (!GetGlobalPluginProperties()->GetUseStubBreakpointConditions() ||
+      bp_site.HardwareRequired() ||
+      !m_gdb_comm.GetConditionalBreakpointsSupported())
+    return conditions;
+
+  // The stub only reports a hit when one of the conditions is true, so every
+  // owner needs a condition. Ignore counts and synchronous callbacks are
+  // handled before the condition is checked, those need to see every hit.
+  std::vector<BreakpointLocationSP> owners;
+  const size_t num_owners = bp_site.GetNumberOfOwners();
+  for (size_t i = 0; i < num_owners; ++i) {
+    BreakpointLocationSP loc_sp = bp_site.GetOwnerAtIndex(i);
+    const char *condition = loc_sp ? loc_sp->GetConditionText() : nullptr;
+    if (!condition || loc_sp->GetIgnoreCount() != 0 ||
+        loc_sp->GetBreakpoint().GetIgnoreCount() != 0)
+      return StubBreakpointConditions();
+    const BreakpointOptions *callback_options =
+        loc_sp->GetOptionsSpecifyingKind(BreakpointOptions::eCallback);
+    if (callback_options && callback_options->HasCallback() &&
+        callback_options->IsCallbackSynchronous())
+      return StubBreakpointConditions();
+    conditions.source.append(condition);
+    conditions.source.push_back('\0');
+    owners.push_back(loc_sp);
+  }
+  if (owners.empty())
+    return StubBreakpointConditions();
+
+  // Don't compile the same conditions again on every resume.
+  auto pos = m_stub_breakpoint_conditions.find(bp_site.GetID());
+  if (pos != m_stub_breakpoint_conditions.end() &&
+      pos->second.source == conditions.source)
+    return pos->second;
+
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+  for (const BreakpointLocationSP &loc_sp : owners) {
+    llvm::Expected<AgentExpression> expr = CompileBreakpointCondition(
+        loc_sp->GetConditionText(), loc_sp->GetAddress(), GetTarget(),
+        m_register_info);
+    if (!expr) {
+      LLDB_LOG(log,
+               "condition \"{0}\" of breakpoint {1}.{2} is evaluated by the "
+               "debugger: {3}",
+               loc_sp->GetConditionText(), loc_sp->GetBreakpoint().GetID(),
+               loc_sp->GetID(), llvm::toString(expr.takeError()));
+      // Keep the source so that we don't try again until it changes.
+      conditions.expressions.clear();
+      return conditions;
+    }
+    conditions.expressions.push_back(std::move(*expr));
+  }
+  return conditions;
+}
+
+void ProcessGDBRemote::UpdateStubBreakpointConditions() {
+  if (!m_gdb_comm.GetConditionalBreakpointsSupported())
+    return;
+
+  // Conditions are added and changed while the breakpoint is already in
+  // place; there is no packet to change the condition of an existing
+  // breakpoint, so replace it.
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+  m_breakpoint_site_list.ForEach([this, log](BreakpointSite *bp_site) {
+    auto pos = m_stub_breakpoint_conditions.find(bp_site->GetID());
+    if (pos == m_stub_breakpoint_conditions.end() || !bp_site->IsEnabled() ||
+        bp_site->GetType() != BreakpointSite::eExternal)
+      return;
+
+    StubBreakpointConditions conditions = GetStubBreakpointConditions(*bp_site);
+    if (conditions.source == pos->second.source)
+      return;
+    if (conditions.expressions.empty() && pos->second.expressions.empty()) {
+      pos->second = std::move(conditions);
+      return;
+    }
+
+    const addr_t addr = bp_site->GetLoadAddress();
+    const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, false, addr,
+                                              bp_op_size) != 0) {
+      LLDB_LOG(log, "failed to remove breakpoint at {0:x}", addr);
+      return;
+    }
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                              bp_op_size,
+                                              conditions.expressions) != 0) {
+      LLDB_LOG(log,
+               "failed to set conditional breakpoint at {0:x}, setting it "
+               "without conditions",
+               addr);
+      conditions.expressions.clear();
+      if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true,
+                                                addr, bp_op_size) != 0) {
+        LLDB_LOG(log, "failed to restore breakpoint at {0:x}", addr);
+        bp_site->SetEnabled(false);
+        m_stub_breakpoint_conditions.erase(pos);
+        return;
+      }
+    }
+    pos->second = std::move(conditions);
+  });
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType GetGDBStoppointType(Watchpoint *wp) {
   assert(wp);
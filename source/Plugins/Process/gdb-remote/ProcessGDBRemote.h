@@ -449,6 +449,25 @@ private:
   void HandleAsyncStructuredDataPacket(llvm::StringRef data) override;
 
   void SetThreadPc(const lldb::ThreadSP &thread_sp, uint64_t index);
+
+  //------------------------------------------------------------------
+  // Breakpoint conditions evaluated by the stub
+  //------------------------------------------------------------------
+  struct StubBreakpointConditions {
+    // The conditions of the site's owners, or empty if the stub can't
+    // evaluate them.
+    std::string source;
+    std::vector<AgentExpression> expressions;
+  };
+
+  StubBreakpointConditions GetStubBreakpointConditions(BreakpointSite &bp_site);
+
+  void UpdateStubBreakpointConditions();
+
+  // What was sent with the Z0 packet of each software breakpoint site.
+  std::map<lldb::user_id_t, StubBreakpointConditions>
+      m_stub_breakpoint_conditions;
+
   using ModuleCacheKey = std::pair<std::string, std::string>;
   // KeyInfo for the cached module spec DenseMap.
   // The invariant is that all real keys will have the file and architecture
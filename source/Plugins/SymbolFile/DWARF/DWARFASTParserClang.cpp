@@ -42,6 +42,9 @@
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/DeclTemplate.h"
 
+#include "llvm/ADT/StringSet.h"
+
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -124,6 +127,85 @@ ClangASTImporter &DWARFASTParserClang::GetClangASTImporter() {
   return *m_clang_ast_importer_up;
 }
 
+bool DWARFASTParserClang::TakePendingMethod(const clang::DeclContext *decl_ctx,
+                                            const DWARFDIE &die) {
+  auto pos = m_pending_methods.find(decl_ctx);
+  if (pos == m_pending_methods.end())
+    return false;
+  auto name_pos = pos->second.find(llvm::StringRef(die.GetName()));
+  if (name_pos == pos->second.end())
+    return false;
+  std::vector<DWARFDIE> &dies = name_pos->second;
+  auto die_pos = std::find(dies.begin(), dies.end(), die);
+  if (die_pos == dies.end())
+    return false;
+  dies.erase(die_pos);
+  if (dies.empty()) {
+    pos->second.erase(name_pos);
+    if (pos->second.empty())
+      m_pending_methods.erase(pos);
+  }
+  return true;
+}
+
+bool DWARFASTParserClang::CompletePendingMethods(
+    const clang::DeclContext *decl_ctx) {
+  SymbolFile *sym_file = m_ast.GetSymbolFile();
+  if (!sym_file)
+    return false;
+  std::lock_guard<std::recursive_mutex> guard(
+      sym_file->GetObjectFile()->GetModule()->GetMutex());
+
+  auto pos = m_pending_methods.find(decl_ctx);
+  if (pos == m_pending_methods.end())
+    return false;
+
+  // Resolving a DIE takes it off the pending list, so don't iterate the list
+  // itself.
+  std::vector<DWARFDIE> method_dies;
+  for (const auto &entry : pos->second)
+    method_dies.insert(method_dies.end(), entry.second.begin(),
+                       entry.second.end());
+  for (const DWARFDIE &method_die : method_dies)
+    method_die.ResolveType();
+
+  // DIEs that couldn't be added to the class stay unresolved.
+  m_pending_methods.erase(decl_ctx);
+  return true;
+}
+
+void DWARFASTParserClang::FindPendingMethods(
+    const clang::DeclContext *decl_ctx, clang::DeclarationName name,
+    llvm::SmallVectorImpl<clang::NamedDecl *> &results) {
+  SymbolFile *sym_file = m_ast.GetSymbolFile();
+  if (!sym_file)
+    return;
+  std::lock_guard<std::recursive_mutex> guard(
+      sym_file->GetObjectFile()->GetModule()->GetMutex());
+
+  auto pos = m_pending_methods.find(decl_ctx);
+  if (pos == m_pending_methods.end())
+    return;
+  auto name_pos = pos->second.find(name.getAsString());
+  if (name_pos == pos->second.end())
+    return;
+
+  std::vector<DWARFDIE> method_dies = name_pos->second;
+  for (const DWARFDIE &method_die : method_dies) {
+    method_die.ResolveType();
+    if (clang::NamedDecl *decl = llvm::dyn_cast_or_null<clang::CXXMethodDecl>(
+            GetCachedClangDeclContextForDIE(method_die)))
+      results.push_back(decl);
+  }
+
+  pos = m_pending_methods.find(decl_ctx);
+  if (pos != m_pending_methods.end()) {
+    pos->second.erase(name.getAsString());
+    if (pos->second.empty())
+      m_pending_methods.erase(pos);
+  }
+}
+
 /// Detect a forward declaration that is nested in a DW_TAG_module.
 static bool IsClangModuleFwdDecl(const DWARFDIE &Die) {
   if (!Die.GetAttributeValueAsUnsigned(DW_AT_declaration, 0))
@@ -1466,7 +1548,11 @@ TypeSP DWARFASTParserClang::ParseTypeFromDWARF(const SymbolContext &sc,
                   CompilerType class_opaque_type =
                       class_type->GetForwardCompilerType();
                   if (ClangASTContext::IsCXXClassType(class_opaque_type)) {
-                    if (class_opaque_type.IsBeingDefined() || alternate_defn) {
+                    if (class_opaque_type.IsBeingDefined() || alternate_defn ||
+                        TakePendingMethod(
+                            m_ast.GetAsCXXRecordDecl(
+                                class_opaque_type.GetOpaqueQualType()),
+                            die)) {
                       if (!is_static && !die.HasChildren()) {
                         // We have a C++ member function with no children (this
                         // pointer!) and clang will get mad if we try and make
@@ -2118,6 +2204,27 @@ bool DWARFASTParserClang::ParseTemplateParameterInfos(
   return template_param_infos.args.size() == template_param_infos.names.size();
 }
 
+// Return true if clang needs to know about \a method_die to lay out or pass
+// the class \a class_die, or to decide which special members it declares
+// implicitly. Those have to be added before the class is completed.
+static bool IsMethodNeededForLayout(const DWARFDIE &method_die,
+                                    const DWARFDIE &class_die) {
+  if (method_die.GetAttributeValueAsUnsigned(DW_AT_virtuality, 0) ||
+      method_die.GetAttributeValueAsUnsigned(DW_AT_artificial, 0))
+    return true;
+
+  llvm::StringRef name(method_die.GetName());
+  // Lookups are by unqualified name, which doesn't match the DIE name of
+  // templates.
+  if (name.empty() || name.contains('<') || name.startswith("~") ||
+      name == "operator=")
+    return true;
+
+  // Constructors are named after the class, without template arguments.
+  llvm::StringRef class_name(class_die.GetName());
+  return name == class_name.substr(0, class_name.find('<'));
+}
+
 bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
                                                 lldb_private::Type *type,
                                                 CompilerType &clang_type) {
@@ -2183,6 +2290,7 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
   case DW_TAG_union_type:
   case DW_TAG_class_type: {
     ClangASTImporter::LayoutInfo layout_info;
+    std::vector<DWARFDIE> pending_methods;
 
     {
       if (die.HasChildren()) {
@@ -2221,10 +2329,30 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
                           layout_info);
 
         // Now parse any methods if there were any...
+        const bool lazy_methods =
+            class_language != eLanguageTypeObjC &&
+            m_ast.GetAsCXXRecordDecl(clang_type.GetOpaqueQualType()) &&
+            m_ast.GetLazyMemberFunctions();
         size_t num_functions = member_function_dies.Size();
+        // clang only asks the external source about names it has no
+        // declarations for, so all overloads of a name have to be added at
+        // the same time.
+        llvm::StringSet<> eager_method_names;
+        if (lazy_methods) {
+          for (size_t i = 0; i < num_functions; ++i) {
+            DWARFDIE method_die = member_function_dies.GetDIEAtIndex(i);
+            if (IsMethodNeededForLayout(method_die, die))
+              eager_method_names.insert(method_die.GetName());
+          }
+        }
         if (num_functions > 0) {
           for (size_t i = 0; i < num_functions; ++i) {
-            dwarf->ResolveType(member_function_dies.GetDIEAtIndex(i));
+            DWARFDIE method_die = member_function_dies.GetDIEAtIndex(i);
+            if (lazy_methods &&
+                !eager_method_names.count(method_die.GetName()))
+              pending_methods.push_back(method_die);
+            else
+              dwarf->ResolveType(method_die);
           }
         }
 
@@ -2325,6 +2453,20 @@ bool DWARFASTParserClang::CompleteTypeFromDWARF(const DWARFDIE &die,
     ClangASTContext::BuildIndirectFields(clang_type);
     ClangASTContext::CompleteTagDeclarationDefinition(clang_type);
 
+    if (!pending_methods.empty()) {
+      clang::CXXRecordDecl *record_decl =
+          m_ast.GetAsCXXRecordDecl(clang_type.GetOpaqueQualType());
+      auto &pending = m_pending_methods[record_decl];
+      for (const DWARFDIE &method_die : pending_methods)
+        pending[llvm::StringRef(method_die.GetName())].push_back(method_die);
+      // The fields are all there, only the member functions are missing.
+      // Looking up a name or walking the members of the class asks the
+      // external source for them.
+      record_decl->setHasExternalLexicalStorage(true);
+      record_decl->setHasExternalVisibleStorage(true);
+      record_decl->setHasLoadedFieldsFromExternalStorage(true);
+    }
+
     if (!layout_info.field_offsets.empty() ||
         !layout_info.base_offsets.empty() ||
         !layout_info.vbase_offsets.empty()) {
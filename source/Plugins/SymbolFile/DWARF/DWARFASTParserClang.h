@@ -13,8 +13,10 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 
 #include "DWARFASTParser.h"
+#include "DWARFDIE.h"
 #include "DWARFDefines.h"
 #include "lldb/Core/ClangForward.h"
 #include "lldb/Core/PluginInterface.h"
@@ -61,6 +63,21 @@ public:
 
   lldb_private::ClangASTImporter &GetClangASTImporter();
 
+  //----------------------------------------------------------------------
+  // With symbols.lazy-member-function-parsing, completing a C++ class only
+  // adds the member functions that affect its layout or ABI. The others are
+  // added to the complete class when they are looked up by name, or all at
+  // once when the members of the class are enumerated.
+  //
+  // CompletePendingMethods returns false if decl_ctx had no pending member
+  // functions.
+  //----------------------------------------------------------------------
+  bool CompletePendingMethods(const clang::DeclContext *decl_ctx);
+
+  void FindPendingMethods(const clang::DeclContext *decl_ctx,
+                          clang::DeclarationName name,
+                          llvm::SmallVectorImpl<clang::NamedDecl *> &results);
+
 protected:
   class DelayedAddObjCClassProperty;
   typedef std::vector<DelayedAddObjCClassProperty> DelayedPropertyList;
@@ -133,6 +150,9 @@ protected:
   //----------------------------------------------------------------------
   lldb::ModuleSP GetModuleForType(const DWARFDIE &die);
 
+  bool TakePendingMethod(const clang::DeclContext *decl_ctx,
+                         const DWARFDIE &die);
+
   typedef llvm::SmallPtrSet<const DWARFDebugInfoEntry *, 4> DIEPointerSet;
   typedef llvm::DenseMap<const DWARFDebugInfoEntry *, clang::DeclContext *>
       DIEToDeclContextMap;
@@ -143,12 +163,18 @@ protected:
   typedef llvm::DenseMap<const DWARFDebugInfoEntry *, clang::Decl *>
       DIEToDeclMap;
   typedef llvm::DenseMap<const clang::Decl *, DIEPointerSet> DeclToDIEMap;
+  // Member function DIEs of a complete class that weren't parsed yet, by
+  // name.
+  typedef llvm::DenseMap<const clang::DeclContext *,
+                         llvm::StringMap<std::vector<DWARFDIE>>>
+      PendingMethodMap;
 
   lldb_private::ClangASTContext &m_ast;
   DIEToDeclMap m_die_to_decl;
   DeclToDIEMap m_decl_to_die;
   DIEToDeclContextMap m_die_to_decl_ctx;
   DeclContextToDIEMap m_decl_ctx_to_die;
+  PendingMethodMap m_pending_methods;
   std::unique_ptr<lldb_private::ClangASTImporter> m_clang_ast_importer_up;
 };
 
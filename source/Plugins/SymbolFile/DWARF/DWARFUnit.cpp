@@ -843,6 +843,17 @@ SymbolFileDWARFDwo *DWARFUnit::GetDwoSymbolFile() const {
   return m_dwo_symbol_file.get();
 }
 
+size_t DWARFUnit::GetDIEMemoryUsage() const {
+  size_t usage = 0;
+  {
+    llvm::sys::ScopedReader lock(m_die_array_mutex);
+    usage += m_die_array.capacity() * sizeof(DWARFDebugInfoEntry);
+  }
+  if (m_dwo_symbol_file)
+    usage += m_dwo_symbol_file->GetDebugInfoMemoryUsage();
+  return usage;
+}
+
 dw_offset_t DWARFUnit::GetBaseObjOffset() const { return m_base_obj_offset; }
 
 const DWARFDebugAranges &DWARFUnit::GetFunctionAranges() {
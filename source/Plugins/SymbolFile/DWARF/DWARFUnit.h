@@ -173,6 +173,10 @@ public:
 
   SymbolFileDWARFDwo *GetDwoSymbolFile() const;
 
+  // Return the memory used by the DIEs extracted so far, including those of
+  // the .dwo file.
+  size_t GetDIEMemoryUsage() const;
+
   dw_offset_t GetBaseObjOffset() const;
 
   die_iterator_range dies() {
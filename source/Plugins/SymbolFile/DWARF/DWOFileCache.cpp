@@ -0,0 +1,72 @@
+//===-- DWOFileCache.cpp ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWOFileCache.h"
+
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+
+#include "llvm/Support/FileSystem.h"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace lldb;
+using namespace lldb_private;
+
+DWOFileCache &DWOFileCache::GetGlobal() {
+  // Leaked on purpose; modules may still be torn down during exit.
+  static DWOFileCache *g_cache = new DWOFileCache();
+  return *g_cache;
+}
+
+DataBufferSP DWOFileCache::GetFileData(const FileSpec &file) {
+  // One stat instead of separate existence and size checks.
+  const std::string path = file.GetPath();
+  llvm::sys::fs::file_status status;
+  if (llvm::sys::fs::status(path, status) ||
+      status.type() != llvm::sys::fs::file_type::regular_file)
+    return DataBufferSP();
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto pos = m_entries.find(path);
+    if (pos != m_entries.end() && pos->second.size == status.getSize() &&
+        pos->second.mtime == status.getLastModificationTime()) {
+      if (DataBufferSP data_sp = pos->second.data.lock())
+        return data_sp;
+    }
+  }
+
+  DataBufferSP data_sp = FileSystem::Instance().CreateDataBuffer(path);
+  if (!data_sp || data_sp->GetByteSize() != status.getSize())
+    return DataBufferSP();
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries[path] = {status.getSize(), status.getLastModificationTime(),
+                     data_sp};
+  return data_sp;
+}
+
+std::vector<DataBufferSP>
+DWOFileCache::GetFileData(llvm::ArrayRef<FileSpec> files,
+                          size_t max_threads) {
+  std::vector<DataBufferSP> result(files.size());
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < files.size(); i = next++)
+      result[i] = GetFileData(files[i]);
+  };
+
+  // Each worker reads files until there are none left, so no more than
+  // max_threads are read at once.
+  TaskMapOverInt(0, std::min(max_threads, files.size()),
+                 [&](size_t) { worker(); });
+  return result;
+}
@@ -0,0 +1,54 @@
+//===-- DWOFileCache.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWOFileCache_h_
+#define SymbolFileDWARF_DWOFileCache_h_
+
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/lldb-forward.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Chrono.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// The contents of the .dwo files in use in this process.
+///
+/// Every module gets its own ObjectFile for a .dwo file, but the file itself
+/// is only read once while any module still uses it, so that targets
+/// debugging the same program don't read thousands of .dwo files from
+/// network storage again. The file's size and modification time are checked
+/// before its contents are shared.
+class DWOFileCache {
+public:
+  static DWOFileCache &GetGlobal();
+
+  /// Return the contents of \a file, or nullptr if it can't be read.
+  lldb::DataBufferSP GetFileData(const lldb_private::FileSpec &file);
+
+  /// Read \a files on up to \a max_threads task pool threads and return their
+  /// contents in the same order.
+  std::vector<lldb::DataBufferSP>
+  GetFileData(llvm::ArrayRef<lldb_private::FileSpec> files,
+              size_t max_threads);
+
+private:
+  struct Entry {
+    uint64_t size;
+    llvm::sys::TimePoint<> mtime;
+    std::weak_ptr<lldb_private::DataBuffer> data;
+  };
+
+  std::mutex m_mutex;
+  llvm::StringMap<Entry> m_entries;
+};
+
+#endif // SymbolFileDWARF_DWOFileCache_h_
@@ -0,0 +1,101 @@
+//===-- DWPUnitIndex.cpp ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWPUnitIndex.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+
+using namespace lldb_private;
+
+// The header is four 32-bit fields: version, number of columns, number of
+// units and number of hash buckets. It is followed by the hash table (a
+// signature and a row per bucket), the section kind of each column, and the
+// offset and size of each unit's contribution to each column.
+static const lldb::offset_t g_header_size = 16;
+
+bool DWPUnitIndex::Parse(const DataExtractor &data) {
+  m_num_columns = m_num_units = m_num_buckets = 0;
+  std::fill(std::begin(m_columns), std::end(m_columns), UINT32_MAX);
+
+  lldb::offset_t offset = 0;
+  if (!data.ValidOffsetForDataOfSize(0, g_header_size))
+    return false;
+  const uint32_t version = data.GetU32(&offset);
+  const uint32_t num_columns = data.GetU32(&offset);
+  const uint32_t num_units = data.GetU32(&offset);
+  const uint32_t num_buckets = data.GetU32(&offset);
+  // Only the pre-standard GNU package format is produced by llvm-dwp.
+  if (version != 2 || (num_buckets && !llvm::isPowerOf2_32(num_buckets)) ||
+      num_units > num_buckets)
+    return false;
+
+  const uint64_t size = g_header_size + uint64_t(num_buckets) * 12 +
+                        uint64_t(num_columns) * 4 +
+                        uint64_t(num_units) * num_columns * 8;
+  if (!data.ValidOffsetForDataOfSize(0, size))
+    return false;
+
+  offset = g_header_size + uint64_t(num_buckets) * 12;
+  for (uint32_t column = 0; column < num_columns; ++column) {
+    const uint32_t kind = data.GetU32(&offset);
+    if (kind < llvm::array_lengthof(m_columns))
+      m_columns[kind] = column;
+  }
+
+  m_data = data;
+  m_num_columns = num_columns;
+  m_num_units = num_units;
+  m_num_buckets = num_buckets;
+  return true;
+}
+
+uint32_t DWPUnitIndex::FindRow(uint64_t signature) const {
+  if (m_num_buckets == 0)
+    return 0;
+
+  const uint64_t mask = m_num_buckets - 1;
+  const lldb::offset_t rows_offset =
+      g_header_size + lldb::offset_t(m_num_buckets) * 8;
+  uint64_t bucket = signature & mask;
+  const uint64_t step = ((signature >> 32) & mask) | 1;
+  // The table is never full, but don't trust that in a damaged file.
+  for (uint32_t probe = 0; probe < m_num_buckets; ++probe) {
+    lldb::offset_t offset = rows_offset + bucket * 4;
+    const uint32_t row = m_data.GetU32(&offset);
+    if (row == 0)
+      return 0;
+    offset = g_header_size + bucket * 8;
+    if (m_data.GetU64(&offset) == signature)
+      return row <= m_num_units ? row : 0;
+    bucket = (bucket + step) & mask;
+  }
+  return 0;
+}
+
+bool DWPUnitIndex::GetContribution(uint32_t row, llvm::DWARFSectionKind kind,
+                                   Contribution &contribution) const {
+  if (row == 0 || row > m_num_units ||
+      uint32_t(kind) >= llvm::array_lengthof(m_columns) ||
+      m_columns[kind] == UINT32_MAX)
+    return false;
+
+  const lldb::offset_t cell =
+      (lldb::offset_t(row - 1) * m_num_columns + m_columns[kind]) * 4;
+  const lldb::offset_t offsets_offset =
+      g_header_size + lldb::offset_t(m_num_buckets) * 12 + m_num_columns * 4;
+  const lldb::offset_t sizes_offset =
+      offsets_offset + lldb::offset_t(m_num_units) * m_num_columns * 4;
+  lldb::offset_t offset = offsets_offset + cell;
+  contribution.offset = m_data.GetU32(&offset);
+  offset = sizes_offset + cell;
+  contribution.length = m_data.GetU32(&offset);
+  return true;
+}
@@ -0,0 +1,52 @@
+//===-- DWPUnitIndex.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SymbolFileDWARF_DWPUnitIndex_h_
+#define SymbolFileDWARF_DWPUnitIndex_h_
+
+#include "lldb/Utility/DataExtractor.h"
+
+#include "llvm/DebugInfo/DWARF/DWARFUnitIndex.h"
+
+/// The .debug_cu_index or .debug_tu_index section of a DWARF package.
+///
+/// Unlike llvm::DWARFUnitIndex, which copies every row into its own tables,
+/// this only validates the header and looks units up in the section's hash
+/// table in place, so opening a package with many units costs nothing until
+/// a unit is used.
+class DWPUnitIndex {
+public:
+  struct Contribution {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  /// Parse the header of \a data. The section data is shared, not copied.
+  bool Parse(const lldb_private::DataExtractor &data);
+
+  uint32_t GetNumUnits() const { return m_num_units; }
+
+  /// Return the row of the unit with signature (DWO id) \a signature, or 0
+  /// if the package doesn't contain it.
+  uint32_t FindRow(uint64_t signature) const;
+
+  /// Get the contribution of the unit in \a row to the section \a kind.
+  /// Return false if the index has no column for \a kind.
+  bool GetContribution(uint32_t row, llvm::DWARFSectionKind kind,
+                       Contribution &contribution) const;
+
+private:
+  lldb_private::DataExtractor m_data;
+  uint32_t m_num_columns = 0;
+  uint32_t m_num_units = 0;
+  uint32_t m_num_buckets = 0;
+  /// The column of each section kind, or UINT32_MAX.
+  uint32_t m_columns[llvm::DW_SECT_MACRO + 1];
+};
+
+#endif // SymbolFileDWARF_DWPUnitIndex_h_
@@ -0,0 +1,122 @@
+//===-- DebugNamesSidecar.cpp -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/SymbolFile/DWARF/DebugNamesSidecar.h"
+#include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/Endian.h"
+#include "lldb/Utility/Log.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace lldb_private;
+
+// Bump this whenever the file format or the generated index changes.
+static const char g_magic[] = "lldb-debug-names 1";
+
+FileSpec DebugNamesSidecar::GetFileSpec(const FileSpec &cache_dir,
+                                        const UUID &uuid) {
+  FileSpec file_spec = cache_dir;
+  file_spec.AppendPathComponent(uuid.GetAsString("") + ".debug_names");
+  return file_spec;
+}
+
+// The file starts with three lines: the magic string, the UUID of the
+// module, and the sizes of the index and of its string table, which follow
+// in that order.
+Status DebugNamesSidecar::Write(const FileSpec &cache_dir, const UUID &uuid,
+                                llvm::StringRef debug_names,
+                                llvm::StringRef debug_str) {
+  Status error;
+  const std::string path = GetFileSpec(cache_dir, uuid).GetPath();
+  if (std::error_code ec =
+          llvm::sys::fs::create_directories(cache_dir.GetPath())) {
+    error.SetErrorStringWithFormat("couldn't create %s: %s",
+                                   cache_dir.GetPath().c_str(),
+                                   ec.message().c_str());
+    return error;
+  }
+
+  // Write a temporary file and rename it into place so that concurrent
+  // debuggers never read a partially written index.
+  int fd;
+  llvm::SmallString<128> temp_path;
+  if (std::error_code ec =
+          llvm::sys::fs::createUniqueFile(path + "-%%%%%%", fd, temp_path)) {
+    error.SetErrorStringWithFormat("couldn't create a temporary file for %s: "
+                                   "%s",
+                                   path.c_str(), ec.message().c_str());
+    return error;
+  }
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << g_magic << '\n'
+       << uuid.GetAsString() << '\n'
+       << debug_names.size() << ' ' << debug_str.size() << '\n'
+       << debug_names << debug_str;
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      error.SetErrorStringWithFormat("couldn't write %s", path.c_str());
+      return error;
+    }
+  }
+
+  if (std::error_code ec = llvm::sys::fs::rename(temp_path, path)) {
+    llvm::sys::fs::remove(temp_path);
+    error.SetErrorStringWithFormat("couldn't write %s: %s", path.c_str(),
+                                   ec.message().c_str());
+  }
+  return error;
+}
+
+bool DebugNamesSidecar::Read(const FileSpec &cache_dir, const UUID &uuid,
+                             DWARFDataExtractor &debug_names,
+                             DWARFDataExtractor &debug_str) {
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
+  const FileSpec file_spec = GetFileSpec(cache_dir, uuid);
+  if (!FileSystem::Instance().Exists(file_spec))
+    return false;
+
+  lldb::DataBufferSP data_sp =
+      FileSystem::Instance().CreateDataBuffer(file_spec);
+  if (!data_sp)
+    return false;
+
+  llvm::StringRef contents(reinterpret_cast<const char *>(data_sp->GetBytes()),
+                           data_sp->GetByteSize());
+  llvm::StringRef magic, uuid_str, sizes;
+  std::tie(magic, contents) = contents.split('\n');
+  std::tie(uuid_str, contents) = contents.split('\n');
+  std::tie(sizes, contents) = contents.split('\n');
+  llvm::StringRef names_size_str, str_size_str;
+  std::tie(names_size_str, str_size_str) = sizes.split(' ');
+  uint64_t names_size, str_size;
+  if (magic != g_magic || uuid_str != uuid.GetAsString() ||
+      names_size_str.getAsInteger(10, names_size) ||
+      str_size_str.getAsInteger(10, str_size) ||
+      contents.size() != names_size + str_size) {
+    LLDB_LOG(log, "ignoring name index {0}: unknown format or module",
+             file_spec);
+    return false;
+  }
+
+  const lldb::offset_t names_offset =
+      contents.data() - reinterpret_cast<const char *>(data_sp->GetBytes());
+  debug_names.SetByteOrder(endian::InlHostByteOrder());
+  debug_names.SetData(data_sp, names_offset, names_size);
+  debug_str.SetByteOrder(endian::InlHostByteOrder());
+  debug_str.SetData(data_sp, names_offset + names_size, str_size);
+  LLDB_LOG(log, "using name index {0}", file_spec);
+  return true;
+}
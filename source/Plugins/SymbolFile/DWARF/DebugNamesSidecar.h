@@ -0,0 +1,39 @@
+//===-- DebugNamesSidecar.h -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_DEBUGNAMESSIDECAR_H
+#define LLDB_DEBUGNAMESSIDECAR_H
+
+#include "Plugins/SymbolFile/DWARF/DWARFDataExtractor.h"
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Status.h"
+#include "lldb/Utility/UUID.h"
+
+namespace lldb_private {
+/// A .debug_names index generated by lldb for a module built without name
+/// indexes, stored in a cache directory under the module's UUID (its build
+/// ID on ELF).
+class DebugNamesSidecar {
+public:
+  static FileSpec GetFileSpec(const FileSpec &cache_dir, const UUID &uuid);
+
+  /// Store \a debug_names and the string table it refers to for the module
+  /// with \a uuid.
+  static Status Write(const FileSpec &cache_dir, const UUID &uuid,
+                      llvm::StringRef debug_names, llvm::StringRef debug_str);
+
+  /// Read the index stored for the module with \a uuid. The extractors share
+  /// a mapping of the file. Return false if there is none, or it was written
+  /// for a different module.
+  static bool Read(const FileSpec &cache_dir, const UUID &uuid,
+                   DWARFDataExtractor &debug_names,
+                   DWARFDataExtractor &debug_str);
+};
+} // namespace lldb_private
+
+#endif // LLDB_DEBUGNAMESSIDECAR_H
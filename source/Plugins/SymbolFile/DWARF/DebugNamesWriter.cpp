@@ -0,0 +1,161 @@
+//===-- DebugNamesWriter.cpp ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/SymbolFile/DWARF/DebugNamesWriter.h"
+
+#include "llvm/Support/DJB.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+using namespace lldb_private;
+
+// Identifies indexes written by lldb rather than by a compiler.
+static const char g_augmentation[] = "LLDB";
+
+void DebugNamesWriter::AddUnit(dw_offset_t cu_offset) {
+  if (m_unit_indexes.try_emplace(cu_offset, m_units.size()).second)
+    m_units.push_back(cu_offset);
+}
+
+void DebugNamesWriter::AddName(llvm::StringRef name, dw_tag_t tag,
+                               dw_offset_t cu_offset, dw_offset_t die_offset) {
+  AddUnit(cu_offset);
+  m_names[name].push_back({tag, m_unit_indexes[cu_offset], die_offset});
+}
+
+template <typename T> static void WriteInt(llvm::raw_ostream &os, T value) {
+  os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void DebugNamesWriter::Write(std::string &debug_names,
+                             std::string &debug_str) const {
+  struct Name {
+    llvm::StringRef string;
+    uint32_t hash;
+    std::vector<Entry> entries;
+  };
+  std::vector<Name> names;
+  names.reserve(m_names.size());
+  for (const auto &name : m_names) {
+    // A DIE can be added under the same name more than once, e.g. as both
+    // the base name and the full name of a C function.
+    std::vector<Entry> entries = name.second;
+    auto as_tuple = [](const Entry &entry) {
+      return std::make_tuple(entry.cu_index, entry.die_offset, entry.tag);
+    };
+    std::sort(entries.begin(), entries.end(),
+              [&](const Entry &lhs, const Entry &rhs) {
+                return as_tuple(lhs) < as_tuple(rhs);
+              });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [&](const Entry &lhs, const Entry &rhs) {
+                                return as_tuple(lhs) == as_tuple(rhs);
+                              }),
+                  entries.end());
+    names.push_back({name.getKey(), llvm::caseFoldingDjbHash(name.getKey()),
+                     std::move(entries)});
+  }
+
+  // Same heuristic as the compiler's: a few names per bucket.
+  const uint32_t name_count = names.size();
+  uint32_t bucket_count = name_count > 1024
+                              ? name_count / 4
+                              : name_count > 16 ? name_count / 2 : name_count;
+  bucket_count = std::max<uint32_t>(bucket_count, 1);
+  // Names that share a bucket have to be adjacent.
+  std::sort(names.begin(), names.end(), [&](const Name &lhs, const Name &rhs) {
+    const uint32_t lhs_bucket = lhs.hash % bucket_count;
+    const uint32_t rhs_bucket = rhs.hash % bucket_count;
+    if (lhs_bucket != rhs_bucket)
+      return lhs_bucket < rhs_bucket;
+    return lhs.string < rhs.string;
+  });
+
+  // One abbreviation per tag; every entry has the same two attributes.
+  std::map<dw_tag_t, uint32_t> abbrev_codes;
+  for (const Name &name : names)
+    for (const Entry &entry : name.entries)
+      abbrev_codes.emplace(entry.tag, 0);
+  std::string abbrevs;
+  {
+    llvm::raw_string_ostream os(abbrevs);
+    uint32_t code = 0;
+    for (auto &tag_and_code : abbrev_codes) {
+      tag_and_code.second = ++code;
+      llvm::encodeULEB128(code, os);
+      llvm::encodeULEB128(tag_and_code.first, os);
+      llvm::encodeULEB128(llvm::dwarf::DW_IDX_compile_unit, os);
+      llvm::encodeULEB128(DW_FORM_udata, os);
+      llvm::encodeULEB128(llvm::dwarf::DW_IDX_die_offset, os);
+      llvm::encodeULEB128(DW_FORM_ref4, os);
+      llvm::encodeULEB128(0, os);
+      llvm::encodeULEB128(0, os);
+    }
+    llvm::encodeULEB128(0, os);
+  }
+
+  std::vector<uint32_t> buckets(bucket_count);
+  std::vector<uint32_t> string_offsets, entry_offsets;
+  std::string entries;
+  debug_str.clear();
+  {
+    llvm::raw_string_ostream entries_os(entries);
+    llvm::raw_string_ostream str_os(debug_str);
+    for (uint32_t i = 0; i < name_count; ++i) {
+      const Name &name = names[i];
+      uint32_t &bucket = buckets[name.hash % bucket_count];
+      if (bucket == 0)
+        bucket = i + 1;
+
+      string_offsets.push_back(str_os.tell());
+      str_os << name.string << '\0';
+
+      entry_offsets.push_back(entries_os.tell());
+      for (const Entry &entry : name.entries) {
+        llvm::encodeULEB128(abbrev_codes[entry.tag], entries_os);
+        llvm::encodeULEB128(entry.cu_index, entries_os);
+        WriteInt<uint32_t>(entries_os, entry.die_offset);
+      }
+      llvm::encodeULEB128(0, entries_os);
+    }
+  }
+
+  debug_names.clear();
+  llvm::raw_string_ostream os(debug_names);
+  WriteInt<uint32_t>(os, 0); // unit_length, patched below.
+  WriteInt<uint16_t>(os, 5); // version
+  WriteInt<uint16_t>(os, 0); // padding
+  WriteInt<uint32_t>(os, m_units.size());
+  WriteInt<uint32_t>(os, 0); // local_type_unit_count
+  WriteInt<uint32_t>(os, 0); // foreign_type_unit_count
+  WriteInt<uint32_t>(os, bucket_count);
+  WriteInt<uint32_t>(os, name_count);
+  WriteInt<uint32_t>(os, abbrevs.size());
+  WriteInt<uint32_t>(os, sizeof(g_augmentation) - 1);
+  os.write(g_augmentation, sizeof(g_augmentation) - 1);
+  for (dw_offset_t cu_offset : m_units)
+    WriteInt<uint32_t>(os, cu_offset);
+  for (uint32_t bucket : buckets)
+    WriteInt<uint32_t>(os, bucket);
+  for (const Name &name : names)
+    WriteInt<uint32_t>(os, name.hash);
+  for (uint32_t offset : string_offsets)
+    WriteInt<uint32_t>(os, offset);
+  for (uint32_t offset : entry_offsets)
+    WriteInt<uint32_t>(os, offset);
+  os << abbrevs << entries;
+  os.flush();
+
+  const uint32_t unit_length = debug_names.size() - sizeof(uint32_t);
+  memcpy(&debug_names[0], &unit_length, sizeof(unit_length));
+}
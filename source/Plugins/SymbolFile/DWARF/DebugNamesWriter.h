@@ -0,0 +1,55 @@
+//===-- DebugNamesWriter.h --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_DEBUGNAMESWRITER_H
+#define LLDB_DEBUGNAMESWRITER_H
+
+#include "lldb/Core/dwarf.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <string>
+#include <vector>
+
+namespace lldb_private {
+/// Encodes a DWARF 5 name index (.debug_names) for DWARF that was built
+/// without one, so that it can be read back by DebugNamesDWARFIndex.
+///
+/// The index is written in the host byte order, and its names are stored in
+/// a string table of its own instead of referring to .debug_str.
+class DebugNamesWriter {
+public:
+  /// Add a unit to the list of units the index covers. Every unit that was
+  /// indexed must be added, even if it has no names, or readers will index
+  /// it again.
+  void AddUnit(dw_offset_t cu_offset);
+
+  /// Add the DIE at \a die_offset, relative to the start of its unit (or of
+  /// its .dwo unit), to the entries for \a name.
+  void AddName(llvm::StringRef name, dw_tag_t tag, dw_offset_t cu_offset,
+               dw_offset_t die_offset);
+
+  /// Encode the index into \a debug_names and the strings it refers to into
+  /// \a debug_str.
+  void Write(std::string &debug_names, std::string &debug_str) const;
+
+private:
+  struct Entry {
+    dw_tag_t tag;
+    uint32_t cu_index;
+    dw_offset_t die_offset;
+  };
+
+  std::vector<dw_offset_t> m_units;
+  llvm::DenseMap<dw_offset_t, uint32_t> m_unit_indexes;
+  llvm::StringMap<std::vector<Entry>> m_names;
+};
+} // namespace lldb_private
+
+#endif // LLDB_DEBUGNAMESWRITER_H
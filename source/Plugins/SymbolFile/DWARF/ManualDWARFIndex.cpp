@@ -10,6 +10,7 @@
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
+#include "Plugins/SymbolFile/DWARF/DebugNamesWriter.h"
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
 #include "lldb/Core/Module.h"
@@ -67,6 +68,9 @@ void ManualDWARFIndex::Index() {
   // to wait until all compile units have been indexed in case a DIE in one
   // compile unit refers to another and the indexes accesses those DIEs.
   //----------------------------------------------------------------------
+  // Extracting a split DWARF unit opens its .dwo file, so read all of them
+  // up front instead of one at a time below.
+  units_to_index[0]->GetSymbolFileDWARF()->PrefetchDwoFiles(units_to_index);
   for (int i=0; i<units_to_index.size(); ++i) {
      extract_fn(i);
   }
@@ -96,6 +100,9 @@ void ManualDWARFIndex::Index() {
 }
 
 void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, IndexSet &set) {
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "unit = 0x%8.8x", unit.GetOffset());
+
   Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_LOOKUPS);
 
   if (log) {
@@ -477,3 +484,38 @@ void ManualDWARFIndex::Dump(Stream &s) {
   s.Printf("\nNamespaces:\n");
   m_set.namespaces.Dump(&s);
 }
+
+void ManualDWARFIndex::AddToDebugNames(DWARFDebugInfo &info,
+                                       DebugNamesWriter &writer) {
+  Index();
+
+  for (size_t U = 0; U < info.GetNumCompileUnits(); ++U) {
+    DWARFUnit *unit = info.GetCompileUnitAtIndex(U);
+    if (unit && m_units_to_avoid.count(unit->GetOffset()) == 0)
+      writer.AddUnit(unit->GetOffset());
+  }
+
+  auto add_names = [&](const NameToDIE &names) {
+    names.ForEach([&](ConstString name, const DIERef &ref) {
+      DWARFDIE die = info.GetDIE(ref);
+      if (!die)
+        return true;
+      // Like DW_IDX_die_offset, DIE offsets in .dwo files are relative to
+      // their unit already.
+      DWARFUnit *cu = info.GetCompileUnit(ref.cu_offset);
+      const dw_offset_t die_bias = cu->GetDwoSymbolFile() ? 0 : ref.cu_offset;
+      writer.AddName(name.GetStringRef(), die.Tag(), ref.cu_offset,
+                     ref.die_offset - die_bias);
+      return true;
+    });
+  };
+  // Objective-C methods are not indexed by class name: DebugNamesDWARFIndex
+  // would return them as functions named after the class.
+  add_names(m_set.function_basenames);
+  add_names(m_set.function_fullnames);
+  add_names(m_set.function_methods);
+  add_names(m_set.function_selectors);
+  add_names(m_set.globals);
+  add_names(m_set.types);
+  add_names(m_set.namespaces);
+}
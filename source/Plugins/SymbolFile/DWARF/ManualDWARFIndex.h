@@ -14,6 +14,8 @@
 #include "llvm/ADT/DenseSet.h"
 
 namespace lldb_private {
+class DebugNamesWriter;
+
 class ManualDWARFIndex : public DWARFIndex {
 public:
   ManualDWARFIndex(Module &module, DWARFDebugInfo *debug_info,
@@ -43,6 +45,10 @@ public:
                               llvm::StringRef name) override {}
   void Dump(Stream &s) override;
 
+  /// Add the units and names of this index to \a writer. The DIEs of the
+  /// units in \a info are extracted to look up their tags.
+  void AddToDebugNames(DWARFDebugInfo &info, DebugNamesWriter &writer);
+
 private:
   struct IndexSet {
     NameToDIE function_basenames;
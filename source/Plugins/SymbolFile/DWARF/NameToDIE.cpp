@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "NameToDIE.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
@@ -23,6 +24,8 @@ using namespace lldb_private;
 void NameToDIE::Finalize() {
   m_map.Sort();
   m_map.SizeToFit();
+  if (ModuleList::GetGlobalModuleListProperties().GetUseNameLookupFilters())
+    m_map.BuildFilter();
 }
 
 void NameToDIE::Insert(ConstString name, const DIERef &die_ref) {
@@ -63,7 +63,10 @@
 #include "DWARFDeclContext.h"
 #include "DWARFFormValue.h"
 #include "DWARFUnit.h"
+#include "DWOFileCache.h"
 #include "DebugNamesDWARFIndex.h"
+#include "DebugNamesSidecar.h"
+#include "DebugNamesWriter.h"
 #include "LogChannelDWARF.h"
 #include "ManualDWARFIndex.h"
 #include "SymbolFileDWARFDebugMap.h"
@@ -118,11 +121,16 @@ static constexpr PropertyDefinition g_properties[] = {
      "links will be resolved at DWARF parse time."},
     {"ignore-file-indexes", OptionValue::eTypeBoolean, true, 0, nullptr, {},
      "Ignore indexes present in the object files and always index DWARF "
-     "manually."}};
+     "manually."},
+    {"dwo-prefetch-threads", OptionValue::eTypeUInt64, true, 16, nullptr, {},
+     "The maximum number of split DWARF .dwo files read concurrently before "
+     "a module is indexed. 0 reads each file when its compile unit is first "
+     "used."}};
 
 enum {
   ePropertySymLinkPaths,
   ePropertyIgnoreIndexes,
+  ePropertyDwoPrefetchThreads,
 };
 
 class PluginProperties : public Properties {
@@ -148,6 +156,12 @@ public:
     return m_collection_sp->GetPropertyAtIndexAsBoolean(
         nullptr, ePropertyIgnoreIndexes, false);
   }
+
+  uint64_t GetDwoPrefetchThreads() const {
+    const uint32_t idx = ePropertyDwoPrefetchThreads;
+    return m_collection_sp->GetPropertyAtIndexAsUInt64(
+        nullptr, idx, g_properties[idx].default_uint_value);
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
@@ -437,12 +451,82 @@ void SymbolFileDWARF::InitializeObject() {
       LLDB_LOG_ERROR(log, index_or.takeError(),
                      "Unable to read .debug_names data: {0}");
     }
+
+    m_index = LoadDebugNamesSidecar();
+    if (m_index)
+      return;
   }
 
   m_index = llvm::make_unique<ManualDWARFIndex>(*GetObjectFile()->GetModule(),
                                                 DebugInfo());
 }
 
+std::unique_ptr<DWARFIndex> SymbolFileDWARF::LoadDebugNamesSidecar() {
+  // .dwo files are covered by the index of their skeleton units.
+  if (GetBaseCompileUnit())
+    return nullptr;
+
+  Module &module = *GetObjectFile()->GetModule();
+  const FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetDebugNamesCachePath();
+  if (!cache_dir || !module.GetUUID().IsValid())
+    return nullptr;
+
+  DWARFDataExtractor debug_names, debug_str;
+  if (!DebugNamesSidecar::Read(cache_dir, module.GetUUID(), debug_names,
+                               debug_str))
+    return nullptr;
+
+  llvm::Expected<std::unique_ptr<DebugNamesDWARFIndex>> index_or =
+      DebugNamesDWARFIndex::Create(module, debug_names, debug_str,
+                                   DebugInfo());
+  if (!index_or) {
+    LLDB_LOG_ERROR(LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO),
+                   index_or.takeError(),
+                   "Unable to read generated .debug_names data: {0}");
+    return nullptr;
+  }
+  return std::move(*index_or);
+}
+
+Status SymbolFileDWARF::WriteDebugNames() {
+  Status error;
+  Module &module = *GetObjectFile()->GetModule();
+  const FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetDebugNamesCachePath();
+  if (!cache_dir) {
+    error.SetErrorString("symbols.debug-names-cache-path is not set");
+    return error;
+  }
+  if (!module.GetUUID().IsValid()) {
+    error.SetErrorString("the module has no UUID");
+    return error;
+  }
+
+  DWARFDataExtractor debug_names, apple_names;
+  LoadSectionData(eSectionTypeDWARFDebugNames, debug_names);
+  LoadSectionData(eSectionTypeDWARFAppleNames, apple_names);
+  if (debug_names.GetByteSize() > 0 || apple_names.GetByteSize() > 0) {
+    error.SetErrorString("the module already has a name index");
+    return error;
+  }
+
+  DWARFDebugInfo *info = DebugInfo();
+  if (!info) {
+    error.SetErrorString("the module has no debug info");
+    return error;
+  }
+
+  // Index from scratch rather than reuse m_index, which may have been read
+  // from an earlier sidecar.
+  DebugNamesWriter writer;
+  ManualDWARFIndex(module, info).AddToDebugNames(*info, writer);
+  std::string names_data, str_data;
+  writer.Write(names_data, str_data);
+  return DebugNamesSidecar::Write(cache_dir, module.GetUUID(), names_data,
+                                  str_data);
+}
+
 bool SymbolFileDWARF::SupportedVersion(uint16_t version) {
   return version >= 2 && version <= 5;
 }
@@ -1563,6 +1647,28 @@ SymbolFileDWARF::GetDIE(const DIERef &die_ref) {
     return DWARFDIE();
 }
 
+FileSpec SymbolFileDWARF::GetDwoFileSpec(DWARFUnit &dwarf_cu,
+                                         const DWARFDebugInfoEntry &cu_die) {
+  const char *dwo_name = cu_die.GetAttributeValueAsString(
+      this, &dwarf_cu, DW_AT_GNU_dwo_name, nullptr);
+  if (!dwo_name)
+    return FileSpec();
+
+  FileSpec dwo_file(dwo_name);
+  FileSystem::Instance().Resolve(dwo_file);
+  if (dwo_file.IsRelative()) {
+    const char *comp_dir = cu_die.GetAttributeValueAsString(
+        this, &dwarf_cu, DW_AT_comp_dir, nullptr);
+    if (!comp_dir)
+      return FileSpec();
+
+    dwo_file.SetFile(comp_dir, FileSpec::Style::native);
+    FileSystem::Instance().Resolve(dwo_file);
+    dwo_file.AppendPathComponent(dwo_name);
+  }
+  return dwo_file;
+}
+
 std::unique_ptr<SymbolFileDWARFDwo>
 SymbolFileDWARF::GetDwoSymbolFileForCompileUnit(
     DWARFUnit &dwarf_cu, const DWARFDebugInfoEntry &cu_die) {
@@ -1587,35 +1693,122 @@ SymbolFileDWARF::GetDwoSymbolFileForCompileUnit(
       return dwo_symfile;
   }
 
-  FileSpec dwo_file(dwo_name);
-  FileSystem::Instance().Resolve(dwo_file);
-  if (dwo_file.IsRelative()) {
-    const char *comp_dir = cu_die.GetAttributeValueAsString(
-        this, &dwarf_cu, DW_AT_comp_dir, nullptr);
-    if (!comp_dir)
-      return nullptr;
-
-    dwo_file.SetFile(comp_dir, FileSpec::Style::native);
-    FileSystem::Instance().Resolve(dwo_file);
-    dwo_file.AppendPathComponent(dwo_name);
-  }
-
-  if (!FileSystem::Instance().Exists(dwo_file))
+  FileSpec dwo_file = GetDwoFileSpec(dwarf_cu, cu_die);
+  if (!dwo_file)
     return nullptr;
 
-  const lldb::offset_t file_offset = 0;
+  const auto start = std::chrono::steady_clock::now();
+  const std::string dwo_path = dwo_file.GetPath();
   DataBufferSP dwo_file_data_sp;
-  lldb::offset_t dwo_file_data_offset = 0;
-  ObjectFileSP dwo_obj_file = ObjectFile::FindPlugin(
-      GetObjectFile()->GetModule(), &dwo_file, file_offset,
-      FileSystem::Instance().GetByteSize(dwo_file), dwo_file_data_sp,
-      dwo_file_data_offset);
-  if (dwo_obj_file == nullptr)
+  {
+    std::lock_guard<std::mutex> guard(m_dwo_mutex);
+    auto pos = m_prefetched_dwo_files.find(dwo_path);
+    if (pos != m_prefetched_dwo_files.end()) {
+      dwo_file_data_sp = std::move(pos->second);
+      m_prefetched_dwo_files.erase(pos);
+    }
+  }
+  if (!dwo_file_data_sp)
+    dwo_file_data_sp = DWOFileCache::GetGlobal().GetFileData(dwo_file);
+
+  ObjectFileSP dwo_obj_file;
+  if (dwo_file_data_sp) {
+    const lldb::offset_t file_offset = 0;
+    lldb::offset_t dwo_file_data_offset = 0;
+    dwo_obj_file = ObjectFile::FindPlugin(
+        GetObjectFile()->GetModule(), &dwo_file, file_offset,
+        dwo_file_data_sp->GetByteSize(), dwo_file_data_sp,
+        dwo_file_data_offset);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_dwo_mutex);
+    m_dwo_load_time += std::chrono::steady_clock::now() - start;
+    if (dwo_obj_file)
+      ++m_num_dwo_files_loaded;
+    else
+      m_missing_dwo_files.push_back(dwo_path);
+  }
+  if (dwo_obj_file == nullptr) {
+    Log *log(LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+    if (log)
+      GetObjectFile()->GetModule()->LogMessage(
+          log, "unable to load split DWARF file %s", dwo_path.c_str());
     return nullptr;
+  }
 
   return llvm::make_unique<SymbolFileDWARFDwo>(dwo_obj_file, &dwarf_cu);
 }
 
+void SymbolFileDWARF::PrefetchDwoFiles(llvm::ArrayRef<DWARFUnit *> units) {
+  const size_t max_threads =
+      GetGlobalPluginProperties()->GetDwoPrefetchThreads();
+  if (max_threads == 0 || GetDebugMapSymfile() || GetDwpSymbolFile())
+    return;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "SymbolFileDWARF::PrefetchDwoFiles (%zu units)",
+                     units.size());
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<FileSpec> dwo_files;
+  for (DWARFUnit *unit : units) {
+    // Read the unit DIE on its own; extracting the unit would open its .dwo
+    // file right away.
+    DWARFDebugInfoEntry cu_die;
+    lldb::offset_t offset = unit->GetFirstDIEOffset();
+    if (!cu_die.FastExtract(unit->GetData(), unit, unit->GetFixedFormSizes(),
+                            &offset))
+      continue;
+    FileSpec dwo_file = GetDwoFileSpec(*unit, cu_die);
+    if (dwo_file)
+      dwo_files.push_back(dwo_file);
+  }
+  if (dwo_files.size() < 2)
+    return;
+
+  std::vector<DataBufferSP> dwo_file_data =
+      DWOFileCache::GetGlobal().GetFileData(dwo_files, max_threads);
+
+  std::lock_guard<std::mutex> guard(m_dwo_mutex);
+  for (size_t i = 0; i < dwo_files.size(); ++i)
+    if (dwo_file_data[i])
+      m_prefetched_dwo_files[dwo_files[i].GetPath()] =
+          std::move(dwo_file_data[i]);
+  m_dwo_load_time += std::chrono::steady_clock::now() - start;
+}
+
+void SymbolFileDWARF::DumpStatistics(Stream &s) {
+  std::lock_guard<std::mutex> guard(m_dwo_mutex);
+  if (m_num_dwo_files_loaded == 0 && m_missing_dwo_files.empty())
+    return;
+
+  s.Printf("%s: loaded %u .dwo files in %.3fs, %zu missing\n",
+           GetObjectFile()->GetFileSpec().GetPath().c_str(),
+           m_num_dwo_files_loaded, m_dwo_load_time.count(),
+           m_missing_dwo_files.size());
+  // There can be thousands; the log has all of them.
+  const size_t max_missing_to_list = 10;
+  for (size_t i = 0;
+       i < std::min(m_missing_dwo_files.size(), max_missing_to_list); ++i)
+    s.Printf("  missing: %s\n", m_missing_dwo_files[i].c_str());
+  if (m_missing_dwo_files.size() > max_missing_to_list)
+    s.Printf("  ... and %zu more\n",
+             m_missing_dwo_files.size() - max_missing_to_list);
+}
+
+size_t SymbolFileDWARF::GetDebugInfoMemoryUsage() {
+  // Don't parse .debug_info just to find out it uses no memory.
+  if (!m_info)
+    return 0;
+  size_t usage = 0;
+  const size_t num_units = m_info->GetNumCompileUnits();
+  for (size_t idx = 0; idx < num_units; ++idx)
+    if (DWARFUnit *unit = m_info->GetCompileUnitAtIndex(idx))
+      usage += unit->GetDIEMemoryUsage();
+  return usage;
+}
+
 void SymbolFileDWARF::UpdateExternalModuleListIfNeeded() {
   if (m_fetched_external_modules)
     return;
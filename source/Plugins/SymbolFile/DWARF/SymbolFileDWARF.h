@@ -9,6 +9,7 @@
 #ifndef SymbolFileDWARF_SymbolFileDWARF_h_
 #define SymbolFileDWARF_SymbolFileDWARF_h_
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <mutex>
@@ -17,6 +18,7 @@
 #include <vector>
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/Threading.h"
 
 #include "lldb/Utility/Flags.h"
@@ -29,6 +31,7 @@
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/Status.h"
 #include "lldb/lldb-private.h"
 
 #include "DWARFDataExtractor.h"
@@ -316,6 +319,12 @@ public:
   GetDwoSymbolFileForCompileUnit(DWARFUnit &dwarf_cu,
                                  const DWARFDebugInfoEntry &cu_die);
 
+  /// Read the .dwo files of \a units concurrently so that extracting the
+  /// units doesn't wait on each file in turn. Only the file contents are read
+  /// here; the object files are still created by
+  /// GetDwoSymbolFileForCompileUnit.
+  void PrefetchDwoFiles(llvm::ArrayRef<DWARFUnit *> units);
+
   // For regular SymbolFileDWARF instances the method returns nullptr,
   // for the instances of the subclass SymbolFileDWARFDwo
   // the method returns a pointer to the base compile unit.
@@ -332,6 +341,15 @@ public:
 
   void DumpClangAST(lldb_private::Stream &s) override;
 
+  void DumpStatistics(lldb_private::Stream &s) override;
+
+  size_t GetDebugInfoMemoryUsage() override;
+
+  /// Generate a name index for a module built without .debug_names or Apple
+  /// accelerator tables, and store it in symbols.debug-names-cache-path for
+  /// later sessions to use instead of indexing the DWARF again.
+  lldb_private::Status WriteDebugNames();
+
 protected:
   typedef llvm::DenseMap<const DWARFDebugInfoEntry *, lldb_private::Type *>
       DIEToTypePtr;
@@ -474,12 +492,28 @@ protected:
 
   SymbolFileDWARFDwp *GetDwpSymbolFile();
 
+  /// Return the index stored by WriteDebugNames for this module, if any.
+  std::unique_ptr<lldb_private::DWARFIndex> LoadDebugNamesSidecar();
+
+  lldb_private::FileSpec GetDwoFileSpec(DWARFUnit &dwarf_cu,
+                                        const DWARFDebugInfoEntry &cu_die);
+
   lldb::ModuleWP m_debug_map_module_wp;
   SymbolFileDWARFDebugMap *m_debug_map_symfile;
 
   llvm::once_flag m_dwp_symfile_once_flag;
   std::unique_ptr<SymbolFileDWARFDwp> m_dwp_symfile;
 
+  /// Split DWARF bookkeeping, guarded by m_dwo_mutex.
+  /// @{
+  std::mutex m_dwo_mutex;
+  /// Contents of .dwo files read by PrefetchDwoFiles and not yet used.
+  llvm::StringMap<lldb::DataBufferSP> m_prefetched_dwo_files;
+  std::chrono::duration<double> m_dwo_load_time{};
+  uint32_t m_num_dwo_files_loaded = 0;
+  std::vector<std::string> m_missing_dwo_files;
+  /// @}
+
   lldb_private::DWARFDataExtractor m_dwarf_data;
 
   DWARFDataSegment m_data_debug_abbrev;
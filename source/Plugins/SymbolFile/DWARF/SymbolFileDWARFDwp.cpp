@@ -59,30 +59,22 @@ SymbolFileDWARFDwp::Create(lldb::ModuleSP module_sp,
                                        debug_cu_index))
     return nullptr;
 
-  llvm::DataExtractor llvm_debug_cu_index(
-      llvm::StringRef(debug_cu_index.PeekCStr(0), debug_cu_index.GetByteSize()),
-      debug_cu_index.GetByteOrder() == lldb::eByteOrderLittle,
-      debug_cu_index.GetAddressByteSize());
-  if (!dwp_symfile->m_debug_cu_index.parse(llvm_debug_cu_index))
+  if (!dwp_symfile->m_debug_cu_index.Parse(debug_cu_index))
     return nullptr;
-  dwp_symfile->InitDebugCUIndexMap();
   return dwp_symfile;
 }
 
-void SymbolFileDWARFDwp::InitDebugCUIndexMap() {
-  m_debug_cu_index_map.clear();
-  for (const auto &entry : m_debug_cu_index.getRows())
-    m_debug_cu_index_map.emplace(entry.getSignature(), &entry);
-}
-
 SymbolFileDWARFDwp::SymbolFileDWARFDwp(lldb::ModuleSP module_sp,
                                        lldb::ObjectFileSP obj_file)
-    : m_obj_file(std::move(obj_file)), m_debug_cu_index(llvm::DW_SECT_INFO) 
-{}
+    : m_obj_file(std::move(obj_file)) {}
 
 std::unique_ptr<SymbolFileDWARFDwo>
 SymbolFileDWARFDwp::GetSymbolFileForDwoId(DWARFUnit *dwarf_cu,
                                           uint64_t dwo_id) {
+  // Let the caller look for a standalone .dwo file instead.
+  if (m_debug_cu_index.FindRow(dwo_id) == 0)
+    return nullptr;
+
   return std::unique_ptr<SymbolFileDWARFDwo>(
       new SymbolFileDWARFDwoDwp(this, m_obj_file, dwarf_cu, dwo_id));
 }
@@ -94,17 +86,18 @@ bool SymbolFileDWARFDwp::LoadSectionData(
   if (!LoadRawSectionData(sect_type, section_data))
     return false;
 
-  auto it = m_debug_cu_index_map.find(dwo_id);
-  if (it == m_debug_cu_index_map.end())
+  const uint32_t row = m_debug_cu_index.FindRow(dwo_id);
+  if (row == 0)
     return false;
 
-  auto *offsets =
-      it->second->getOffset(lldbSectTypeToLlvmSectionKind(sect_type));
-  if (offsets) {
-    data.SetData(section_data, offsets->Offset, offsets->Length);
-  } else {
+  // Sections without a column in the index, such as .debug_str, are shared
+  // by all units.
+  DWPUnitIndex::Contribution contribution;
+  if (m_debug_cu_index.GetContribution(
+          row, lldbSectTypeToLlvmSectionKind(sect_type), contribution))
+    data.SetData(section_data, contribution.offset, contribution.length);
+  else
     data.SetData(section_data, 0, section_data.GetByteSize());
-  }
   return true;
 }
 
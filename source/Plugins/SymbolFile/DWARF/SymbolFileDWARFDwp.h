@@ -11,11 +11,10 @@
 
 #include <memory>
 
-#include "llvm/DebugInfo/DWARF/DWARFUnitIndex.h"
-
 #include "lldb/Core/Module.h"
 
 #include "DWARFDataExtractor.h"
+#include "DWPUnitIndex.h"
 #include "SymbolFileDWARFDwo.h"
 
 class SymbolFileDWARFDwp {
@@ -35,16 +34,13 @@ private:
 
   bool LoadRawSectionData(lldb::SectionType sect_type,
                           lldb_private::DWARFDataExtractor &data);
-  
-  void InitDebugCUIndexMap();
 
   lldb::ObjectFileSP m_obj_file;
 
   std::mutex m_sections_mutex;
   std::map<lldb::SectionType, lldb_private::DWARFDataExtractor> m_sections;
 
-  llvm::DWARFUnitIndex m_debug_cu_index;
-  std::map<uint64_t, const llvm::DWARFUnitIndex::Entry *> m_debug_cu_index_map;
+  DWPUnitIndex m_debug_cu_index;
 };
 
 #endif // SymbolFileDWARFDwp_SymbolFileDWARFDwp_h_
@@ -72,6 +72,7 @@
 
 #include "lldb/Core/DumpDataExtractor.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/ThreadSafeDenseMap.h"
@@ -659,7 +660,8 @@ ClangASTContext::ClangASTContext(const char *target_triple)
       m_target_options_rp(), m_target_info_up(), m_identifier_table_up(),
       m_selector_table_up(), m_builtins_up(), m_callback_tag_decl(nullptr),
       m_callback_objc_decl(nullptr), m_callback_baton(nullptr),
-      m_pointer_byte_size(0), m_ast_owned(false) {
+      m_pointer_byte_size(0), m_ast_owned(false),
+      m_lazy_member_functions(false) {
   if (target_triple && target_triple[0])
     SetTargetTriple(target_triple);
 }
@@ -670,7 +672,8 @@ ClangASTContext::ClangASTContext(clang::ASTContext *ast_ctx)
       m_target_options_rp(), m_target_info_up(), m_identifier_table_up(),
       m_selector_table_up(), m_builtins_up(), m_callback_tag_decl(nullptr),
       m_callback_objc_decl(nullptr), m_callback_baton(nullptr),
-      m_pointer_byte_size(0), m_ast_owned(false) {}
+      m_pointer_byte_size(0), m_ast_owned(false),
+      m_lazy_member_functions(false) {}
 
 //----------------------------------------------------------------------
 // Destructor
@@ -791,6 +794,13 @@ void ClangASTContext::Finalize() {
   m_scratch_ast_source_up.reset();
 }
 
+size_t ClangASTContext::GetMemoryUsage() {
+  if (!m_ast_up)
+    return 0;
+  return m_ast_up->getASTAllocatedMemory() +
+         m_ast_up->getSideTableAllocatedMemory();
+}
+
 void ClangASTContext::Clear() {
   m_ast_up.reset();
   m_language_options_up.reset();
@@ -875,10 +885,17 @@ ASTContext *ClangASTContext::getASTContext() {
 
     GetASTMap().Insert(m_ast_up.get(), this);
 
+    // Name lookups only need to reach the external source when member
+    // functions may have been left out of their classes.
+    m_lazy_member_functions = ModuleList::GetGlobalModuleListProperties()
+                                  .GetLazyMemberFunctionParsing();
     llvm::IntrusiveRefCntPtr<clang::ExternalASTSource> ast_source_up(
         new ClangExternalASTSourceCallbacks(
             ClangASTContext::CompleteTagDecl,
-            ClangASTContext::CompleteObjCInterfaceDecl, nullptr,
+            ClangASTContext::CompleteObjCInterfaceDecl,
+            m_lazy_member_functions
+                ? ClangASTContext::FindExternalVisibleDeclsByName
+                : nullptr,
             ClangASTContext::LayoutRecordType, this));
     SetExternalSource(ast_source_up);
   }
@@ -9925,6 +9942,11 @@ clang::ClassTemplateDecl *ClangASTContext::ParseClassTemplateDecl(
 
 void ClangASTContext::CompleteTagDecl(void *baton, clang::TagDecl *decl) {
   ClangASTContext *ast = (ClangASTContext *)baton;
+  // A complete class can still be missing the member functions that weren't
+  // needed to lay it out.
+  if (ast->m_dwarf_ast_parser_up &&
+      ast->m_dwarf_ast_parser_up->CompletePendingMethods(decl))
+    return;
   SymbolFile *sym_file = ast->GetSymbolFile();
   if (sym_file) {
     CompilerType clang_type = GetTypeForDecl(decl);
@@ -9944,6 +9966,15 @@ void ClangASTContext::CompleteObjCInterfaceDecl(
   }
 }
 
+void ClangASTContext::FindExternalVisibleDeclsByName(
+    void *baton, const clang::DeclContext *decl_ctx,
+    clang::DeclarationName name,
+    llvm::SmallVectorImpl<clang::NamedDecl *> *results) {
+  ClangASTContext *ast = (ClangASTContext *)baton;
+  if (ast->m_dwarf_ast_parser_up && results)
+    ast->m_dwarf_ast_parser_up->FindPendingMethods(decl_ctx, name, *results);
+}
+
 DWARFASTParser *ClangASTContext::GetDWARFParser() {
   if (!m_dwarf_ast_parser_up)
     m_dwarf_ast_parser_up.reset(new DWARFASTParserClang(*this));
@@ -814,6 +814,44 @@ void ClangASTImporter::ForgetSource(clang::ASTContext *dst_ast,
   }
 }
 
+bool ClangASTImporter::LookupCachedType(ConstString name,
+                                        lldb::TypeSP &type_sp) {
+  auto pos = m_type_lookup_cache.find(name.GetCString());
+  if (pos == m_type_lookup_cache.end()) {
+    ++m_lookup_cache_misses;
+    return false;
+  }
+  ++m_lookup_cache_hits;
+  type_sp = pos->second;
+  return true;
+}
+
+void ClangASTImporter::CacheTypeLookup(ConstString name,
+                                       const lldb::TypeSP &type_sp) {
+  m_type_lookup_cache[name.GetCString()] = type_sp;
+}
+
+ClangASTImporter::NamespaceMapSP
+ClangASTImporter::LookupCachedNamespaces(ConstString name) {
+  auto pos = m_namespace_lookup_cache.find(name.GetCString());
+  if (pos == m_namespace_lookup_cache.end()) {
+    ++m_lookup_cache_misses;
+    return NamespaceMapSP();
+  }
+  ++m_lookup_cache_hits;
+  return pos->second;
+}
+
+void ClangASTImporter::CacheNamespaceLookup(
+    ConstString name, const NamespaceMapSP &namespace_map) {
+  m_namespace_lookup_cache[name.GetCString()] = namespace_map;
+}
+
+void ClangASTImporter::ClearLookupCache() {
+  m_type_lookup_cache.clear();
+  m_namespace_lookup_cache.clear();
+}
+
 ClangASTImporter::MapCompleter::~MapCompleter() { return; }
 
 void ClangASTImporter::Minion::InitDeportWorkQueues(
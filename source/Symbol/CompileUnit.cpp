@@ -200,6 +200,10 @@ LineTable *CompileUnit::GetLineTable() {
   return m_line_table_up.get();
 }
 
+size_t CompileUnit::GetLineTableMemoryUsage() const {
+  return m_line_table_up ? m_line_table_up->GetMemoryUsage() : 0;
+}
+
 void CompileUnit::SetLineTable(LineTable *line_table) {
   if (line_table == nullptr)
     m_flags.Clear(flagsParsedLineTable);
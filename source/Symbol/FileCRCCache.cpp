@@ -0,0 +1,355 @@
+//===-- FileCRCCache.cpp ----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/FileCRCCache.h"
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+#include "lldb/Utility/Timer.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+using namespace lldb_private;
+
+// Bump this whenever the file format changes.
+static const char g_magic[] = "lldb-crc-cache 1";
+static const char g_file_name[] = "crc32-cache";
+
+// Entries beyond this many are dropped, starting with the ones for files
+// that changed or went away.
+static const size_t g_max_entries = 4096;
+
+// Buffers smaller than this are checksummed on the calling thread.
+static const size_t g_min_chunk_size = 32 * 1024 * 1024;
+
+std::atomic<uint64_t> FileCRCCache::g_cache_hits(0);
+std::atomic<uint64_t> FileCRCCache::g_cache_misses(0);
+std::atomic<uint64_t> FileCRCCache::g_microseconds_saved(0);
+
+namespace {
+typedef std::array<std::array<uint32_t, 256>, 8> CRC32Tables;
+} // namespace
+
+// Tables for the reflected CRC-32 polynomial 0xedb88320, extended to process
+// eight bytes at a time ("slicing-by-8").
+static const CRC32Tables &GetCRC32Tables() {
+  static const CRC32Tables g_tables = [] {
+    CRC32Tables tables;
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit)
+        crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+      tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+      for (size_t t = 1; t < tables.size(); ++t)
+        tables[t][i] =
+            (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xff];
+    return tables;
+  }();
+  return g_tables;
+}
+
+static uint32_t CRC32Serial(uint32_t crc, const uint8_t *p, size_t size) {
+  const CRC32Tables &t = GetCRC32Tables();
+  crc = ~crc;
+  for (; size >= 8; p += 8, size -= 8) {
+    const uint32_t lo =
+        (p[0] | p[1] << 8 | p[2] << 16 | uint32_t(p[3]) << 24) ^ crc;
+    const uint32_t hi = p[4] | p[5] << 8 | p[6] << 16 | uint32_t(p[7]) << 24;
+    crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^
+          t[4][lo >> 24] ^ t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+          t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+  }
+  while (size--)
+    crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+  return ~crc;
+}
+
+static uint32_t GF2MatrixTimes(const uint32_t *mat, uint32_t vec) {
+  uint32_t sum = 0;
+  for (; vec; vec >>= 1, ++mat)
+    if (vec & 1)
+      sum ^= *mat;
+  return sum;
+}
+
+static void GF2MatrixSquare(uint32_t *square, const uint32_t *mat) {
+  for (int n = 0; n < 32; ++n)
+    square[n] = GF2MatrixTimes(mat, mat[n]);
+}
+
+// Return the CRC32 of the concatenation of two buffers, given the CRC32 of
+// each of them and the length of the second one. This is the algorithm of
+// zlib's crc32_combine.
+static uint32_t CRC32Combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+  if (len2 == 0)
+    return crc1;
+
+  uint32_t even[32]; // Operator for an even number of zero bits.
+  uint32_t odd[32];  // Operator for an odd number of zero bits.
+
+  // The operator for one zero bit.
+  odd[0] = 0xedb88320;
+  uint32_t row = 1;
+  for (int n = 1; n < 32; ++n, row <<= 1)
+    odd[n] = row;
+
+  GF2MatrixSquare(even, odd); // Two zero bits.
+  GF2MatrixSquare(odd, even); // Four zero bits.
+
+  // Apply len2 zero bytes to crc1; the first square puts the operator for
+  // one zero byte in even.
+  do {
+    GF2MatrixSquare(even, odd);
+    if (len2 & 1)
+      crc1 = GF2MatrixTimes(even, crc1);
+    len2 >>= 1;
+    if (len2 == 0)
+      break;
+    GF2MatrixSquare(odd, even);
+    if (len2 & 1)
+      crc1 = GF2MatrixTimes(odd, crc1);
+    len2 >>= 1;
+  } while (len2 != 0);
+
+  return crc1 ^ crc2;
+}
+
+uint32_t FileCRCCache::CalculateCRC32(uint32_t crc,
+                                      llvm::ArrayRef<uint8_t> data) {
+  const size_t num_chunks = std::min<size_t>(
+      GetHardwareConcurrencyHint(), data.size() / g_min_chunk_size);
+  if (num_chunks <= 1)
+    return CRC32Serial(crc, data.data(), data.size());
+
+  const size_t chunk_size = (data.size() + num_chunks - 1) / num_chunks;
+  std::vector<uint32_t> chunk_crcs((data.size() + chunk_size - 1) /
+                                   chunk_size);
+  TaskMapOverInt(0, chunk_crcs.size(), [&](size_t idx) {
+    llvm::ArrayRef<uint8_t> chunk =
+        data.slice(idx * chunk_size).take_front(chunk_size);
+    chunk_crcs[idx] =
+        CRC32Serial(idx == 0 ? crc : 0, chunk.data(), chunk.size());
+  });
+
+  crc = chunk_crcs[0];
+  for (size_t i = 1; i < chunk_crcs.size(); ++i) {
+    const uint64_t offset = i * chunk_size;
+    crc = CRC32Combine(crc, chunk_crcs[i],
+                       std::min<uint64_t>(chunk_size, data.size() - offset));
+  }
+  return crc;
+}
+
+namespace {
+struct OpenCaches {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<FileCRCCache>> caches;
+};
+} // namespace
+
+FileCRCCache &FileCRCCache::Get(const FileSpec &cache_dir) {
+  static OpenCaches *g_open_caches = new OpenCaches();
+  std::lock_guard<std::mutex> guard(g_open_caches->mutex);
+  std::unique_ptr<FileCRCCache> &cache =
+      g_open_caches->caches[cache_dir.GetPath()];
+  if (!cache)
+    cache.reset(new FileCRCCache(cache_dir));
+  return *cache;
+}
+
+static FileSpec GetCacheFileSpec(const FileSpec &cache_dir) {
+  if (!cache_dir)
+    return FileSpec();
+  FileSpec file_spec = cache_dir;
+  file_spec.AppendPathComponent(g_file_name);
+  return file_spec;
+}
+
+FileCRCCache::FileCRCCache(const FileSpec &cache_dir)
+    : m_cache_dir(cache_dir), m_file_spec(GetCacheFileSpec(cache_dir)) {}
+
+double FileCRCCache::GetSecondsSaved() {
+  return g_microseconds_saved / 1000000.0;
+}
+
+uint32_t FileCRCCache::GetCRC32(const FileSpec &file, uint64_t offset,
+                                llvm::ArrayRef<uint8_t> contents) {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_OBJECT));
+
+  llvm::sys::fs::file_status status;
+  const std::string path = file.GetPath();
+  if (!file || llvm::sys::fs::status(path, status))
+    return CalculateCRC32(0, contents);
+
+  const llvm::sys::fs::UniqueID id = status.getUniqueID();
+  Key key{path,
+          offset,
+          contents.size(),
+          status.getSize(),
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              status.getLastModificationTime().time_since_epoch())
+              .count(),
+          id.getDevice(),
+          id.getFile()};
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_loaded) {
+      m_loaded = true;
+      Load();
+    }
+    auto pos = m_entries.find(key);
+    if (pos != m_entries.end()) {
+      ++g_cache_hits;
+      g_microseconds_saved += uint64_t(pos->second.seconds * 1000000);
+      LLDB_LOG(log, "found crc32 {0:x8} of {1} in the cache, saving {2}s",
+               pos->second.crc, path, pos->second.seconds);
+      return pos->second.crc;
+    }
+  }
+
+  ++g_cache_misses;
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "Calculating crc32 of %s with size %" PRIu64
+                               " KiB",
+                     file.GetFilename().AsCString(""),
+                     uint64_t(contents.size() / 1024));
+  const auto start = std::chrono::steady_clock::now();
+  const uint32_t crc = CalculateCRC32(0, contents);
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries[key] = {crc, elapsed.count()};
+  if (m_file_spec) {
+    Status error = Save();
+    if (error.Fail())
+      LLDB_LOG(log, "couldn't save crc32 cache: {0}", error);
+  }
+  return crc;
+}
+
+void FileCRCCache::Load() {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_OBJECT));
+  if (!m_file_spec)
+    return;
+
+  const std::string path = m_file_spec.GetPath();
+  auto buffer_or_error = llvm::MemoryBuffer::getFile(path);
+  if (!buffer_or_error)
+    return;
+
+  llvm::StringRef contents = (*buffer_or_error)->getBuffer();
+  llvm::StringRef line;
+  std::tie(line, contents) = contents.split('\n');
+  if (line != g_magic) {
+    LLDB_LOG(log, "ignoring crc32 cache {0}: unknown format", path);
+    return;
+  }
+
+  while (!contents.empty()) {
+    std::tie(line, contents) = contents.split('\n');
+    // crc offset length file-size mtime device inode seconds path
+    llvm::StringRef fields[8];
+    for (llvm::StringRef &field : fields)
+      std::tie(field, line) = line.split(' ');
+    Key key;
+    Entry entry;
+    key.path = line;
+    if (fields[0].getAsInteger(16, entry.crc) ||
+        fields[1].getAsInteger(10, key.offset) ||
+        fields[2].getAsInteger(10, key.length) ||
+        fields[3].getAsInteger(10, key.file_size) ||
+        fields[4].getAsInteger(10, key.mtime) ||
+        fields[5].getAsInteger(10, key.device) ||
+        fields[6].getAsInteger(10, key.inode) ||
+        fields[7].getAsDouble(entry.seconds) || key.path.empty()) {
+      LLDB_LOG(log, "ignoring malformed entry in crc32 cache {0}", path);
+      continue;
+    }
+    // Entries computed in this session are more recent.
+    m_entries.insert({key, entry});
+  }
+}
+
+Status FileCRCCache::Save() {
+  Status error;
+  const std::string path = m_file_spec.GetPath();
+  if (std::error_code ec =
+          llvm::sys::fs::create_directories(m_cache_dir.GetPath())) {
+    error.SetErrorStringWithFormat("couldn't create %s: %s",
+                                   m_cache_dir.GetPath().c_str(),
+                                   ec.message().c_str());
+    return error;
+  }
+
+  // Pick up what other debuggers added since this one loaded the cache.
+  Load();
+
+  if (m_entries.size() > g_max_entries) {
+    for (auto pos = m_entries.begin(); pos != m_entries.end();) {
+      llvm::sys::fs::file_status status;
+      if (llvm::sys::fs::status(pos->first.path, status) ||
+          status.getSize() != pos->first.file_size)
+        pos = m_entries.erase(pos);
+      else
+        ++pos;
+    }
+    while (m_entries.size() > g_max_entries)
+      m_entries.erase(m_entries.begin());
+  }
+
+  // Write a temporary file and rename it over the cache so that concurrent
+  // debuggers never read a partially written cache.
+  int fd;
+  llvm::SmallString<128> temp_path;
+  if (std::error_code ec =
+          llvm::sys::fs::createUniqueFile(path + "-%%%%%%", fd, temp_path)) {
+    error.SetErrorStringWithFormat("couldn't create a temporary file for %s: "
+                                   "%s",
+                                   path.c_str(), ec.message().c_str());
+    return error;
+  }
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << g_magic << '\n';
+    for (const auto &entry : m_entries) {
+      const Key &key = entry.first;
+      os << llvm::format_hex_no_prefix(entry.second.crc, 8) << ' '
+         << key.offset << ' ' << key.length << ' ' << key.file_size << ' '
+         << key.mtime << ' ' << key.device << ' ' << key.inode << ' '
+         << llvm::format("%f", entry.second.seconds) << ' ' << key.path
+         << '\n';
+    }
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      error.SetErrorStringWithFormat("couldn't write %s", path.c_str());
+      return error;
+    }
+  }
+
+  if (std::error_code ec = llvm::sys::fs::rename(temp_path, path)) {
+    llvm::sys::fs::remove(temp_path);
+    error.SetErrorStringWithFormat("couldn't write %s: %s", path.c_str(),
+                                   ec.message().c_str());
+  }
+  return error;
+}
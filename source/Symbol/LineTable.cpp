@@ -163,6 +163,10 @@ operator()(const LineTable::Entry &a, const LineTable::Entry &b) const {
 
 uint32_t LineTable::GetSize() const { return m_entries.size(); }
 
+size_t LineTable::GetMemoryUsage() const {
+  return m_entries.capacity() * sizeof(Entry);
+}
+
 bool LineTable::GetLineEntryAtIndex(uint32_t idx, LineEntry &line_entry) {
   if (idx < m_entries.size()) {
     ConvertEntryAtIndexToLineEntry(idx, line_entry);
@@ -13,6 +13,7 @@
 #include "lldb/Symbol/SwiftASTContext.h"
 
 // C++ Includes
+#include <atomic>
 #include <mutex> // std::once
 #include <queue>
 #include <set>
@@ -40,6 +41,7 @@
 #include "swift/Basic/Platform.h"
 #include "swift/Basic/PrimarySpecificPaths.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Basic/Version.h"
 #include "swift/ClangImporter/ClangImporter.h"
 #include "swift/ClangImporter/ClangImporterOptions.h"
 #include "swift/Demangling/Demangle.h"
@@ -103,6 +105,7 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SourceModule.h"
+#include "lldb/Symbol/SwiftPersistentTypeCache.h"
 #include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Symbol/VariableList.h"
@@ -901,6 +904,13 @@ SwiftASTContext::SwiftASTContext(const SwiftASTContext &rhs)
 }
 
 SwiftASTContext::~SwiftASTContext() {
+  if (m_persistent_type_cache) {
+    Status error = m_persistent_type_cache->Save();
+    if (error.Fail())
+      LOG_PRINTF(LIBLLDB_LOG_TYPES, "couldn't save the swift type cache: %s",
+                 error.AsCString());
+  }
+
   if (swift::ASTContext *ctx = m_ast_context_ap.get()) {
     // A RemoteASTContext associated with this swift::ASTContext has
     // to be destroyed before the swift::ASTContext is destroyed.
@@ -1473,6 +1483,38 @@ bool HasSwiftModules(Module &module) {
   return !ast_file_datas.empty();
 }
 
+/// Per-module contexts are independent swift::ASTContexts, so they can be
+/// built concurrently. They all share one pool so that neither repeated
+/// module loads nor scratch context creation spin up threads of their own.
+static llvm::ThreadPool *g_context_pool = nullptr;
+static llvm::once_flag g_context_pool_once;
+/// Set while LLDB terminates; queued context creations are skipped.
+static std::atomic<bool> g_terminating(false);
+
+static llvm::ThreadPool &GetContextThreadPool() {
+  llvm::call_once(g_context_pool_once,
+                  [] { g_context_pool = new llvm::ThreadPool(); });
+  return *g_context_pool;
+}
+
+static std::shared_future<void> CreateModuleContextAsync(ModuleSP module_sp) {
+  return GetContextThreadPool().async([module_sp] {
+    if (g_terminating)
+      return;
+    // Creating the context imports (and possibly rebuilds) all the Clang
+    // modules the Swift module depends on, which can take seconds.
+    if (HasSwiftModules(*module_sp))
+      module_sp->GetTypeSystemForLanguage(lldb::eLanguageTypeSwift);
+  });
+}
+
+void SwiftASTContext::CreateModuleContextsInBackground(
+    const ModuleList &module_list) {
+  for (size_t mi = 0, me = module_list.GetSize(); mi != me; ++mi)
+    if (ModuleSP module_sp = module_list.GetModuleAtIndex(mi))
+      CreateModuleContextAsync(module_sp);
+}
+
 namespace {
 
 /// Calls arg.consume_front(<options>) and returns true on success.
@@ -1635,6 +1677,28 @@ static llvm::Optional<StringRef> GetDSYMBundle(Module &module) {
   return dsym;
 }
 
+/// Describe everything besides the module itself that decides whether
+/// imports and type reconstruction succeed, so that the persistent type cache
+/// isn't shared between configurations that can give different answers.
+static std::string GetPersistentTypeCacheContext(SwiftASTContext &swift_ast) {
+  std::string context;
+  llvm::raw_string_ostream os(context);
+  os << swift::version::getSwiftFullVersion() << '\n';
+  if (swift::ASTContext *ast = swift_ast.GetASTContext()) {
+    const swift::SearchPathOptions &opts = ast->SearchPathOpts;
+    os << "target " << ast->LangOpts.Target.getTriple() << '\n';
+    os << "sdk " << opts.SDKPath << '\n';
+    os << "resources " << opts.RuntimeResourcePath << '\n';
+    for (const std::string &path : opts.ImportSearchPaths)
+      os << "import " << path << '\n';
+    for (const auto &path : opts.FrameworkSearchPaths)
+      os << "framework " << path.Path << '\n';
+  }
+  for (const std::string &arg : swift_ast.GetClangImporterOptions().ExtraArgs)
+    os << "clang " << arg << '\n';
+  return os.str();
+}
+
 lldb::TypeSystemSP SwiftASTContext::CreateInstance(lldb::LanguageType language,
                                                    Module &module,
                                                    Target *target,
@@ -1828,6 +1892,16 @@ lldb::TypeSystemSP SwiftASTContext::CreateInstance(lldb::LanguageType language,
     return {};
   }
 
+  // Expression contexts see modules that are loaded later, so what failed
+  // for them in an earlier session may well succeed now.
+  if (!fallback) {
+    auto &props = ModuleList::GetGlobalModuleListProperties();
+    swift_ast_sp->m_persistent_type_cache = SwiftPersistentTypeCache::Open(
+        props.GetSwiftTypeCachePath(), module.GetUUID(),
+        GetPersistentTypeCacheContext(*swift_ast_sp),
+        props.GetSwiftTypeCacheMaxSize());
+  }
+
   std::vector<std::string> module_names;
   swift_ast_sp->RegisterSectionModules(module, module_names);
   swift_ast_sp->ValidateSectionModules(module, module_names);
@@ -1892,20 +1966,22 @@ lldb::TypeSystemSP SwiftASTContext::CreateInstance(lldb::LanguageType language,
     handled_sdk_path = true;
   }
 
-  if (target.GetSwiftCreateModuleContextsInParallel()) {
+  // With swift-create-module-contexts-in-background the module contexts
+  // are already being built; the loops below wait for each of them as they
+  // get to it.
+  if (target.GetSwiftCreateModuleContextsInParallel() &&
+      !target.GetSwiftCreateModuleContextsInBackground()) {
     // The first call to GetTypeSystemForLanguage() on a module will
     // trigger the import (and thus most likely the rebuild) of all
     // the Clang modules that were imported in this module. This can
     // be a lot of work (potentially ten seconds per module), but it
     // can be performed in parallel.
-    llvm::ThreadPool pool;
-    for (size_t mi = 0; mi != num_images; ++mi) {
-      auto module_sp = target.GetImages().GetModuleAtIndex(mi);
-      pool.async([=] {
-        module_sp->GetTypeSystemForLanguage(lldb::eLanguageTypeSwift);
-      });
-    }
-    pool.wait();
+    std::vector<std::shared_future<void>> contexts;
+    for (size_t mi = 0; mi != num_images; ++mi)
+      contexts.push_back(
+          CreateModuleContextAsync(target.GetImages().GetModuleAtIndex(mi)));
+    for (auto &context : contexts)
+      context.wait();
   }
 
   Status module_error;
@@ -2222,12 +2298,17 @@ static lldb::TypeSystemSP CreateTypeSystemInstance(lldb::LanguageType language,
 }
 
 void SwiftASTContext::Initialize() {
+  g_terminating = false;
   PluginManager::RegisterPlugin(
       GetPluginNameStatic(), "swift AST context plug-in",
       CreateTypeSystemInstance, EnumerateSupportedLanguages);
 }
 
 void SwiftASTContext::Terminate() {
+  g_terminating = true;
+  if (g_context_pool)
+    g_context_pool->wait();
+  SwiftPersistentTypeCache::SaveAll();
   PluginManager::UnregisterPlugin(CreateTypeSystemInstance);
 }
 
@@ -3579,6 +3660,21 @@ void SwiftASTContext::CacheModule(swift::ModuleDecl *module) {
   m_swift_module_cache.insert({ID, module});
 }
 
+/// Return the import search path in which the module \a module_name is found
+/// at \a module_path, or an empty string if that isn't a serialized Swift
+/// module.
+static std::string GetSearchPathForModuleFile(llvm::StringRef module_name,
+                                              llvm::StringRef module_path) {
+  const std::string file_name = (module_name + ".swiftmodule").str();
+  llvm::StringRef dir = llvm::sys::path::parent_path(module_path);
+  // Either "<dir>/Name.swiftmodule" or "<dir>/Name.swiftmodule/<arch>.*".
+  if (llvm::sys::path::filename(module_path) == file_name)
+    return dir.str();
+  if (llvm::sys::path::filename(dir) == file_name)
+    return llvm::sys::path::parent_path(dir).str();
+  return std::string();
+}
+
 swift::ModuleDecl *SwiftASTContext::GetModule(const SourceModule &module,
                                               Status &error) {
   VALID_OR_RETURN(nullptr);
@@ -3619,8 +3715,40 @@ swift::ModuleDecl *SwiftASTContext::GetModule(const SourceModule &module,
     return nullptr;
   }
 
+  if (m_persistent_type_cache &&
+      m_persistent_type_cache->IsKnownImportFailure(module_basename_sref)) {
+    LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\") -- failed in an earlier session",
+               module.path.front().GetCString());
+    error.SetErrorStringWithFormat(
+        "failed to get module \"%s\" from AST context (cached failure, "
+        "see symbols.swift-type-cache-path)",
+        module.path.front().GetCString());
+    return nullptr;
+  }
+
+  // A module that was imported in an earlier session is looked for where it
+  // was found then first, instead of in every search path before that one.
+  // The cache is dropped when any of the modules it found has changed.
+  std::vector<std::string> &search_paths =
+      ast->SearchPathOpts.ImportSearchPaths;
+  std::string cached_search_path;
+  if (m_persistent_type_cache)
+    cached_search_path = GetSearchPathForModuleFile(
+        module_basename_sref,
+        m_persistent_type_cache->GetImportPath(module_basename_sref));
+  const bool prepend_search_path =
+      !cached_search_path.empty() &&
+      (search_paths.empty() || search_paths.front() != cached_search_path);
+  if (prepend_search_path) {
+    LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\") -- searching %s first",
+               module.path.front().GetCString(), cached_search_path.c_str());
+    search_paths.insert(search_paths.begin(), cached_search_path);
+  }
+
   ClearDiagnostics();
   swift::ModuleDecl *module_decl = ast->getModuleByName(module_basename_sref);
+  if (prepend_search_path)
+    search_paths.erase(search_paths.begin());
   if (HasErrors()) {
     DiagnosticManager diagnostic_manager;
     PrintDiagnostics(diagnostic_manager);
@@ -3631,6 +3759,8 @@ swift::ModuleDecl *SwiftASTContext::GetModule(const SourceModule &module,
 
     LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\") -- %s",
                module.path.front().GetCString(), diagnostic.c_str());
+    if (m_persistent_type_cache && !HasFatalErrors())
+      m_persistent_type_cache->RecordImport(module_basename_sref, {});
     return nullptr;
   }
 
@@ -3641,12 +3771,22 @@ swift::ModuleDecl *SwiftASTContext::GetModule(const SourceModule &module,
     error.SetErrorStringWithFormat(
         "failed to get module \"%s\" from AST context",
         module.path.front().GetCString());
+    if (m_persistent_type_cache)
+      m_persistent_type_cache->RecordImport(module_basename_sref, {});
     return nullptr;
   }
   LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\") -- found %s",
              module.path.front().GetCString(),
              module_decl->getName().str().str().c_str());
 
+  // Remember where the module came from; the persistent cache is stale
+  // once that file changes.
+  if (m_persistent_type_cache) {
+    llvm::StringRef filename = module_decl->getModuleFilename();
+    if (!filename.empty())
+      m_persistent_type_cache->RecordImport(module_basename_sref, filename);
+  }
+
   m_swift_module_cache[module.path.front().GetStringRef()] = module_decl;
   return module_decl;
 }
@@ -4308,6 +4448,18 @@ SwiftASTContext::GetTypeFromMangledTypename(ConstString mangled_typename,
     return {};
   }
 
+  if (m_persistent_type_cache &&
+      m_persistent_type_cache->IsKnownTypeFailure(
+          mangled_typename.GetStringRef())) {
+    LOG_PRINTF(LIBLLDB_LOG_TYPES,
+               "(\"%s\") -- found in the persistent negative cache",
+               mangled_cstr);
+    error.SetErrorStringWithFormat("type for typename \"%s\" was not found",
+                                   mangled_cstr);
+    CacheDemangledTypeFailure(mangled_typename);
+    return {};
+  }
+
   LOG_PRINTF(LIBLLDB_LOG_TYPES, "(\"%s\") -- not cached, searching",
              mangled_cstr);
 
@@ -4330,6 +4482,8 @@ SwiftASTContext::GetTypeFromMangledTypename(ConstString mangled_typename,
   error.SetErrorStringWithFormat("type for typename \"%s\" was not found",
                                  mangled_cstr);
   CacheDemangledTypeFailure(mangled_typename);
+  if (m_persistent_type_cache && !HasFatalErrors())
+    m_persistent_type_cache->RecordTypeFailure(mangled_typename.GetStringRef());
   return {};
 }
 
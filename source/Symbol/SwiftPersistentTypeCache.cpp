@@ -0,0 +1,369 @@
+//===-- SwiftPersistentTypeCache.cpp ----------------------------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/SwiftPersistentTypeCache.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace lldb_private;
+
+// Bump this whenever the file format changes.
+static const char g_magic[] = "lldb-swift-type-cache 2";
+static const char g_extension[] = ".swifttypes";
+
+std::atomic<uint64_t> SwiftPersistentTypeCache::g_cache_hits(0);
+std::atomic<uint64_t> SwiftPersistentTypeCache::g_cache_misses(0);
+
+namespace {
+struct OpenCaches {
+  std::mutex mutex;
+  std::set<SwiftPersistentTypeCache *> caches;
+};
+} // namespace
+
+static OpenCaches &GetOpenCaches() {
+  static OpenCaches *g_open_caches = new OpenCaches();
+  return *g_open_caches;
+}
+
+std::unique_ptr<SwiftPersistentTypeCache>
+SwiftPersistentTypeCache::Open(const FileSpec &cache_dir, const UUID &uuid,
+                               llvm::StringRef context, uint64_t max_size,
+                               std::chrono::seconds failure_lifetime) {
+  if (!cache_dir || !uuid.IsValid() || max_size == 0)
+    return nullptr;
+
+  // The context is long and contains spaces and paths; only its hash goes
+  // into the file name.
+  llvm::MD5 md5;
+  md5.update(context);
+  llvm::MD5::MD5Result digest;
+  md5.final(digest);
+  llvm::SmallString<32> context_hash;
+  llvm::MD5::stringifyResult(digest, context_hash);
+
+  FileSpec file_spec = cache_dir;
+  file_spec.AppendPathComponent(uuid.GetAsString("") + "-" +
+                                context_hash.str().substr(0, 16).str() +
+                                g_extension);
+
+  std::unique_ptr<SwiftPersistentTypeCache> cache(new SwiftPersistentTypeCache(
+      cache_dir, file_spec, max_size, failure_lifetime));
+  if (!cache->Load()) {
+    // Start over; the next save replaces the stale file.
+    cache.reset(new SwiftPersistentTypeCache(cache_dir, file_spec, max_size,
+                                             failure_lifetime));
+    cache->m_dirty = true;
+  }
+  if (cache->m_size == 0)
+    cache->m_size = sizeof(g_magic);
+
+  OpenCaches &open_caches = GetOpenCaches();
+  std::lock_guard<std::mutex> guard(open_caches.mutex);
+  open_caches.caches.insert(cache.get());
+  return cache;
+}
+
+SwiftPersistentTypeCache::~SwiftPersistentTypeCache() {
+  OpenCaches &open_caches = GetOpenCaches();
+  std::lock_guard<std::mutex> guard(open_caches.mutex);
+  open_caches.caches.erase(this);
+}
+
+void SwiftPersistentTypeCache::SaveAll() {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES));
+  OpenCaches &open_caches = GetOpenCaches();
+  std::lock_guard<std::mutex> guard(open_caches.mutex);
+  for (SwiftPersistentTypeCache *cache : open_caches.caches) {
+    Status error = cache->Save();
+    if (error.Fail())
+      LLDB_LOG(log, "couldn't save swift type cache: {0}", error);
+  }
+}
+
+bool SwiftPersistentTypeCache::Load() {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES));
+  const std::string path = m_file_spec.GetPath();
+
+  auto buffer_or_error = llvm::MemoryBuffer::getFile(path);
+  if (!buffer_or_error) {
+    // Nothing cached yet. That's not stale, but there is nothing to write
+    // back either.
+    return true;
+  }
+
+  llvm::StringRef contents = (*buffer_or_error)->getBuffer();
+  llvm::StringRef line;
+  std::tie(line, contents) = contents.split('\n');
+  if (line != g_magic) {
+    LLDB_LOG(log, "ignoring swift type cache {0}: unknown format", path);
+    return false;
+  }
+  m_size = sizeof(g_magic);
+
+  while (!contents.empty()) {
+    std::tie(line, contents) = contents.split('\n');
+    m_size += line.size() + 1;
+    llvm::StringRef kind, rest;
+    std::tie(kind, rest) = line.split(' ');
+    if (kind == "type-failure" || kind == "import-failure") {
+      if (!LoadFailure(kind == "type-failure" ? m_type_failures
+                                              : m_import_failures,
+                       rest, line.size() + 1)) {
+        LLDB_LOG(log, "ignoring swift type cache {0}: malformed entry", path);
+        return false;
+      }
+    } else if (kind == "import") {
+      llvm::StringRef mtime_str, name, module_path;
+      std::tie(mtime_str, rest) = rest.split(' ');
+      std::tie(name, module_path) = rest.split(' ');
+      int64_t mtime;
+      if (mtime_str.getAsInteger(10, mtime) || name.empty() ||
+          module_path.empty()) {
+        LLDB_LOG(log, "ignoring swift type cache {0}: malformed entry", path);
+        return false;
+      }
+      // A module that changed can make earlier failures succeed.
+      llvm::sys::fs::file_status status;
+      if (llvm::sys::fs::status(module_path, status) ||
+          llvm::sys::toTimeT(status.getLastModificationTime()) != mtime) {
+        LLDB_LOG(log, "ignoring swift type cache {0}: {1} changed", path,
+                 module_path);
+        return false;
+      }
+      m_imports[name] = module_path;
+    } else if (!kind.empty()) {
+      LLDB_LOG(log, "ignoring swift type cache {0}: malformed entry", path);
+      return false;
+    }
+  }
+
+  LLDB_LOG(log,
+           "loaded swift type cache {0}: {1} type failures, {2} import "
+           "failures, {3} imports",
+           path, m_type_failures.size(), m_import_failures.size(),
+           m_imports.size());
+  return true;
+}
+
+static int64_t GetCurrentTime() {
+  return llvm::sys::toTimeT(std::chrono::system_clock::now());
+}
+
+bool SwiftPersistentTypeCache::LoadFailure(FailureMap &failures,
+                                           llvm::StringRef entry,
+                                           size_t line_size) {
+  llvm::StringRef time_str, key;
+  std::tie(time_str, key) = entry.split(' ');
+  int64_t time;
+  if (time_str.getAsInteger(10, time) || key.empty())
+    return false;
+
+  // Whatever caused an old failure may have been fixed since, in ways the
+  // cache can't see. Drop the entry; the next save leaves it out.
+  if (GetCurrentTime() - time >= m_failure_lifetime.count()) {
+    m_size -= line_size;
+    m_dirty = true;
+    return true;
+  }
+  failures[key] = time;
+  return true;
+}
+
+bool SwiftPersistentTypeCache::Lookup(const FailureMap &failures,
+                                      llvm::StringRef key) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (failures.count(key)) {
+    ++g_cache_hits;
+    return true;
+  }
+  ++g_cache_misses;
+  return false;
+}
+
+bool SwiftPersistentTypeCache::IsKnownTypeFailure(
+    llvm::StringRef mangled_name) {
+  return Lookup(m_type_failures, mangled_name);
+}
+
+bool SwiftPersistentTypeCache::IsKnownImportFailure(llvm::StringRef name) {
+  return Lookup(m_import_failures, name);
+}
+
+bool SwiftPersistentTypeCache::CanGrow(size_t entry_size) {
+  if (m_size + entry_size > m_max_size)
+    return false;
+  m_size += entry_size;
+  m_dirty = true;
+  return true;
+}
+
+void SwiftPersistentTypeCache::RecordFailure(FailureMap &failures,
+                                             llvm::StringRef kind,
+                                             llvm::StringRef key) {
+  if (key.empty() || failures.count(key))
+    return;
+  const int64_t time = GetCurrentTime();
+  if (CanGrow(kind.size() + std::to_string(time).size() + key.size() + 3))
+    failures[key] = time;
+}
+
+void SwiftPersistentTypeCache::RecordTypeFailure(
+    llvm::StringRef mangled_name) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  RecordFailure(m_type_failures, "type-failure", mangled_name);
+}
+
+void SwiftPersistentTypeCache::RecordImport(llvm::StringRef name,
+                                            llvm::StringRef path) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (name.empty() || name.contains(' '))
+    return;
+  if (path.empty()) {
+    RecordFailure(m_import_failures, "import-failure", name);
+    return;
+  }
+  auto pos = m_imports.find(name);
+  if (pos != m_imports.end() && pos->second == path)
+    return;
+  // Leave room for the modification time.
+  if (CanGrow(name.size() + path.size() + sizeof("import  ") + 20))
+    m_imports[name] = path;
+}
+
+std::string SwiftPersistentTypeCache::GetImportPath(llvm::StringRef name) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto pos = m_imports.find(name);
+  if (pos == m_imports.end()) {
+    ++g_cache_misses;
+    return std::string();
+  }
+  ++g_cache_hits;
+  return pos->second;
+}
+
+Status SwiftPersistentTypeCache::Save() {
+  Status error;
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (!m_dirty)
+    return error;
+
+  const std::string path = m_file_spec.GetPath();
+  if (std::error_code ec = llvm::sys::fs::create_directories(
+          m_cache_dir.GetPath())) {
+    error.SetErrorStringWithFormat("couldn't create %s: %s",
+                                   m_cache_dir.GetPath().c_str(),
+                                   ec.message().c_str());
+    return error;
+  }
+
+  // Write a temporary file and rename it over the cache so that concurrent
+  // debuggers never read a partially written cache.
+  int fd;
+  llvm::SmallString<128> temp_path;
+  if (std::error_code ec =
+          llvm::sys::fs::createUniqueFile(path + "-%%%%%%", fd, temp_path)) {
+    error.SetErrorStringWithFormat("couldn't create a temporary file for %s: "
+                                   "%s",
+                                   path.c_str(), ec.message().c_str());
+    return error;
+  }
+
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os << g_magic << '\n';
+    for (const auto &entry : m_imports) {
+      // Skip modules that have gone away since they were imported; the
+      // next session would discard the whole cache because of them.
+      llvm::sys::fs::file_status status;
+      if (llvm::sys::fs::status(entry.second, status))
+        continue;
+      os << "import "
+         << llvm::sys::toTimeT(status.getLastModificationTime()) << ' '
+         << entry.first() << ' ' << entry.second << '\n';
+    }
+    for (const auto &entry : m_import_failures)
+      os << "import-failure " << entry.second << ' ' << entry.first() << '\n';
+    for (const auto &entry : m_type_failures)
+      os << "type-failure " << entry.second << ' ' << entry.first() << '\n';
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      llvm::sys::fs::remove(temp_path);
+      error.SetErrorStringWithFormat("couldn't write %s", path.c_str());
+      return error;
+    }
+  }
+
+  if (std::error_code ec = llvm::sys::fs::rename(temp_path, path)) {
+    llvm::sys::fs::remove(temp_path);
+    error.SetErrorStringWithFormat("couldn't write %s: %s", path.c_str(),
+                                   ec.message().c_str());
+    return error;
+  }
+  m_dirty = false;
+
+  Prune(m_cache_dir, m_max_size);
+  return error;
+}
+
+void SwiftPersistentTypeCache::Prune(const FileSpec &cache_dir,
+                                     uint64_t max_size) {
+  struct CacheFile {
+    llvm::sys::TimePoint<> mtime;
+    uint64_t size;
+    std::string path;
+  };
+  std::vector<CacheFile> files;
+  uint64_t total_size = 0;
+
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(cache_dir.GetPath(), ec), end;
+       it != end && !ec; it.increment(ec)) {
+    if (llvm::sys::path::extension(it->path()) != g_extension)
+      continue;
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(it->path(), status))
+      continue;
+    files.push_back(
+        {status.getLastModificationTime(), status.getSize(), it->path()});
+    total_size += status.getSize();
+  }
+
+  if (total_size <= max_size)
+    return;
+
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile &lhs, const CacheFile &rhs) {
+              return lhs.mtime < rhs.mtime;
+            });
+  for (const CacheFile &file : files) {
+    if (total_size <= max_size)
+      break;
+    if (!llvm::sys::fs::remove(file.path))
+      total_size -= file.size;
+  }
+}
@@ -432,6 +432,18 @@ CompUnitSP SymbolVendor::GetCompileUnitAtIndex(size_t idx) {
   return cu_sp;
 }
 
+size_t SymbolVendor::GetLineTableMemoryUsage() {
+  size_t usage = 0;
+  ModuleSP module_sp(GetModule());
+  if (module_sp) {
+    std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
+    for (const CompUnitSP &cu_sp : m_compile_units)
+      if (cu_sp)
+        usage += cu_sp->GetLineTableMemoryUsage();
+  }
+  return usage;
+}
+
 FileSpec SymbolVendor::GetMainFileSpec() const {
   if (m_sym_file_up) {
     const ObjectFile *symfile_objfile = m_sym_file_up->GetObjectFile();
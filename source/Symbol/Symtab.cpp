@@ -12,6 +12,7 @@
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/STLUtils.h"
 #include "lldb/Core/Section.h"
@@ -67,6 +68,20 @@ size_t Symtab::GetNumSymbols() const {
   return m_symbols.size();
 }
 
+size_t Symtab::GetMemoryUsage() const {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  typedef UniqueCStringMap<uint32_t>::Entry NameEntry;
+  return m_symbols.capacity() * sizeof(Symbol) +
+         m_file_addr_to_index.GetSize() * sizeof(FileRangeToIndexMap::Entry) +
+         (m_name_to_index.GetSize() + m_basename_to_index.GetSize() +
+          m_method_to_index.GetSize() + m_selector_to_index.GetSize()) *
+             sizeof(NameEntry) +
+         m_name_to_index.GetFilterMemoryUsage() +
+         m_basename_to_index.GetFilterMemoryUsage() +
+         m_method_to_index.GetFilterMemoryUsage() +
+         m_selector_to_index.GetFilterMemoryUsage();
+}
+
 void Symtab::SectionFileAddressesChanged() {
   m_name_to_index.Clear();
   m_file_addr_to_index_computed = false;
@@ -394,6 +409,13 @@ void Symtab::InitNameIndexes() {
     m_basename_to_index.SizeToFit();
     m_method_to_index.Sort();
     m_method_to_index.SizeToFit();
+
+    if (ModuleList::GetGlobalModuleListProperties().GetUseNameLookupFilters()) {
+      m_name_to_index.BuildFilter();
+      m_selector_to_index.BuildFilter();
+      m_basename_to_index.BuildFilter();
+      m_method_to_index.BuildFilter();
+    }
   }
 }
 
@@ -14,6 +14,7 @@
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/State.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 
@@ -35,6 +36,7 @@ MemoryCache::~MemoryCache() {}
 
 void MemoryCache::Clear(bool clear_invalid_ranges) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  ++m_flush_id;
   m_L1_cache.clear();
   m_L2_cache.clear();
   if (clear_invalid_ranges)
@@ -59,6 +61,7 @@ void MemoryCache::Flush(addr_t addr, size_t size) {
     return;
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  ++m_flush_id;
 
   // Erase any blocks from the L1 cache that intersect with the flush range
   if (!m_L1_cache.empty()) {
@@ -249,6 +252,65 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   return dst_len - bytes_left;
 }
 
+void MemoryCache::Prefetch(llvm::ArrayRef<addr_t> addrs) {
+  std::vector<addr_t> lines;
+  uint32_t cache_line_byte_size;
+  uint32_t flush_id;
+  {
+    std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    cache_line_byte_size = m_L2_cache_line_byte_size;
+    flush_id = m_flush_id;
+    for (addr_t addr : addrs) {
+      const addr_t line_addr = addr - (addr % cache_line_byte_size);
+      if (!m_L2_cache.count(line_addr) &&
+          !m_invalid_ranges.FindEntryThatContains(line_addr))
+        lines.push_back(line_addr);
+    }
+  }
+  std::sort(lines.begin(), lines.end());
+  lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+
+  // Every read is a round trip to the inferior, which costs far more than
+  // the bytes themselves, so lines in the same page are read together along
+  // with whatever is between them. Pages are at least 4 KiB everywhere we
+  // run, so what lies between them is mapped too.
+  const addr_t page_byte_size = 4096;
+  const size_t max_lines_per_read = 16;
+  for (size_t begin = 0, end; begin < lines.size(); begin = end) {
+    for (end = begin + 1; end < lines.size(); ++end) {
+      if ((lines[end] - lines[begin]) / cache_line_byte_size >=
+          max_lines_per_read)
+        break;
+      if (lines[end] / page_byte_size != lines[end - 1] / page_byte_size &&
+          lines[end] != lines[end - 1] + cache_line_byte_size)
+        break;
+    }
+
+    const addr_t read_addr = lines[begin];
+    const size_t read_size = lines[end - 1] + cache_line_byte_size - read_addr;
+    DataBufferHeap buffer(read_size, 0);
+    Status error;
+    const size_t bytes_read = m_process.ReadMemoryFromInferior(
+        read_addr, buffer.GetBytes(), read_size, error);
+
+    std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    if (flush_id != m_flush_id ||
+        cache_line_byte_size != m_L2_cache_line_byte_size)
+      return;
+    for (size_t idx = begin; idx < end; ++idx) {
+      const size_t offset = lines[idx] - read_addr;
+      if (offset >= bytes_read)
+        break;
+      // Like Read, keep a partially read line; readers stop at its end.
+      const size_t line_bytes =
+          std::min<size_t>(cache_line_byte_size, bytes_read - offset);
+      m_L2_cache.emplace(lines[idx], std::make_shared<DataBufferHeap>(
+                                         buffer.GetBytes() + offset,
+                                         line_bytes));
+    }
+  }
+}
+
 AllocatedBlock::AllocatedBlock(lldb::addr_t addr, uint32_t byte_size,
                                uint32_t permissions, uint32_t chunk_size)
     : m_range(addr, byte_size), m_permissions(permissions),
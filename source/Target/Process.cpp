@@ -2329,6 +2329,11 @@ size_t Process::ReadMemory(addr_t addr, void *buf, size_t size, Status &error) {
   }
 }
 
+void Process::PrefetchMemory(llvm::ArrayRef<addr_t> addrs) {
+  if (!GetDisableMemoryCache())
+    m_memory_cache.Prefetch(addrs);
+}
+
 size_t Process::ReadCStringFromMemory(addr_t addr, std::string &out_str,
                                       Status &error) {
   char buf[256];
@@ -6042,6 +6047,16 @@ void Process::ModulesDidLoad(ModuleList &module_list) {
   }
 }
 
+void Process::ModulesDidUnload(ModuleList &module_list) {
+  std::lock_guard<std::recursive_mutex> guard(m_language_runtimes_mutex);
+  LanguageRuntimeCollection language_runtimes(m_language_runtimes);
+  for (const auto &pair : language_runtimes) {
+    LanguageRuntimeSP language_runtime_sp = pair.second;
+    if (language_runtime_sp)
+      language_runtime_sp->ModulesDidUnload(module_list);
+  }
+}
+
 void Process::PrintWarning(uint64_t warning_type, const void *repeat_key,
                            const char *fmt, ...) {
   bool print_warning = true;
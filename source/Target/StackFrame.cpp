@@ -1170,6 +1170,54 @@ StackFrame::GetValueObjectForFrameVariable(const VariableSP &variable_sp,
   return valobj_sp;
 }
 
+void StackFrame::MaterializeValueObjects(llvm::ArrayRef<ValueObjectSP> valobjs,
+                                         DynamicValueType use_dynamic) {
+  if (valobjs.size() < 2 || IsHistorical())
+    return;
+  TargetSP target_sp = CalculateTarget();
+  ProcessSP process_sp = CalculateProcess();
+  if (!target_sp || !process_sp ||
+      !target_sp->GetPrefetchVariableMemory())
+    return;
+
+  // Everything below is a snapshot of the stopped process, don't let it run
+  // until we are done.
+  Process::StopLocker stop_locker;
+  if (!stop_locker.TryLock(&process_sp->GetRunLock()))
+    return;
+
+  // Reading the static values goes through this frame's register context,
+  // which is not safe to share between threads, so do it up front.
+  for (const ValueObjectSP &valobj_sp : valobjs)
+    if (valobj_sp)
+      valobj_sp->UpdateValueIfNeeded(false);
+
+  // Finding dynamic types and formatting summaries mostly reads what the
+  // variables point to, one variable at a time. Read all of that memory into
+  // the process memory cache first, in as few reads as possible.
+  std::vector<lldb::addr_t> pointees;
+  for (const ValueObjectSP &valobj_sp : valobjs) {
+    if (!valobj_sp || !valobj_sp->IsPointerOrReferenceType())
+      continue;
+    AddressType address_type = eAddressTypeInvalid;
+    lldb::addr_t pointee = valobj_sp->GetPointerValue(&address_type);
+    if (address_type == eAddressTypeLoad && pointee != 0 &&
+        pointee != LLDB_INVALID_ADDRESS)
+      pointees.push_back(pointee);
+  }
+  process_sp->PrefetchMemory(pointees);
+
+  for (const ValueObjectSP &valobj_sp : valobjs) {
+    if (!valobj_sp)
+      continue;
+    ValueObjectSP display_sp = valobj_sp;
+    if (use_dynamic != eNoDynamicValues)
+      if (ValueObjectSP dynamic_sp = valobj_sp->GetDynamicValue(use_dynamic))
+        display_sp = dynamic_sp;
+    display_sp->GetSummaryAsCString();
+  }
+}
+
 ValueObjectSP StackFrame::TrackGlobalVariable(const VariableSP &variable_sp,
                                               DynamicValueType use_dynamic) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
@@ -12,6 +12,7 @@
 
 #include "lldb/Target/SwiftLanguageRuntime.h"
 
+#include <map>
 #include <string.h>
 
 #include "llvm/Support/raw_ostream.h"
@@ -155,6 +156,7 @@ void SwiftLanguageRuntime::SetupReflection() {
 
   reflection_ctx.reset(new NativeReflectionContext(this->GetMemoryReader()));
   reflection_ctx->addImage(swift::remote::RemoteAddress(load_ptr));
+  AddFileImage(*M);
 
   auto module_list = GetTargetRef().GetImages();
   module_list.ForEach([&](const ModuleSP &module_sp) -> bool {
@@ -168,8 +170,10 @@ void SwiftLanguageRuntime::SetupReflection() {
         start_address.GetLoadAddress(&(m_process->GetTarget())));
     if (load_ptr == 0 || load_ptr == LLDB_INVALID_ADDRESS)
       return false;
-    if (HasReflectionInfo(obj_file))
+    if (HasReflectionInfo(obj_file)) {
       reflection_ctx->addImage(swift::remote::RemoteAddress(load_ptr));
+      AddFileImage(*module_sp);
+    }
     return true;
   });
 }
@@ -257,6 +261,12 @@ void SwiftLanguageRuntime::SetupABIBit() {
 }
 
 void SwiftLanguageRuntime::ModulesDidLoad(const ModuleList &module_list) {
+  {
+    // A newly loaded image can replace classes that were resolved before,
+    // e.g. when a library is reloaded at the same address.
+    std::lock_guard<std::mutex> guard(m_class_metadata_cache_mutex);
+    m_class_metadata_cache.clear();
+  }
   module_list.ForEach([&](const ModuleSP &module_sp) -> bool {
   auto *obj_file = module_sp->GetObjectFile();
     if (!obj_file)
@@ -268,8 +278,10 @@ void SwiftLanguageRuntime::ModulesDidLoad(const ModuleList &module_list) {
       return false;
     if (!reflection_ctx)
       return false;
-    if (HasReflectionInfo(obj_file))
+    if (HasReflectionInfo(obj_file)) {
       reflection_ctx->addImage(swift::remote::RemoteAddress(load_ptr));
+      AddFileImage(*module_sp);
+    }
     return true;
   });
 }
@@ -1047,6 +1059,10 @@ public:
                   " bytes at address 0x%" PRIx64,
                   size, address.getAddressData());
 
+    if (readFromFileImage(address.getAddressData(), dest, size))
+      return true;
+    ++m_memory_reads;
+
     if (size > m_max_read_amount) {
       if (log)
         log->Printf(
@@ -1092,6 +1108,20 @@ public:
           "[MemoryReader] asked to read string data at address 0x%" PRIx64,
           address.getAddressData());
 
+    {
+      std::lock_guard<std::mutex> guard(m_file_images_mutex);
+      if (const FileImageRange *range =
+              findFileImage(address.getAddressData(), 1)) {
+        lldb::offset_t offset = address.getAddressData() - range->start;
+        if (const char *str = range->data.GetCStr(&offset)) {
+          ++m_file_image_reads;
+          dest.assign(str);
+          return true;
+        }
+      }
+    }
+    ++m_memory_reads;
+
     uint32_t read_size = 50 * 1024;
     std::vector<char> storage(read_size, 0);
     Target &target(m_process->GetTarget());
@@ -1124,12 +1154,102 @@ public:
     m_local_buffer_size = 0;
   }
 
+  /// Serve reads of the read-only, non-code sections of \p module from
+  /// the module's file instead of from the process. Type descriptors,
+  /// field records and the strings they point to all live there.
+  void addFileImage(Module &module) {
+    ObjectFile *obj_file = module.GetObjectFile();
+    // An in-memory image would be read from the process anyway.
+    if (!obj_file || obj_file->IsInMemory())
+      return;
+    SectionList *sections = obj_file->GetSectionList();
+    if (!sections)
+      return;
+    std::lock_guard<std::mutex> guard(m_file_images_mutex);
+    addFileImageSections(module, *obj_file, *sections);
+  }
+
+  void removeFileImages(const ModuleList &module_list) {
+    std::lock_guard<std::mutex> guard(m_file_images_mutex);
+    for (auto it = m_file_images.begin(); it != m_file_images.end();) {
+      if (module_list.FindModule(it->second.module))
+        it = m_file_images.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  uint64_t getFileImageReads() const { return m_file_image_reads; }
+  uint64_t getMemoryReads() const { return m_memory_reads; }
+
 private:
+  struct FileImageRange {
+    lldb::addr_t start;
+    DataExtractor data;
+    const Module *module;
+  };
+
+  void addFileImageSections(Module &module, ObjectFile &obj_file,
+                            const SectionList &sections) {
+    Target &target(m_process->GetTarget());
+    for (size_t i = 0, e = sections.GetNumSections(0); i != e; ++i) {
+      SectionSP section_sp = sections.GetSectionAtIndex(i);
+      if (!section_sp)
+        continue;
+      if (section_sp->GetChildren().GetNumSections(0)) {
+        addFileImageSections(module, obj_file, section_sp->GetChildren());
+        continue;
+      }
+      const uint32_t permissions = section_sp->GetPermissions();
+      if (!(permissions & ePermissionsReadable) ||
+          (permissions & ePermissionsWritable) ||
+          section_sp->GetType() == eSectionTypeCode ||
+          section_sp->IsEncrypted() || section_sp->IsThreadSpecific() ||
+          !section_sp->GetFileSize())
+        continue;
+      lldb::addr_t load_addr = section_sp->GetLoadBaseAddress(&target);
+      if (load_addr == LLDB_INVALID_ADDRESS)
+        continue;
+      FileImageRange range;
+      range.start = load_addr;
+      range.module = &module;
+      if (!obj_file.ReadSectionData(section_sp.get(), range.data))
+        continue;
+      m_file_images[load_addr + range.data.GetByteSize()] = std::move(range);
+    }
+  }
+
+  /// Find the file image range that contains all of [addr, addr + size).
+  /// The caller must hold m_file_images_mutex.
+  const FileImageRange *findFileImage(lldb::addr_t addr, uint64_t size) {
+    // The map is keyed by the end address of each range.
+    auto it = m_file_images.upper_bound(addr);
+    if (it == m_file_images.end() || addr < it->second.start ||
+        addr + size > it->first)
+      return nullptr;
+    return &it->second;
+  }
+
+  bool readFromFileImage(lldb::addr_t addr, uint8_t *dest, uint64_t size) {
+    std::lock_guard<std::mutex> guard(m_file_images_mutex);
+    const FileImageRange *range = findFileImage(addr, size);
+    if (!range)
+      return false;
+    range->data.CopyData(addr - range->start, size, dest);
+    ++m_file_image_reads;
+    return true;
+  }
+
   Process *m_process;
   size_t m_max_read_amount;
 
   uint64_t m_local_buffer = 0;
   uint64_t m_local_buffer_size = 0;
+
+  std::mutex m_file_images_mutex;
+  std::map<lldb::addr_t, FileImageRange> m_file_images;
+  std::atomic<uint64_t> m_file_image_reads{0};
+  std::atomic<uint64_t> m_memory_reads{0};
 };
 
 std::shared_ptr<swift::remote::MemoryReader>
@@ -1140,6 +1260,30 @@ SwiftLanguageRuntime::GetMemoryReader() {
   return m_memory_reader_sp;
 }
 
+void SwiftLanguageRuntime::AddFileImage(Module &module) {
+  static_cast<LLDBMemoryReader *>(GetMemoryReader().get())
+      ->addFileImage(module);
+}
+
+SwiftLanguageRuntime::MetadataCacheStatistics
+SwiftLanguageRuntime::GetMetadataCacheStatistics() {
+  auto *reader = static_cast<LLDBMemoryReader *>(GetMemoryReader().get());
+  MetadataCacheStatistics stats;
+  stats.cache_hits = m_class_metadata_cache_hits;
+  stats.cache_misses = m_class_metadata_cache_misses;
+  stats.file_image_reads = reader->getFileImageReads();
+  stats.memory_reads = reader->getMemoryReads();
+  return stats;
+}
+
+void SwiftLanguageRuntime::ModulesDidUnload(const ModuleList &module_list) {
+  static_cast<LLDBMemoryReader *>(GetMemoryReader().get())
+      ->removeFileImages(module_list);
+  // Unloading an image frees its metadata, and the addresses may be reused.
+  std::lock_guard<std::mutex> guard(m_class_metadata_cache_mutex);
+  m_class_metadata_cache.clear();
+}
+
 void SwiftLanguageRuntime::PushLocalBuffer(uint64_t local_buffer,
                                            uint64_t local_buffer_size) {
   ((LLDBMemoryReader *)GetMemoryReader().get())->pushLocalBuffer(
@@ -1238,6 +1382,14 @@ SwiftLanguageRuntime::GetRemoteASTContext(SwiftASTContext &swift_ast_ctx) {
 void SwiftLanguageRuntime::ReleaseAssociatedRemoteASTContext(
     swift::ASTContext *ctx) {
   m_remote_ast_contexts.erase(ctx);
+
+  // Types cached for ctx die with it.
+  std::lock_guard<std::mutex> guard(m_class_metadata_cache_mutex);
+  for (auto it = m_class_metadata_cache.begin(),
+            end = m_class_metadata_cache.end();
+       it != end; ++it)
+    if (it->first.first == ctx)
+      m_class_metadata_cache.erase(it);
 }
 
 namespace {
@@ -1501,6 +1653,22 @@ bool SwiftLanguageRuntime::GetDynamicTypeAndAddress_Class(
     return false;
   }
 
+  // Many objects share a class, so remember what each metadata address
+  // resolved to instead of walking the metadata with RemoteAST every time.
+  auto key = std::make_pair(scratch_ctx.GetASTContext(),
+                            metadata_address.getValue().getAddressData());
+  {
+    std::lock_guard<std::mutex> guard(m_class_metadata_cache_mutex);
+    auto it = m_class_metadata_cache.find(key);
+    if (it != m_class_metadata_cache.end()) {
+      ++m_class_metadata_cache_hits;
+      // The read lock must have been acquired by the caller.
+      class_type_or_name.SetCompilerType({&scratch_ctx, it->second});
+      return true;
+    }
+  }
+  ++m_class_metadata_cache_misses;
+
   auto instance_type =
       remote_ast.getTypeForRemoteTypeMetadata(metadata_address.getValue(),
                                               /*skipArtificial=*/true);
@@ -1513,6 +1681,11 @@ bool SwiftLanguageRuntime::GetDynamicTypeAndAddress_Class(
     return false;
   }
 
+  {
+    std::lock_guard<std::mutex> guard(m_class_metadata_cache_mutex);
+    m_class_metadata_cache[key] = instance_type.getValue().getPointer();
+  }
+
   // The read lock must have been acquired by the caller.
   class_type_or_name.SetCompilerType(
       {&scratch_ctx, instance_type.getValue().getPointer()});
@@ -1432,6 +1432,7 @@ void Target::ClearModules(bool delete_locations) {
   ModulesDidUnload(m_images, delete_locations);
   m_section_load_history.Clear();
   m_images.Clear();
+  m_expression_cache.Clear();
   m_scratch_type_system_map.Clear();
   m_ast_importer_sp.reset();
 }
@@ -1665,6 +1666,13 @@ void Target::NotifyModulesRemoved(lldb_private::ModuleList &module_list) {
 void Target::ModulesDidLoad(ModuleList &module_list) {
   const size_t num_images = module_list.GetSize();
   if (m_valid && num_images) {
+    // Cached expressions and name lookups may have bound names that the new
+    // modules now provide a better match for.
+    m_expression_cache.Clear();
+    if (m_ast_importer_sp)
+      m_ast_importer_sp->ClearLookupCache();
+    if (GetSwiftCreateModuleContextsInBackground())
+      SwiftASTContext::CreateModuleContextsInBackground(module_list);
     for (size_t idx = 0; idx < num_images; ++idx) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
@@ -1701,6 +1709,9 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
 
 void Target::SymbolsDidLoad(ModuleList &module_list) {
   if (m_valid && module_list.GetSize()) {
+    m_expression_cache.Clear();
+    if (m_ast_importer_sp)
+      m_ast_importer_sp->ClearLookupCache();
     if (m_process_sp) {
       for (LanguageRuntime *runtime : m_process_sp->GetLanguageRuntimes()) {
         runtime->SymbolsDidLoad(module_list);
@@ -1716,10 +1727,17 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
+    // Cached expressions and name lookups may refer to code, data, blocks
+    // and types of these modules.
+    m_expression_cache.Clear();
+    if (m_ast_importer_sp)
+      m_ast_importer_sp->ClearLookupCache();
     UnloadModuleSections(module_list);
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, false,
                                                  delete_locations);
+    if (m_process_sp)
+      m_process_sp->ModulesDidUnload(module_list);
     BroadcastEvent(eBroadcastBitModulesUnloaded,
                    new TargetEventData(this->shared_from_this(), module_list));
   }
@@ -3692,8 +3710,19 @@ static constexpr PropertyDefinition g_properties[] = {
      {}, "Print the fixed expression text."},
     {"save-jit-objects", OptionValue::eTypeBoolean, false, false, nullptr,
      {}, "Save intermediate object files generated by the LLVM JIT"},
+    {"expression-cache-size", OptionValue::eTypeUInt64, false, 0, nullptr,
+     {},
+     "The number of compiled expressions to keep so that evaluating the same "
+     "expression again in the same lexical block skips parsing and JITing "
+     "it. Swift expressions and expressions that refer to persistent ($) "
+     "variables are never cached. 0 disables the cache."},
     {"max-children-count", OptionValue::eTypeSInt64, false, 256, nullptr,
      {}, "Maximum number of children to expand in any level of depth."},
+    {"max-synthetic-node-cache", OptionValue::eTypeSInt64, false, 65536,
+     nullptr, {},
+     "Maximum number of node addresses that synthetic child providers for "
+     "node-based containers (std::map, std::list) remember per container so "
+     "that children can be fetched without re-walking the container."},
     {"max-string-summary-length", OptionValue::eTypeSInt64, false, 1024,
      nullptr, {},
      "Maximum number of characters to show when using %s in summary strings."},
@@ -3833,7 +3862,9 @@ enum {
   ePropertyAutoApplyFixIts,
   ePropertyNotifyAboutFixIts,
   ePropertySaveObjects,
+  ePropertyExpressionCacheSize,
   ePropertyMaxChildrenCount,
+  ePropertyMaxSyntheticNodeCache,
   ePropertyMaxSummaryLength,
   ePropertyMaxMemReadSize,
   ePropertyBreakpointUseAvoidList,
@@ -3951,12 +3982,30 @@ static constexpr PropertyDefinition g_experimental_properties[]{
      {}, "If true, use Clang's modern type lookup infrastructure."},
     {"swift-create-module-contexts-in-parallel", OptionValue::eTypeBoolean,
      false, true, nullptr, {},
-     "Create the per-module Swift AST contexts in parallel."}};
+     "Create the per-module Swift AST contexts in parallel."},
+    {"swift-create-module-contexts-in-background", OptionValue::eTypeBoolean,
+     false, false, nullptr, {},
+     "Start creating the per-module Swift AST contexts on background threads "
+     "as soon as the modules are loaded, rather than when the first Swift "
+     "expression or variable needs them."},
+    {"prefetch-variable-memory", OptionValue::eTypeBoolean, false, false,
+     nullptr, {},
+     "If true, read the memory that a frame's variables point to in as few "
+     "reads as possible before computing their dynamic types and "
+     "summaries."},
+    {"lazy-clang-type-import", OptionValue::eTypeBoolean, false, false,
+     nullptr, {},
+     "If true, C and C++ types found by name while parsing an expression are "
+     "imported as forward declarations and only completed if the expression "
+     "needs their definition."}};
 
 enum {
   ePropertyInjectLocalVars = 0,
   ePropertyUseModernTypeLookup,
   ePropertySwiftCreateModuleContextsInParallel,
+  ePropertySwiftCreateModuleContextsInBackground,
+  ePropertyPrefetchVariableMemory,
+  ePropertyLazyClangTypeImport,
 };
 
 class TargetExperimentalOptionValueProperties : public OptionValueProperties {
@@ -4092,6 +4141,42 @@ bool TargetProperties::GetSwiftCreateModuleContextsInParallel() const {
     return true;
 }
 
+bool TargetProperties::GetSwiftCreateModuleContextsInBackground() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertySwiftCreateModuleContextsInBackground, false);
+  else
+    return false;
+}
+
+bool TargetProperties::GetPrefetchVariableMemory() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyPrefetchVariableMemory, false);
+  else
+    return false;
+}
+
+bool TargetProperties::GetLazyClangTypeImport() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyLazyClangTypeImport, false);
+  else
+    return false;
+}
+
 ArchSpec TargetProperties::GetDefaultArchitecture() const {
   OptionValueArch *value = m_collection_sp->GetPropertyAtIndexAsOptionValueArch(
       nullptr, ePropertyDefaultArch);
@@ -4338,6 +4423,12 @@ bool TargetProperties::GetEnableSaveObjects() const {
       nullptr, idx, g_properties[idx].default_uint_value != 0);
 }
 
+uint32_t TargetProperties::GetExpressionCacheSize() const {
+  const uint32_t idx = ePropertyExpressionCacheSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
 bool TargetProperties::GetEnableSyntheticValue() const {
   const uint32_t idx = ePropertyEnableSynthetic;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -4350,6 +4441,12 @@ uint32_t TargetProperties::GetMaximumNumberOfChildrenToDisplay() const {
       nullptr, idx, g_properties[idx].default_uint_value);
 }
 
+uint32_t TargetProperties::GetMaximumSyntheticNodeCacheSize() const {
+  const uint32_t idx = ePropertyMaxSyntheticNodeCache;
+  return m_collection_sp->GetPropertyAtIndexAsSInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
 uint32_t TargetProperties::GetMaximumSizeOfStringSummary() const {
   const uint32_t idx = ePropertyMaxSummaryLength;
   return m_collection_sp->GetPropertyAtIndexAsSInt64(
@@ -0,0 +1,344 @@
+//===-- AgentExpression.cpp -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+
+using namespace lldb_private;
+
+// gdbserver limits the stack to a few dozen entries; conditions never get
+// anywhere near either limit.
+static const size_t g_max_stack_size = 64;
+static const size_t g_max_steps = 10000;
+
+void AgentExpression::EmitBigEndian(uint64_t value, size_t byte_size) {
+  for (size_t i = byte_size; i > 0; --i)
+    m_bytes.push_back(uint8_t(value >> ((i - 1) * 8)));
+}
+
+void AgentExpression::EmitConstant(uint64_t value) {
+  if (llvm::isUInt<8>(value)) {
+    Emit(eOpConst8);
+    EmitBigEndian(value, 1);
+  } else if (llvm::isUInt<16>(value)) {
+    Emit(eOpConst16);
+    EmitBigEndian(value, 2);
+  } else if (llvm::isUInt<32>(value)) {
+    Emit(eOpConst32);
+    EmitBigEndian(value, 4);
+  } else {
+    Emit(eOpConst64);
+    EmitBigEndian(value, 8);
+  }
+}
+
+void AgentExpression::EmitRegister(uint16_t regnum) {
+  Emit(eOpReg);
+  EmitBigEndian(regnum, 2);
+}
+
+bool AgentExpression::EmitLoad(size_t byte_size) {
+  switch (byte_size) {
+  case 1:
+    Emit(eOpRef8);
+    return true;
+  case 2:
+    Emit(eOpRef16);
+    return true;
+  case 4:
+    Emit(eOpRef32);
+    return true;
+  case 8:
+    Emit(eOpRef64);
+    return true;
+  }
+  return false;
+}
+
+void AgentExpression::EmitExtend(unsigned bits, bool is_signed) {
+  if (bits >= 64)
+    return;
+  Emit(is_signed ? eOpExt : eOpZeroExt);
+  m_bytes.push_back(bits);
+}
+
+size_t AgentExpression::EmitJump(Opcode op) {
+  Emit(op);
+  const size_t offset = m_bytes.size();
+  EmitBigEndian(0, 2);
+  return offset;
+}
+
+void AgentExpression::PatchJump(size_t jump_offset, size_t target) {
+  m_bytes[jump_offset] = uint8_t(target >> 8);
+  m_bytes[jump_offset + 1] = uint8_t(target);
+}
+
+static llvm::Error MakeError(const char *message, size_t pc) {
+  return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                 "agent expression: %s at offset %zu", message,
+                                 pc);
+}
+
+llvm::Expected<uint64_t>
+AgentExpression::Evaluate(ReadRegisterCallback read_register,
+                          ReadMemoryCallback read_memory) const {
+  std::vector<uint64_t> stack;
+  size_t pc = 0;
+
+  for (size_t steps = 0; steps < g_max_steps; ++steps) {
+    if (pc >= m_bytes.size())
+      return MakeError("ran off the end", pc);
+
+    const size_t op_pc = pc;
+    const uint8_t op = m_bytes[pc++];
+
+    // Read a big endian immediate following the opcode.
+    auto immediate = [&](size_t byte_size, uint64_t &value) {
+      if (pc + byte_size > m_bytes.size())
+        return false;
+      value = 0;
+      for (size_t i = 0; i < byte_size; ++i)
+        value = (value << 8) | m_bytes[pc++];
+      return true;
+    };
+
+    // How many operands the opcode pops.
+    size_t pops = 0;
+    switch (op) {
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpDivSigned:
+    case eOpDivUnsigned:
+    case eOpRemSigned:
+    case eOpRemUnsigned:
+    case eOpLsh:
+    case eOpRshSigned:
+    case eOpRshUnsigned:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned:
+    case eOpSwap:
+      pops = 2;
+      break;
+    case eOpRot:
+      pops = 3;
+      break;
+    case eOpLogNot:
+    case eOpBitNot:
+    case eOpExt:
+    case eOpZeroExt:
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64:
+    case eOpIfGoto:
+    case eOpDup:
+    case eOpPop:
+    case eOpEnd:
+      pops = 1;
+      break;
+    }
+    if (stack.size() < pops)
+      return MakeError("stack underflow", op_pc);
+    if (stack.size() >= g_max_stack_size)
+      return MakeError("stack overflow", op_pc);
+
+    switch (op) {
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpDivSigned:
+    case eOpDivUnsigned:
+    case eOpRemSigned:
+    case eOpRemUnsigned:
+    case eOpLsh:
+    case eOpRshSigned:
+    case eOpRshUnsigned:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned: {
+      const uint64_t b = stack.back();
+      stack.pop_back();
+      const uint64_t a = stack.back();
+      uint64_t &result = stack.back();
+      switch (op) {
+      case eOpAdd:
+        result = a + b;
+        break;
+      case eOpSub:
+        result = a - b;
+        break;
+      case eOpMul:
+        result = a * b;
+        break;
+      case eOpDivSigned:
+      case eOpRemSigned:
+        if (b == 0)
+          return MakeError("division by zero", op_pc);
+        // INT64_MIN / -1 overflows; the result wraps like it does in the
+        // inferior.
+        if (int64_t(b) == -1)
+          result = op == eOpDivSigned ? 0 - a : 0;
+        else if (op == eOpDivSigned)
+          result = int64_t(a) / int64_t(b);
+        else
+          result = int64_t(a) % int64_t(b);
+        break;
+      case eOpDivUnsigned:
+      case eOpRemUnsigned:
+        if (b == 0)
+          return MakeError("division by zero", op_pc);
+        result = op == eOpDivUnsigned ? a / b : a % b;
+        break;
+      case eOpLsh:
+        result = b < 64 ? a << b : 0;
+        break;
+      case eOpRshSigned:
+        result = int64_t(a) >> std::min<uint64_t>(b, 63);
+        break;
+      case eOpRshUnsigned:
+        result = b < 64 ? a >> b : 0;
+        break;
+      case eOpBitAnd:
+        result = a & b;
+        break;
+      case eOpBitOr:
+        result = a | b;
+        break;
+      case eOpBitXor:
+        result = a ^ b;
+        break;
+      case eOpEqual:
+        result = a == b;
+        break;
+      case eOpLessSigned:
+        result = int64_t(a) < int64_t(b);
+        break;
+      case eOpLessUnsigned:
+        result = a < b;
+        break;
+      }
+    } break;
+
+    case eOpLogNot:
+      stack.back() = !stack.back();
+      break;
+
+    case eOpBitNot:
+      stack.back() = ~stack.back();
+      break;
+
+    case eOpExt:
+    case eOpZeroExt: {
+      uint64_t bits;
+      if (!immediate(1, bits))
+        return MakeError("truncated opcode", op_pc);
+      if (bits == 0)
+        return MakeError("invalid extension width", op_pc);
+      if (bits >= 64)
+        break;
+      if (op == eOpExt)
+        stack.back() = llvm::SignExtend64(stack.back(), unsigned(bits));
+      else
+        stack.back() &= llvm::maskTrailingOnes<uint64_t>(unsigned(bits));
+    } break;
+
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64: {
+      const size_t size = size_t(1) << (op - eOpRef8);
+      llvm::Optional<uint64_t> value = read_memory(stack.back(), size);
+      if (!value)
+        return MakeError("couldn't read memory", op_pc);
+      stack.back() = *value;
+    } break;
+
+    case eOpIfGoto:
+    case eOpGoto: {
+      uint64_t target;
+      if (!immediate(2, target))
+        return MakeError("truncated opcode", op_pc);
+      bool taken = true;
+      if (op == eOpIfGoto) {
+        taken = stack.back() != 0;
+        stack.pop_back();
+      }
+      if (taken)
+        pc = target;
+    } break;
+
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64: {
+      uint64_t value;
+      if (!immediate(size_t(1) << (op - eOpConst8), value))
+        return MakeError("truncated opcode", op_pc);
+      stack.push_back(value);
+    } break;
+
+    case eOpReg: {
+      uint64_t regnum;
+      if (!immediate(2, regnum))
+        return MakeError("truncated opcode", op_pc);
+      llvm::Optional<uint64_t> value = read_register(uint32_t(regnum));
+      if (!value)
+        return MakeError("couldn't read register", op_pc);
+      stack.push_back(*value);
+    } break;
+
+    case eOpEnd:
+      return stack.back();
+
+    case eOpDup:
+      stack.push_back(stack.back());
+      break;
+
+    case eOpPop:
+      stack.pop_back();
+      break;
+
+    case eOpSwap:
+      std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+      break;
+
+    case eOpPick: {
+      uint64_t index;
+      if (!immediate(1, index))
+        return MakeError("truncated opcode", op_pc);
+      if (index >= stack.size())
+        return MakeError("stack underflow", op_pc);
+      stack.push_back(stack[stack.size() - 1 - index]);
+    } break;
+
+    case eOpRot: {
+      // a b c => c a b
+      const size_t size = stack.size();
+      std::rotate(stack.begin() + size - 3, stack.begin() + size - 1,
+                  stack.end());
+    } break;
+
+    default:
+      return MakeError("unsupported opcode", op_pc);
+    }
+  }
+
+  return MakeError("too many steps", pc);
+}
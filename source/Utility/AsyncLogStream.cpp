@@ -0,0 +1,381 @@
+//===-- AsyncLogStream.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AsyncLogStream.h"
+#include "lldb/Utility/Log.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Signals.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include <errno.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace lldb_private;
+
+// A single producer, single consumer ring of length prefixed records. The
+// owning thread is the only producer and the drain (serialized by
+// m_drain_mutex) is the only consumer, so no locks are needed.
+class AsyncLogStream::Ring {
+public:
+  Ring(size_t size) : m_buffer(size) {}
+
+  /// Called by the owning thread when it exits; nothing is pushed after.
+  void Orphan() { m_orphaned.store(true, std::memory_order_release); }
+  bool IsOrphaned() const {
+    return m_orphaned.load(std::memory_order_acquire);
+  }
+
+  size_t GetUsed() const {
+    return m_head.load(std::memory_order_relaxed) -
+           m_tail.load(std::memory_order_relaxed);
+  }
+
+  bool Push(uint64_t sequence, const char *data, size_t size) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    const Header header = {sequence, size};
+    if (sizeof(header) + size > m_buffer.size() - (head - tail))
+      return false;
+    CopyIn(head, &header, sizeof(header));
+    CopyIn(head + sizeof(header), data, size);
+    m_head.store(head + sizeof(header) + size, std::memory_order_release);
+    return true;
+  }
+
+  template <typename Callback> void Pop(Callback &&callback) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    while (tail != head) {
+      Header header;
+      CopyOut(tail, &header, sizeof(header));
+      std::string message(header.size, '\0');
+      CopyOut(tail + sizeof(header), &message[0], header.size);
+      tail += sizeof(header) + header.size;
+      callback(header.sequence, std::move(message));
+    }
+    m_tail.store(tail, std::memory_order_release);
+  }
+
+private:
+  struct Header {
+    uint64_t sequence;
+    uint64_t size;
+  };
+
+  void CopyIn(size_t pos, const void *src, size_t len) {
+    const size_t offset = pos % m_buffer.size();
+    const size_t first = std::min(len, m_buffer.size() - offset);
+    ::memcpy(&m_buffer[offset], src, first);
+    ::memcpy(&m_buffer[0], static_cast<const char *>(src) + first,
+             len - first);
+  }
+
+  void CopyOut(size_t pos, void *dst, size_t len) const {
+    const size_t offset = pos % m_buffer.size();
+    const size_t first = std::min(len, m_buffer.size() - offset);
+    ::memcpy(dst, &m_buffer[offset], first);
+    ::memcpy(static_cast<char *>(dst) + first, &m_buffer[0], len - first);
+  }
+
+  std::vector<char> m_buffer;
+  std::atomic<bool> m_orphaned{false};
+  // Monotonically increasing byte positions; only their difference and their
+  // value modulo the buffer size matter.
+  std::atomic<size_t> m_head{0};
+  std::atomic<size_t> m_tail{0};
+};
+
+static std::mutex &GetStreamsMutex() {
+  static std::mutex g_mutex;
+  return g_mutex;
+}
+
+static std::vector<AsyncLogStream *> &GetStreams() {
+  static std::vector<AsyncLogStream *> g_streams;
+  return g_streams;
+}
+
+// The streams whose history is written out on a crash. The crash handler
+// can't take a lock, so they are kept in a fixed number of atomic slots; a
+// stream that finds no free slot is not written out.
+static const size_t g_num_crash_slots = 16;
+static std::atomic<AsyncLogStream *> g_crash_streams[g_num_crash_slots];
+
+AsyncLogStream::AsyncLogStream(std::shared_ptr<llvm::raw_ostream> stream_sp,
+                               size_t history_size, size_t ring_size,
+                               int crash_fd)
+    : llvm::raw_ostream(/*unbuffered=*/true), m_stream_sp(std::move(stream_sp)),
+      m_history_size(history_size), m_ring_size(ring_size),
+      m_crash_fd(crash_fd), m_id([] {
+        static std::atomic<uint64_t> g_next_id{1};
+        return g_next_id++;
+      }()) {
+  if (m_history_size) {
+    m_history.reset(new char[m_history_size]);
+    if (m_crash_fd >= 0) {
+      static std::once_flag g_once_flag;
+      std::call_once(g_once_flag, [] {
+        llvm::sys::AddSignalHandler(DumpHistoriesOnCrash, nullptr);
+      });
+      for (std::atomic<AsyncLogStream *> &slot : g_crash_streams) {
+        AsyncLogStream *expected = nullptr;
+        if (slot.compare_exchange_strong(expected, this))
+          break;
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(GetStreamsMutex());
+    GetStreams().push_back(this);
+  }
+
+  m_thread = std::thread(&AsyncLogStream::WriterThread, this);
+}
+
+AsyncLogStream::~AsyncLogStream() {
+  for (std::atomic<AsyncLogStream *> &slot : g_crash_streams) {
+    AsyncLogStream *expected = this;
+    slot.compare_exchange_strong(expected, nullptr);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(GetStreamsMutex());
+    auto &streams = GetStreams();
+    streams.erase(std::remove(streams.begin(), streams.end(), this),
+                  streams.end());
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_wake_mutex);
+    m_stop = true;
+  }
+  m_wake_cv.notify_one();
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+AsyncLogStream *AsyncLogStream::Find(const llvm::raw_ostream *stream) {
+  std::lock_guard<std::mutex> guard(GetStreamsMutex());
+  for (AsyncLogStream *async_stream : GetStreams())
+    if (async_stream == stream)
+      return async_stream;
+  return nullptr;
+}
+
+AsyncLogStream::Ring *AsyncLogStream::GetRingForCurrentThread() {
+  // The rings this thread writes to, one per stream. Threads almost always
+  // log to a single stream, so this is usually one comparison. When the
+  // thread exits its rings are orphaned, and each stream frees its ring once
+  // it has drained it.
+  // Set once the thread's rings are gone, for messages logged by
+  // thread_local destructors that run after theirs.
+  static thread_local bool t_exited = false;
+  struct ThreadRing {
+    uint64_t stream_id;
+    Ring *ring;
+    std::weak_ptr<Ring> ring_wp;
+  };
+  struct ThreadRings {
+    std::vector<ThreadRing> rings;
+    ~ThreadRings() {
+      t_exited = true;
+      for (ThreadRing &entry : rings)
+        if (std::shared_ptr<Ring> ring_sp = entry.ring_wp.lock())
+          ring_sp->Orphan();
+    }
+  };
+  static thread_local ThreadRings t_rings;
+  if (t_exited)
+    return nullptr;
+
+  for (const ThreadRing &entry : t_rings.rings)
+    if (entry.stream_id == m_id)
+      return entry.ring;
+
+  // Forget the rings of streams that are gone.
+  t_rings.rings.erase(std::remove_if(t_rings.rings.begin(),
+                                     t_rings.rings.end(),
+                                     [](const ThreadRing &entry) {
+                                       return entry.ring_wp.expired();
+                                     }),
+                      t_rings.rings.end());
+
+  auto ring_sp = std::make_shared<Ring>(m_ring_size);
+  {
+    std::lock_guard<std::mutex> guard(m_rings_mutex);
+    m_rings.push_back(ring_sp);
+  }
+  t_rings.rings.push_back({m_id, ring_sp.get(), ring_sp});
+  return ring_sp.get();
+}
+
+void AsyncLogStream::write_impl(const char *ptr, size_t size) {
+  m_bytes_written.fetch_add(size, std::memory_order_relaxed);
+  const uint64_t sequence =
+      m_sequence.fetch_add(1, std::memory_order_relaxed);
+  Ring *ring = GetRingForCurrentThread();
+  if (!ring || !ring->Push(sequence, ptr, size)) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    m_wake_cv.notify_one();
+    return;
+  }
+  // Don't wait for the next periodic drain once the ring is filling up.
+  if (ring->GetUsed() > m_ring_size / 2)
+    m_wake_cv.notify_one();
+}
+
+uint64_t AsyncLogStream::current_pos() const {
+  return m_bytes_written.load(std::memory_order_relaxed);
+}
+
+void AsyncLogStream::WriterThread() {
+  std::unique_lock<std::mutex> lock(m_wake_mutex);
+  while (!m_stop) {
+    m_wake_cv.wait_for(lock, std::chrono::milliseconds(50));
+    lock.unlock();
+    Drain();
+    lock.lock();
+  }
+  lock.unlock();
+  Drain();
+}
+
+void AsyncLogStream::Drain() {
+  std::lock_guard<std::mutex> guard(m_drain_mutex);
+
+  std::vector<std::pair<uint64_t, std::string>> messages;
+  {
+    std::lock_guard<std::mutex> rings_guard(m_rings_mutex);
+    for (auto pos = m_rings.begin(); pos != m_rings.end();) {
+      // Check before popping: an orphaned ring gets no more messages, so
+      // once it is popped it can go.
+      const bool orphaned = (*pos)->IsOrphaned();
+      (*pos)->Pop([&messages](uint64_t sequence, std::string &&message) {
+        messages.emplace_back(sequence, std::move(message));
+      });
+      pos = orphaned ? m_rings.erase(pos) : std::next(pos);
+    }
+  }
+
+  const uint64_t dropped = GetDroppedCount();
+  if (messages.empty() && dropped == m_dropped_reported)
+    return;
+
+  // Each ring is in order already; interleave them by sequence number.
+  std::stable_sort(messages.begin(), messages.end(), llvm::less_first());
+
+  // The underlying stream can be shared with other channels, thread safe or
+  // asynchronous, so write to it under the same lock they do.
+  std::unique_lock<std::recursive_mutex> output_lock(Log::GetOutputMutex(),
+                                                     std::defer_lock);
+  if (!m_history_size)
+    output_lock.lock();
+
+  if (dropped != m_dropped_reported) {
+    Emit(llvm::formatv("{0} log messages dropped\n",
+                       dropped - m_dropped_reported)
+             .str());
+    m_dropped_reported = dropped;
+  }
+
+  for (const auto &message : messages)
+    Emit(message.second);
+
+  if (!m_history_size)
+    m_stream_sp->flush();
+}
+
+void AsyncLogStream::Emit(llvm::StringRef message) {
+  if (!m_history_size) {
+    *m_stream_sp << message;
+    return;
+  }
+
+  // Only the last m_history_size bytes can be kept anyway.
+  message = message.take_back(m_history_size);
+  const size_t end = m_history_end.load(std::memory_order_relaxed);
+  const size_t offset = end % m_history_size;
+  const size_t first = std::min(message.size(), m_history_size - offset);
+  ::memcpy(&m_history[offset], message.data(), first);
+  ::memcpy(&m_history[0], message.data() + first, message.size() - first);
+  m_history_end.store(end + message.size(), std::memory_order_release);
+}
+
+template <typename Callback>
+void AsyncLogStream::ForEachHistoryPiece(Callback &&callback) {
+  const size_t end = m_history_end.load(std::memory_order_acquire);
+  size_t begin = m_history_begin.load(std::memory_order_relaxed);
+  if (end - begin > m_history_size) {
+    // The oldest message was partly overwritten; start after it.
+    begin = end - m_history_size;
+    for (size_t pos = begin; pos != end; ++pos) {
+      if (m_history[pos % m_history_size] == '\n') {
+        begin = pos + 1;
+        break;
+      }
+    }
+  }
+  const size_t offset = begin % m_history_size;
+  const size_t size = end - begin;
+  const size_t first = std::min(size, m_history_size - offset);
+  if (first)
+    callback(&m_history[offset], first);
+  if (size - first)
+    callback(&m_history[0], size - first);
+}
+
+void AsyncLogStream::DumpHistory() {
+  Drain();
+  if (!m_history_size)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_drain_mutex);
+  std::lock_guard<std::recursive_mutex> output_guard(Log::GetOutputMutex());
+  ForEachHistoryPiece([this](const char *data, size_t size) {
+    m_stream_sp->write(data, size);
+  });
+  m_history_begin.store(m_history_end.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+  m_stream_sp->flush();
+}
+
+void AsyncLogStream::DumpHistoriesOnCrash(void *) {
+  // This runs in a signal handler, so it takes no locks and allocates
+  // nothing: the histories are written to their file descriptors as they
+  // are. A message being added while LLDB crashed may come out garbled.
+  for (std::atomic<AsyncLogStream *> &slot : g_crash_streams) {
+    AsyncLogStream *stream = slot.load();
+    if (!stream)
+      continue;
+    const int fd = stream->m_crash_fd;
+    stream->ForEachHistoryPiece([fd](const char *data, size_t size) {
+      while (size) {
+        const auto written = ::write(fd, data, size);
+        if (written < 0) {
+          if (errno == EINTR)
+            continue;
+          return;
+        }
+        data += written;
+        size -= written;
+      }
+    });
+  }
+}
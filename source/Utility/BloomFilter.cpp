@@ -0,0 +1,65 @@
+//===-- BloomFilter.cpp -----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/BloomFilter.h"
+
+#include "llvm/ADT/Hashing.h"
+
+using namespace lldb_private;
+
+// With this many bits per name and bits set per name, less than 1% of the
+// names that weren't inserted are reported as maybe there.
+static const size_t g_bits_per_name = 12;
+static const unsigned g_bits_per_entry = 6;
+static const size_t g_bits_per_block = 512;
+
+std::atomic<uint64_t> BloomFilter::g_lookups_avoided(0);
+std::atomic<uint64_t> BloomFilter::g_false_positives(0);
+
+static uint64_t Hash(ConstString name) {
+  return llvm::hash_value(static_cast<const void *>(name.GetCString()));
+}
+
+void BloomFilter::Reset(size_t num_names) {
+  m_blocks.clear();
+  if (num_names == 0)
+    return;
+  const size_t num_blocks =
+      (num_names * g_bits_per_name + g_bits_per_block - 1) / g_bits_per_block;
+  m_blocks.assign(num_blocks, Block());
+  m_blocks.shrink_to_fit();
+}
+
+size_t BloomFilter::GetBlockIndex(uint64_t hash) const {
+  // Pick the block from a remix of the hash, so that it doesn't depend on
+  // the bits that pick the bits inside the block.
+  const uint64_t block_hash = (hash * 0x9e3779b97f4a7c15ULL) >> 32;
+  return (block_hash * m_blocks.size()) >> 32;
+}
+
+void BloomFilter::Insert(ConstString name) {
+  if (m_blocks.empty())
+    return;
+  const uint64_t hash = Hash(name);
+  Block &block = m_blocks[GetBlockIndex(hash)];
+  uint64_t bits = hash;
+  for (unsigned i = 0; i < g_bits_per_entry; ++i, bits >>= 9)
+    block.words[(bits >> 6) & 7] |= 1ULL << (bits & 63);
+}
+
+bool BloomFilter::MayContain(ConstString name) const {
+  if (m_blocks.empty())
+    return true;
+  const uint64_t hash = Hash(name);
+  const Block &block = m_blocks[GetBlockIndex(hash)];
+  uint64_t bits = hash;
+  for (unsigned i = 0; i < g_bits_per_entry; ++i, bits >>= 9)
+    if (!(block.words[(bits >> 6) & 7] & (1ULL << (bits & 63))))
+      return false;
+  return true;
+}
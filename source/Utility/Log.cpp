@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/AsyncLogStream.h"
 #include "lldb/Utility/VASPrintf.h"
 
 #include "llvm/ADT/STLExtras.h"
@@ -242,6 +243,30 @@ bool Log::ListChannelCategories(llvm::StringRef channel,
   return true;
 }
 
+bool Log::DumpLogChannel(llvm::StringRef channel,
+                         llvm::raw_ostream &error_stream) {
+  auto iter = g_channel_map->find(channel);
+  if (iter == g_channel_map->end()) {
+    error_stream << llvm::formatv("Invalid log channel '{0}'.\n", channel);
+    return false;
+  }
+  auto stream_sp = iter->second.GetStream();
+  AsyncLogStream *async_stream = AsyncLogStream::Find(stream_sp.get());
+  if (!async_stream) {
+    error_stream << llvm::formatv(
+        "Log channel '{0}' is not enabled with --async or --buffer.\n",
+        channel);
+    return false;
+  }
+  async_stream->DumpHistory();
+  return true;
+}
+
+std::recursive_mutex &Log::GetOutputMutex() {
+  static std::recursive_mutex g_LogThreadedMutex;
+  return g_LogThreadedMutex;
+}
+
 void Log::DisableAllLogChannels() {
   for (auto &entry : *g_channel_map)
     entry.second.Disable(UINT32_MAX);
@@ -311,9 +336,12 @@ void Log::WriteMessage(const std::string &message) {
     return;
 
   Flags options = GetOptions();
-  if (options.Test(LLDB_LOG_OPTION_THREADSAFE)) {
-    static std::recursive_mutex g_LogThreadedMutex;
-    std::lock_guard<std::recursive_mutex> guard(g_LogThreadedMutex);
+  if (options.Test(LLDB_LOG_OPTION_ASYNC)) {
+    // The stream is an AsyncLogStream, which queues the message without
+    // locking and writes it out on its own thread.
+    *stream_sp << message;
+  } else if (options.Test(LLDB_LOG_OPTION_THREADSAFE)) {
+    std::lock_guard<std::recursive_mutex> guard(GetOutputMutex());
     *stream_sp << message;
     stream_sp->flush();
   } else {
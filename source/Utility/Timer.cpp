@@ -7,10 +7,20 @@
 //===----------------------------------------------------------------------===//
 #include "lldb/Utility/Timer.h"
 #include "lldb/Utility/Stream.h"
+#include "lldb/Utility/VASPrintf.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -29,6 +39,7 @@ static std::atomic<Timer::Category *> g_categories;
 
 std::atomic<bool> Timer::g_quiet(true);
 std::atomic<unsigned> Timer::g_display_depth(0);
+std::atomic<bool> Timer::g_trace(false);
 static std::mutex &GetFileMutex() {
   static std::mutex *g_file_mutex_ptr = new std::mutex();
   return *g_file_mutex_ptr;
@@ -39,6 +50,50 @@ static TimerStack &GetTimerStackForCurrentThread() {
   return g_stack;
 }
 
+namespace {
+struct TraceEvent {
+  const char *name;
+  std::string message;
+  uint64_t start_nanos;
+  uint64_t duration_nanos;
+};
+
+// The trace events of one thread. Only that thread appends to it, so the
+// mutex is uncontended except while a trace is being exported or reset.
+struct TraceBuffer {
+  std::mutex mutex;
+  uint64_t thread_id;
+  std::vector<TraceEvent> events;
+};
+typedef std::vector<std::shared_ptr<TraceBuffer>> TraceBuffers;
+} // end of anonymous namespace
+
+// Bound the memory a forgotten trace can use: about 56MB per thread, plus
+// the messages that don't fit in a std::string.
+static const size_t g_max_trace_events_per_thread = 1024 * 1024;
+static std::atomic<uint64_t> g_dropped_trace_events(0);
+
+static std::mutex &GetTraceBuffersMutex() {
+  static std::mutex *g_mutex_ptr = new std::mutex();
+  return *g_mutex_ptr;
+}
+
+static TraceBuffers &GetTraceBuffers() {
+  static TraceBuffers *g_buffers_ptr = new TraceBuffers();
+  return *g_buffers_ptr;
+}
+
+static TraceBuffer &GetTraceBufferForCurrentThread() {
+  static thread_local std::shared_ptr<TraceBuffer> g_buffer_sp;
+  if (!g_buffer_sp) {
+    g_buffer_sp = std::make_shared<TraceBuffer>();
+    g_buffer_sp->thread_id = llvm::get_threadid();
+    std::lock_guard<std::mutex> guard(GetTraceBuffersMutex());
+    GetTraceBuffers().push_back(g_buffer_sp);
+  }
+  return *g_buffer_sp;
+}
+
 Timer::Category::Category(const char *cat) : m_name(cat) {
   m_nanos.store(0, std::memory_order_release);
   Category *expected = g_categories;
@@ -68,6 +123,15 @@ Timer::Timer(Timer::Category &category, const char *format, ...)
     // Newline
     ::fprintf(stdout, "\n");
   }
+
+  if (g_trace.load(std::memory_order_relaxed)) {
+    llvm::SmallString<64> message;
+    va_list args;
+    va_start(args, format);
+    VASprintf(message, format, args);
+    va_end(args);
+    m_trace_message.assign(message.begin(), message.end());
+  }
 }
 
 Timer::~Timer() {
@@ -93,6 +157,18 @@ Timer::~Timer() {
 
   // Keep total results for each category so we can dump results.
   m_category.m_nanos += std::chrono::nanoseconds(timer_dur).count();
+
+  if (g_trace.load(std::memory_order_relaxed)) {
+    TraceBuffer &buffer = GetTraceBufferForCurrentThread();
+    std::lock_guard<std::mutex> guard(buffer.mutex);
+    if (buffer.events.size() < g_max_trace_events_per_thread)
+      buffer.events.push_back(
+          {m_category.m_name, std::move(m_trace_message),
+           uint64_t(nanoseconds(m_total_start.time_since_epoch()).count()),
+           uint64_t(nanoseconds(total_dur).count())});
+    else
+      ++g_dropped_trace_events;
+  }
 }
 
 void Timer::SetDisplayDepth(uint32_t depth) { g_display_depth = depth; }
@@ -129,3 +205,78 @@ void Timer::DumpCategoryTimes(Stream *s) {
   for (const auto &timer : sorted)
     s->Printf("%.9f sec for %s\n", timer.second / 1000000000., timer.first);
 }
+
+void Timer::SetTraceEnabled(bool enabled) { g_trace = enabled; }
+
+bool Timer::GetTraceEnabled() { return g_trace; }
+
+void Timer::ResetTrace() {
+  std::lock_guard<std::mutex> guard(GetTraceBuffersMutex());
+  TraceBuffers &buffers = GetTraceBuffers();
+  for (auto &buffer_sp : buffers) {
+    std::lock_guard<std::mutex> buffer_guard(buffer_sp->mutex);
+    buffer_sp->events.clear();
+  }
+  // Buffers only we refer to belong to threads that have exited.
+  buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                               [](const std::shared_ptr<TraceBuffer> &sp) {
+                                 return sp.use_count() == 1;
+                               }),
+                buffers.end());
+  g_dropped_trace_events = 0;
+}
+
+static void WriteJSONString(llvm::raw_ostream &os, llvm::StringRef str) {
+  os << '"';
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\')
+      os << '\\' << ch;
+    else if (static_cast<unsigned char>(ch) < 0x20)
+      os << llvm::formatv("\\u{0:x-4}", unsigned(ch));
+    else
+      os << ch;
+  }
+  os << '"';
+}
+
+void Timer::DumpTrace(llvm::raw_ostream &os) {
+  const unsigned pid = llvm::sys::Process::getProcessId();
+
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  std::lock_guard<std::mutex> guard(GetTraceBuffersMutex());
+  for (auto &buffer_sp : GetTraceBuffers()) {
+    std::lock_guard<std::mutex> buffer_guard(buffer_sp->mutex);
+    for (const TraceEvent &event : buffer_sp->events) {
+      if (!first)
+        os << ",";
+      first = false;
+      // Chrome trace timestamps are in microseconds.
+      os << "\n{\"name\":";
+      WriteJSONString(os, event.name);
+      os << llvm::formatv(",\"cat\":\"lldb\",\"ph\":\"X\",\"ts\":{0:f3},"
+                          "\"dur\":{1:f3},\"pid\":{2},\"tid\":{3}",
+                          event.start_nanos / 1000.0,
+                          event.duration_nanos / 1000.0, pid,
+                          buffer_sp->thread_id);
+      if (!event.message.empty()) {
+        os << ",\"args\":{\"message\":";
+        WriteJSONString(os, event.message);
+        os << "}";
+      }
+      os << "}";
+    }
+  }
+  os << llvm::formatv("\n],\"displayTimeUnit\":\"ns\","
+                      "\"otherData\":{{\"droppedEvents\":{0}}}\n",
+                      g_dropped_trace_events.load());
+}
+
+llvm::Error Timer::ExportTrace(llvm::StringRef path) {
+  std::error_code ec;
+  llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::F_Text);
+  if (ec)
+    return llvm::errorCodeToError(ec);
+  DumpTrace(os);
+  return llvm::Error::success();
+}
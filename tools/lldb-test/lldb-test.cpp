@@ -167,6 +167,18 @@ static cl::opt<bool> DumpAST("dump-ast",
 static cl::opt<bool> Verify("verify", cl::desc("Verify symbol information."),
                             cl::sub(SymbolsSubcommand));
 
+static cl::opt<bool> WriteDebugNames(
+    "write-debug-names",
+    cl::desc("Generate a name index for a module without one and store it in "
+             "the debug names cache."),
+    cl::sub(SymbolsSubcommand));
+
+static cl::opt<std::string> DebugNamesCache(
+    "debug-names-cache",
+    cl::desc("Directory of generated name indexes "
+             "(symbols.debug-names-cache-path)."),
+    cl::value_desc("directory"), cl::sub(SymbolsSubcommand));
+
 static cl::opt<std::string> File("file",
                                  cl::desc("File (compile unit) to search."),
                                  cl::sub(SymbolsSubcommand));
@@ -183,6 +195,7 @@ static Error findVariables(lldb_private::Module &Module);
 static Error dumpModule(lldb_private::Module &Module);
 static Error dumpAST(lldb_private::Module &Module);
 static Error verify(lldb_private::Module &Module);
+static Error writeDebugNames(lldb_private::Module &Module);
 
 static Expected<Error (*)(lldb_private::Module &)> getAction();
 static int dumpSymbols(Debugger &Dbg);
@@ -644,7 +657,30 @@ Error opts::symbols::verify(lldb_private::Module &Module) {
   return Error::success();
 }
 
+Error opts::symbols::writeDebugNames(lldb_private::Module &Module) {
+  SymbolVendor &plugin = *Module.GetSymbolVendor();
+
+  SymbolFile *symfile = plugin.GetSymbolFile();
+  if (!symfile ||
+      symfile->GetPluginName() != SymbolFileDWARF::GetPluginNameStatic())
+    return make_string_error("Module has no DWARF symbol file.");
+
+  Status error = static_cast<SymbolFileDWARF *>(symfile)->WriteDebugNames();
+  if (error.Fail())
+    return make_string_error("Cannot write name index: {0}", error.AsCString());
+
+  outs() << "Wrote name index.\n";
+  return Error::success();
+}
+
 Expected<Error (*)(lldb_private::Module &)> opts::symbols::getAction() {
+  if (WriteDebugNames) {
+    if (Verify || DumpAST || Find != FindType::None)
+      return make_string_error("Cannot both write a name index and search, "
+                               "verify or dump AST.");
+    return writeDebugNames;
+  }
+
   if (Verify && DumpAST)
     return make_string_error(
         "Cannot both verify symbol information and dump AST.");
@@ -742,6 +778,16 @@ int opts::symbols::dumpSymbols(Debugger &Dbg) {
   }
   auto Action = *ActionOr;
 
+  if (!DebugNamesCache.empty()) {
+    Status error = Dbg.SetPropertyValue(nullptr, eVarSetOperationAssign,
+                                        "symbols.debug-names-cache-path",
+                                        DebugNamesCache);
+    if (error.Fail()) {
+      WithColor::error() << error.AsCString() << "\n";
+      return 1;
+    }
+  }
+
   outs() << "Module: " << InputFile << "\n";
   ModuleSpec Spec{FileSpec(InputFile)};
   StringRef Symbols = SymbolPath.empty() ? InputFile : SymbolPath;
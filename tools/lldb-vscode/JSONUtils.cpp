@@ -875,9 +875,13 @@ llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
   EmplaceSafeString(object, "type", type_cstr ? type_cstr : NO_TYPENAME);
   if (varID != INT64_MAX)
     object.try_emplace("id", varID);
-  if (v.MightHaveChildren())
+  if (v.MightHaveChildren()) {
     object.try_emplace("variablesReference", variablesReference);
-  else
+    // Let the client page through arrays with "start" and "count" instead
+    // of fetching every element when the array is expanded.
+    if (v.GetType().IsArrayType())
+      object.try_emplace("indexedVariables", (int64_t)v.GetNumChildren());
+  } else
     object.try_emplace("variablesReference", (int64_t)0);
   lldb::SBStream evaluateStream;
   v.GetExpressionPath(evaluateStream);
@@ -2541,8 +2541,13 @@ void request_variables(const llvm::json::Object &request) {
     const int64_t var_idx = VARREF_TO_VARIDX(variablesReference);
     lldb::SBValue variable = g_vsc.variables.GetValueAtIndex(var_idx);
     if (variable.IsValid()) {
-      const auto num_children = variable.GetNumChildren();
-      const int64_t end_idx = start + ((count == 0) ? num_children : count);
+      const int64_t num_children = variable.GetNumChildren();
+      const int64_t end_idx =
+          (count == 0) ? num_children : std::min(start + count, num_children);
+      // Read the memory behind the whole requested window at once instead
+      // of once per child.
+      if (start < end_idx)
+        variable.PrefetchChildren(start, end_idx - start);
       for (auto i = start; i < end_idx; ++i) {
         lldb::SBValue child = variable.GetChildAtIndex(i);
         if (!child.IsValid())
@@ -0,0 +1,261 @@
+//===-- ModuleListTest.cpp --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "TestingSupport/TestUtilities.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/PluginManager.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/CompilerType.h"
+#include "lldb/Symbol/Declaration.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/TypeList.h"
+#include "lldb/Symbol/TypeMap.h"
+
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Program.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+// A symbol file that has one function and one type called "needle", and
+// takes a while to find them, like a symbol file that has to index its debug
+// info first.
+class MockSymbolFile : public SymbolFile {
+public:
+  MockSymbolFile(ObjectFile *obj_file) : SymbolFile(obj_file) {}
+
+  static void Initialize() {
+    PluginManager::RegisterPlugin(GetPluginNameStatic(), "Mock symbol file",
+                                  CreateInstance);
+  }
+  static void Terminate() { PluginManager::UnregisterPlugin(CreateInstance); }
+
+  static ConstString GetPluginNameStatic() {
+    static ConstString g_name("mock");
+    return g_name;
+  }
+  static SymbolFile *CreateInstance(ObjectFile *obj_file) {
+    return new MockSymbolFile(obj_file);
+  }
+
+  static ConstString GetNeedle() { return ConstString("needle"); }
+
+  uint32_t CalculateAbilities() override { return kAllAbilities; }
+  uint32_t GetNumCompileUnits() override { return 0; }
+  CompUnitSP ParseCompileUnitAtIndex(uint32_t index) override {
+    return CompUnitSP();
+  }
+  LanguageType ParseLanguage(CompileUnit &comp_unit) override {
+    return eLanguageTypeUnknown;
+  }
+  size_t ParseFunctions(CompileUnit &comp_unit) override { return 0; }
+  bool ParseLineTable(CompileUnit &comp_unit) override { return false; }
+  bool ParseDebugMacros(CompileUnit &comp_unit) override { return false; }
+  bool ParseSupportFiles(CompileUnit &comp_unit,
+                         FileSpecList &support_files) override {
+    return false;
+  }
+  size_t ParseTypes(CompileUnit &comp_unit) override { return 0; }
+  bool ParseImportedModules(
+      const SymbolContext &sc,
+      std::vector<SourceModule> &imported_modules) override {
+    return false;
+  }
+  size_t ParseBlocksRecursive(Function &func) override { return 0; }
+  size_t ParseVariablesForContext(const SymbolContext &sc) override {
+    return 0;
+  }
+  Type *ResolveTypeUID(user_id_t type_uid) override { return nullptr; }
+  llvm::Optional<ArrayInfo>
+  GetDynamicArrayInfoForUID(user_id_t type_uid,
+                            const ExecutionContext *exe_ctx) override {
+    return llvm::None;
+  }
+  bool CompleteType(CompilerType &compiler_type) override { return false; }
+  uint32_t ResolveSymbolContext(const Address &so_addr,
+                                SymbolContextItem resolve_scope,
+                                SymbolContext &sc) override {
+    return 0;
+  }
+  size_t GetTypes(SymbolContextScope *sc_scope, TypeClass type_mask,
+                  TypeList &type_list) override {
+    return 0;
+  }
+
+  uint32_t FindFunctions(ConstString name,
+                         const CompilerDeclContext *parent_decl_ctx,
+                         FunctionNameType name_type_mask, bool include_inlines,
+                         bool append, SymbolContextList &sc_list) override {
+    Lookup();
+    if (!append)
+      sc_list.Clear();
+    if (name != GetNeedle())
+      return 0;
+    SymbolContext sc;
+    sc.module_sp = m_obj_file->GetModule();
+    sc_list.Append(sc);
+    return 1;
+  }
+
+  uint32_t FindTypes(ConstString name,
+                     const CompilerDeclContext *parent_decl_ctx, bool append,
+                     uint32_t max_matches,
+                     llvm::DenseSet<SymbolFile *> &searched_symbol_files,
+                     TypeMap &types) override {
+    if (!append)
+      types.Clear();
+    if (!searched_symbol_files.insert(this).second)
+      return 0;
+    Lookup();
+    if (name != GetNeedle())
+      return 0;
+    if (!m_type_sp)
+      m_type_sp = std::make_shared<Type>(
+          1, this, name, llvm::None, nullptr, LLDB_INVALID_UID,
+          Type::eEncodingIsUID, Declaration(), CompilerType(),
+          Type::eResolveStateFull);
+    types.Insert(m_type_sp);
+    return 1;
+  }
+
+  ConstString GetPluginName() override { return GetPluginNameStatic(); }
+  uint32_t GetPluginVersion() override { return 1; }
+
+private:
+  void Lookup() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+
+  TypeSP m_type_sp;
+};
+
+const size_t num_modules = 64;
+
+class ModuleListTest : public ::testing::Test {
+public:
+  llvm::SmallString<128> m_obj;
+  std::vector<ModuleSP> m_modules;
+  ModuleList m_module_list;
+
+  void SetUp() override {
+    FileSystem::Initialize();
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    MockSymbolFile::Initialize();
+
+    std::string yaml = GetInputFilePath("mangled-function-names.yaml");
+    ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("module-list-%%%%%%",
+                                                    "obj", m_obj));
+    llvm::StringRef args[] = {YAML2OBJ, yaml};
+    llvm::StringRef obj_ref = m_obj;
+    const llvm::Optional<llvm::StringRef> redirects[] = {llvm::None, obj_ref,
+                                                         llvm::None};
+    ASSERT_EQ(0,
+              llvm::sys::ExecuteAndWait(YAML2OBJ, args, llvm::None, redirects));
+
+    for (size_t idx = 0; idx < num_modules; ++idx) {
+      auto module_sp = std::make_shared<Module>(ModuleSpec(FileSpec(m_obj)));
+      ASSERT_NE(nullptr, module_sp->GetSymbolVendor());
+      m_modules.push_back(module_sp);
+      m_module_list.Append(module_sp);
+    }
+  }
+
+  void TearDown() override {
+    m_module_list.Clear();
+    m_modules.clear();
+    llvm::sys::fs::remove(m_obj);
+    MockSymbolFile::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+    FileSystem::Terminate();
+  }
+
+  Module *GetModule(const TypeSP &type_sp) {
+    return type_sp->GetSymbolFile()->GetObjectFile()->GetModule().get();
+  }
+};
+} // namespace
+
+TEST_F(ModuleListTest, FindFunctions) {
+  SymbolContextList sc_list;
+  EXPECT_EQ(num_modules,
+            m_module_list.FindFunctions(MockSymbolFile::GetNeedle(),
+                                        eFunctionNameTypeFull, false, false,
+                                        true, sc_list));
+  // Results come in module order, whichever module was searched first.
+  ASSERT_EQ(num_modules, sc_list.GetSize());
+  for (size_t idx = 0; idx < num_modules; ++idx) {
+    SymbolContext sc;
+    ASSERT_TRUE(sc_list.GetContextAtIndex(idx, sc));
+    EXPECT_EQ(m_modules[idx], sc.module_sp);
+  }
+}
+
+TEST_F(ModuleListTest, FindTypes) {
+  TypeList types;
+  llvm::DenseSet<SymbolFile *> searched_symbol_files;
+  EXPECT_EQ(num_modules,
+            m_module_list.FindTypes(nullptr, MockSymbolFile::GetNeedle(),
+                                    false, UINT32_MAX, searched_symbol_files,
+                                    types));
+  ASSERT_EQ(num_modules, types.GetSize());
+  for (size_t idx = 0; idx < num_modules; ++idx)
+    EXPECT_EQ(m_modules[idx].get(), GetModule(types.GetTypeAtIndex(idx)));
+  EXPECT_EQ(num_modules, searched_symbol_files.size());
+
+  // Symbol files already searched aren't searched again.
+  TypeList more_types;
+  EXPECT_EQ(0u, m_module_list.FindTypes(nullptr, MockSymbolFile::GetNeedle(),
+                                        false, UINT32_MAX,
+                                        searched_symbol_files, more_types));
+}
+
+TEST_F(ModuleListTest, FindTypesMaxMatches) {
+  // A single match is the one from the first module, or from the module
+  // searched first.
+  TypeList types;
+  llvm::DenseSet<SymbolFile *> searched_symbol_files;
+  EXPECT_EQ(1u, m_module_list.FindTypes(nullptr, MockSymbolFile::GetNeedle(),
+                                        false, 1, searched_symbol_files,
+                                        types));
+  ASSERT_EQ(1u, types.GetSize());
+  EXPECT_EQ(m_modules[0].get(), GetModule(types.GetTypeAtIndex(0)));
+
+  Module *search_first = m_modules[num_modules / 2].get();
+  TypeList first_types;
+  searched_symbol_files.clear();
+  EXPECT_EQ(1u, m_module_list.FindTypes(search_first,
+                                        MockSymbolFile::GetNeedle(), false, 1,
+                                        searched_symbol_files, first_types));
+  ASSERT_EQ(1u, first_types.GetSize());
+  EXPECT_EQ(search_first, GetModule(first_types.GetTypeAtIndex(0)));
+}
+
+TEST_F(ModuleListTest, FindTypesMissing) {
+  // A type that isn't anywhere is looked up in every module.
+  TypeList types;
+  llvm::DenseSet<SymbolFile *> searched_symbol_files;
+  EXPECT_EQ(0u, m_module_list.FindTypes(nullptr, ConstString("missing"), false,
+                                        UINT32_MAX, searched_symbol_files,
+                                        types));
+  EXPECT_EQ(0u, types.GetSize());
+  EXPECT_EQ(num_modules, searched_symbol_files.size());
+}
@@ -0,0 +1,106 @@
+//===-- DebugFileIndexTest.cpp ----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Host/DebugFileIndex.h"
+#include "lldb/Host/FileSystem.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+
+#include <thread>
+
+using namespace lldb_private;
+using namespace llvm::sys;
+
+namespace {
+class DebugFileIndexTest : public ::testing::Test {
+public:
+  llvm::SmallString<128> m_base_dir;
+  FileSpec m_cache_dir;
+
+  void SetUp() override {
+    FileSystem::Initialize();
+    ASSERT_FALSE(fs::createUniqueDirectory("DebugFileIndex", m_base_dir));
+    llvm::SmallString<128> cache_dir(m_base_dir);
+    path::append(cache_dir, "cache");
+    m_cache_dir = FileSpec(cache_dir);
+  }
+
+  void TearDown() override {
+    fs::remove_directories(m_base_dir);
+    FileSystem::Terminate();
+  }
+
+  std::string GetPath(llvm::StringRef name) {
+    llvm::SmallString<128> file(m_base_dir);
+    path::append(file, name);
+    return file.str();
+  }
+
+  std::string CreateFile(llvm::StringRef name) {
+    std::string file = GetPath(name);
+    EXPECT_FALSE(fs::create_directories(path::parent_path(file)));
+    int fd;
+    EXPECT_FALSE(fs::openFileForWrite(file, fd));
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    return file;
+  }
+};
+} // namespace
+
+TEST_F(DebugFileIndexTest, MayExist) {
+  std::string debug = CreateFile("debug/libfoo.so.debug");
+  std::string build_id = CreateFile("debug/.build-id/ff/e7fe7278.debug");
+
+  DebugFileIndex index((FileSpec()));
+  EXPECT_TRUE(index.IsDirectory(GetPath("debug")));
+  EXPECT_FALSE(index.IsDirectory(GetPath("missing")));
+  EXPECT_TRUE(index.MayExist(debug));
+  EXPECT_TRUE(index.MayExist(build_id));
+
+  uint64_t avoided = DebugFileIndex::GetLookupsAvoided();
+  uint64_t scanned = DebugFileIndex::GetDirectoriesScanned();
+  EXPECT_FALSE(index.MayExist(GetPath("debug/libbar.so.debug")));
+  EXPECT_FALSE(index.MayExist(GetPath("debug/.build-id/ff/0000.debug")));
+  EXPECT_FALSE(index.MayExist(GetPath("debug/.build-id/00/0000.debug")));
+  EXPECT_FALSE(index.MayExist(GetPath("missing/libfoo.so.debug")));
+  EXPECT_EQ(avoided + 4, DebugFileIndex::GetLookupsAvoided());
+  // Directories already listed, or missing, aren't listed again.
+  EXPECT_EQ(scanned, DebugFileIndex::GetDirectoriesScanned());
+}
+
+TEST_F(DebugFileIndexTest, Refresh) {
+  CreateFile("debug/libfoo.so.debug");
+  DebugFileIndex index((FileSpec()));
+  EXPECT_FALSE(index.MayExist(GetPath("debug/libbar.so.debug")));
+
+  // New files show up once the directory is checked again.
+  std::string bar = CreateFile("debug/libbar.so.debug");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  EXPECT_TRUE(index.MayExist(bar));
+}
+
+TEST_F(DebugFileIndexTest, RoundTrip) {
+  std::string debug = CreateFile("debug/libfoo.so.debug");
+  {
+    DebugFileIndex index(m_cache_dir);
+    EXPECT_TRUE(index.MayExist(debug));
+    ASSERT_TRUE(index.Save().Success());
+    EXPECT_TRUE(FileSystem::Instance().Exists(index.GetFileSpec()));
+  }
+
+  // An unchanged directory isn't listed again.
+  uint64_t scanned = DebugFileIndex::GetDirectoriesScanned();
+  DebugFileIndex index(m_cache_dir);
+  EXPECT_TRUE(index.MayExist(debug));
+  EXPECT_FALSE(index.MayExist(GetPath("debug/libbar.so.debug")));
+  EXPECT_EQ(scanned, DebugFileIndex::GetDirectoriesScanned());
+}
@@ -2,6 +2,9 @@
 
 #include "lldb/Host/TaskPool.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace lldb_private;
 
 TEST(TaskPoolTest, AddTask) {
@@ -43,3 +46,16 @@ TEST(TaskPoolTest, TaskMap) {
   ASSERT_EQ(data[2], 4);
   ASSERT_EQ(data[3], 9);
 }
+
+TEST(TaskPoolTest, NestedTaskMap) {
+  // Maps started from pool threads must not wait for pool threads that are
+  // all busy waiting themselves.
+  std::atomic<size_t> count(0);
+  const size_t n = 4 * std::max(1u, std::thread::hardware_concurrency());
+
+  TaskMapOverInt(0, n, [&](size_t) {
+    TaskMapOverInt(0, n, [&](size_t) { ++count; });
+  });
+
+  ASSERT_EQ(n * n, count);
+}
@@ -15,10 +15,15 @@
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/raw_ostream.h"
@@ -209,3 +214,118 @@ TEST_F(ObjectFileELFTest, TestAARCH64Relocations) {
   CHECK_ABS32(bytes, 0x39, 73);
   CHECK_ABS32(bytes, 0x44, 75);
 }
+
+// Write a 64-bit executable with a .text section and a symbol table of
+// num_symbols functions named f0, f1, ..., every fourth one with a version
+// suffix.
+static void WriteLargeSymbolTable(llvm::StringRef path, uint32_t num_symbols) {
+  using namespace llvm::ELF;
+  const uint64_t text_addr = 0x400000;
+  const uint64_t text_size = uint64_t(num_symbols) * 16;
+
+  std::string strtab(1, '\0');
+  std::vector<Elf64_Sym> symtab(1);
+  for (uint32_t i = 0; i < num_symbols; ++i) {
+    Elf64_Sym sym = {};
+    sym.st_name = strtab.size();
+    sym.setBindingAndType(STB_GLOBAL, STT_FUNC);
+    sym.st_shndx = 1;
+    sym.st_value = text_addr + i * 16;
+    sym.st_size = 16;
+    symtab.push_back(sym);
+    strtab += "f" + std::to_string(i) + (i % 4 ? "" : "@@VERS_1.0");
+    strtab += '\0';
+  }
+  const char shstrtab[] = "\0.text\0.symtab\0.strtab\0.shstrtab";
+
+  const uint64_t symtab_offset = sizeof(Elf64_Ehdr);
+  const uint64_t symtab_size = symtab.size() * sizeof(Elf64_Sym);
+  const uint64_t strtab_offset = symtab_offset + symtab_size;
+  const uint64_t shstrtab_offset = strtab_offset + strtab.size();
+  const uint64_t shdrs_offset = llvm::alignTo(
+      shstrtab_offset + sizeof(shstrtab), alignof(Elf64_Shdr));
+
+  Elf64_Ehdr ehdr = {};
+  memcpy(ehdr.e_ident, ElfMagic, strlen(ElfMagic));
+  ehdr.e_ident[EI_CLASS] = ELFCLASS64;
+  ehdr.e_ident[EI_DATA] =
+      llvm::sys::IsLittleEndianHost ? ELFDATA2LSB : ELFDATA2MSB;
+  ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+  ehdr.e_type = ET_EXEC;
+  ehdr.e_machine = EM_X86_64;
+  ehdr.e_version = EV_CURRENT;
+  ehdr.e_shoff = shdrs_offset;
+  ehdr.e_ehsize = sizeof(Elf64_Ehdr);
+  ehdr.e_shentsize = sizeof(Elf64_Shdr);
+  ehdr.e_shnum = 5;
+  ehdr.e_shstrndx = 4;
+
+  Elf64_Shdr shdrs[5] = {};
+  shdrs[1].sh_name = 1;
+  shdrs[1].sh_type = SHT_NOBITS;
+  shdrs[1].sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+  shdrs[1].sh_addr = text_addr;
+  shdrs[1].sh_offset = symtab_offset;
+  shdrs[1].sh_size = text_size;
+  shdrs[2].sh_name = 7;
+  shdrs[2].sh_type = SHT_SYMTAB;
+  shdrs[2].sh_offset = symtab_offset;
+  shdrs[2].sh_size = symtab_size;
+  shdrs[2].sh_link = 3;
+  shdrs[2].sh_info = 1;
+  shdrs[2].sh_entsize = sizeof(Elf64_Sym);
+  shdrs[3].sh_name = 15;
+  shdrs[3].sh_type = SHT_STRTAB;
+  shdrs[3].sh_offset = strtab_offset;
+  shdrs[3].sh_size = strtab.size();
+  shdrs[4].sh_name = 23;
+  shdrs[4].sh_type = SHT_STRTAB;
+  shdrs[4].sh_offset = shstrtab_offset;
+  shdrs[4].sh_size = sizeof(shstrtab);
+
+  std::error_code ec;
+  llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::F_None);
+  ASSERT_FALSE(ec);
+  os.write(reinterpret_cast<const char *>(&ehdr), sizeof(ehdr));
+  os.write(reinterpret_cast<const char *>(symtab.data()), symtab_size);
+  os << strtab;
+  os.write(shstrtab, sizeof(shstrtab));
+  os << std::string(shdrs_offset - shstrtab_offset - sizeof(shstrtab), '\0');
+  os.write(reinterpret_cast<const char *>(shdrs), sizeof(shdrs));
+}
+
+// Symbol tables this large are decoded on several threads; the result has to
+// be the same as a serial parse.
+TEST_F(ObjectFileELFTest, LargeSymbolTable) {
+  const uint32_t num_symbols = 1 << 18;
+  llvm::SmallString<128> obj;
+  ASSERT_NO_ERROR(llvm::sys::fs::createTemporaryFile(
+      "large-symbol-table-%%%%%%", "obj", obj));
+  llvm::FileRemover remover(obj);
+  WriteLargeSymbolTable(obj, num_symbols);
+
+  ModuleSpec spec{FileSpec(obj)};
+  auto module_sp = std::make_shared<Module>(spec);
+  ASSERT_NE(nullptr, module_sp->GetObjectFile());
+
+  Symtab *symtab = module_sp->GetObjectFile()->GetSymtab();
+  ASSERT_NE(nullptr, symtab);
+  ASSERT_EQ(num_symbols, symtab->GetNumSymbols());
+  auto text_sp =
+      module_sp->GetSectionList()->FindSectionByName(ConstString(".text"));
+  ASSERT_NE(nullptr, text_sp);
+  for (uint32_t i = 0; i < num_symbols; i += 997) {
+    const Symbol *symbol = symtab->SymbolAtIndex(i);
+    ASSERT_NE(nullptr, symbol);
+    // Symbol 0 is the null entry, which isn't added.
+    EXPECT_EQ(i + 1, symbol->GetID());
+    EXPECT_EQ(eSymbolTypeCode, symbol->GetType());
+    EXPECT_EQ(text_sp, symbol->GetAddress().GetSection());
+    EXPECT_EQ(0x400000u + i * 16, symbol->GetAddress().GetFileAddress());
+    std::string name = "f" + std::to_string(i);
+    if (i % 4 == 0)
+      name += "@@VERS_1.0";
+    EXPECT_EQ(name, symbol->GetName().GetStringRef());
+    EXPECT_EQ(i % 4 == 0, symbol->ContainsLinkerAnnotations());
+  }
+}
@@ -320,6 +320,31 @@ TEST_F(GDBRemoteCommunicationClientTest, SendSignalsToIgnore) {
   EXPECT_TRUE(result.get().Success());
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, SendConditionalBreakpoint) {
+  AgentExpression first;
+  first.EmitConstant(1);
+  first.Emit(AgentExpression::eOpEnd);
+  AgentExpression second;
+  second.EmitRegister(6);
+  second.Emit(AgentExpression::eOpEnd);
+  std::vector<AgentExpression> conditions = {first, second};
+
+  std::future<uint8_t> result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePacket(eBreakpointSoftware, true, 0x1000,
+                                             1, conditions);
+  });
+  HandlePacket(server, "Z0,1000,1;X3,220127X4,26000627", "OK");
+  EXPECT_EQ(0, result.get());
+
+  // Conditions are never sent when removing a breakpoint.
+  result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePacket(eBreakpointSoftware, false,
+                                             0x1000, 1, conditions);
+  });
+  HandlePacket(server, "z0,1000,1", "OK");
+  EXPECT_EQ(0, result.get());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfo) {
   const lldb::addr_t addr = 0xa000;
   MemoryRegionInfo region_info;
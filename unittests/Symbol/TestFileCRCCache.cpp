@@ -0,0 +1,130 @@
+//===-- TestFileCRCCache.cpp ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Symbol/FileCRCCache.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace llvm::sys;
+
+struct TestFileCRCCache : public testing::Test {
+  llvm::SmallString<128> m_base_dir;
+  FileSpec m_cache_dir;
+
+  void SetUp() override {
+    ASSERT_FALSE(fs::createUniqueDirectory("ModuleCRCCache", m_base_dir));
+    llvm::SmallString<128> cache_dir(m_base_dir);
+    path::append(cache_dir, "cache");
+    m_cache_dir = FileSpec(cache_dir);
+  }
+
+  void TearDown() override { fs::remove_directories(m_base_dir); }
+
+  static void SetUpTestCase() { FileSystem::Initialize(); }
+  static void TearDownTestCase() { FileSystem::Terminate(); }
+
+  FileSpec CreateFile(llvm::StringRef name, llvm::StringRef contents) {
+    llvm::SmallString<128> file(m_base_dir);
+    path::append(file, name);
+    std::error_code ec;
+    llvm::raw_fd_ostream os(file, ec, fs::F_None);
+    EXPECT_FALSE(ec);
+    os << contents;
+    return FileSpec(file);
+  }
+};
+
+static llvm::ArrayRef<uint8_t> Bytes(llvm::StringRef str) {
+  return llvm::makeArrayRef(str.bytes_begin(), str.bytes_end());
+}
+
+TEST_F(TestFileCRCCache, CalculateCRC32) {
+  EXPECT_EQ(0u, FileCRCCache::CalculateCRC32(0, {}));
+  EXPECT_EQ(0xcbf43926u, FileCRCCache::CalculateCRC32(0, Bytes("123456789")));
+  // Continuing a checksum is the same as checksumming the concatenation.
+  EXPECT_EQ(0xcbf43926u, FileCRCCache::CalculateCRC32(
+                             FileCRCCache::CalculateCRC32(0, Bytes("1234")),
+                             Bytes("56789")));
+}
+
+TEST_F(TestFileCRCCache, CalculateCRC32Parallel) {
+  // Large enough to be split into chunks.
+  std::vector<uint8_t> data(65 * 1024 * 1024 + 7);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = uint8_t(i * 7919 + (i >> 13));
+
+  uint32_t serial = 0;
+  const size_t piece = 1024 * 1024;
+  for (size_t offset = 0; offset < data.size(); offset += piece)
+    serial = FileCRCCache::CalculateCRC32(
+        serial, llvm::makeArrayRef(data).slice(offset).take_front(piece));
+  EXPECT_EQ(serial, FileCRCCache::CalculateCRC32(0, data));
+}
+
+TEST_F(TestFileCRCCache, RoundTrip) {
+  llvm::StringRef contents = "not really an ELF file";
+  FileSpec file = CreateFile("a.out", contents);
+  {
+    FileCRCCache cache(m_cache_dir);
+    uint64_t misses = FileCRCCache::GetCacheMisses();
+    EXPECT_EQ(FileCRCCache::CalculateCRC32(0, Bytes(contents)),
+              cache.GetCRC32(file, 0, Bytes(contents)));
+    EXPECT_EQ(misses + 1, FileCRCCache::GetCacheMisses());
+    EXPECT_TRUE(FileSystem::Instance().Exists(cache.GetFileSpec()));
+  }
+
+  // Return the cached checksum, even if it doesn't match the contents.
+  uint64_t hits = FileCRCCache::GetCacheHits();
+  FileCRCCache cache(m_cache_dir);
+  EXPECT_EQ(FileCRCCache::CalculateCRC32(0, Bytes(contents)),
+            cache.GetCRC32(file, 0, Bytes("NOT REALLY AN ELF FILE")));
+  EXPECT_EQ(hits + 1, FileCRCCache::GetCacheHits());
+
+  // A different slice of the file is a different entry.
+  EXPECT_EQ(FileCRCCache::CalculateCRC32(0, Bytes("really")),
+            cache.GetCRC32(file, 4, Bytes("really")));
+}
+
+TEST_F(TestFileCRCCache, ModifiedFile) {
+  FileSpec file = CreateFile("a.out", "before");
+  FileCRCCache cache(m_cache_dir);
+  cache.GetCRC32(file, 0, Bytes("before"));
+
+  int fd;
+  ASSERT_FALSE(fs::openFileForWrite(file.GetPath(), fd));
+  ASSERT_FALSE(fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now() + std::chrono::hours(1)));
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+
+  uint64_t misses = FileCRCCache::GetCacheMisses();
+  EXPECT_EQ(FileCRCCache::CalculateCRC32(0, Bytes("after!")),
+            cache.GetCRC32(file, 0, Bytes("after!")));
+  EXPECT_EQ(misses + 1, FileCRCCache::GetCacheMisses());
+}
+
+TEST_F(TestFileCRCCache, InMemory) {
+  FileSpec file = CreateFile("a.out", "contents");
+  FileCRCCache cache((FileSpec()));
+  EXPECT_FALSE(cache.GetFileSpec());
+  cache.GetCRC32(file, 0, Bytes("contents"));
+
+  uint64_t hits = FileCRCCache::GetCacheHits();
+  cache.GetCRC32(file, 0, Bytes("contents"));
+  EXPECT_EQ(hits + 1, FileCRCCache::GetCacheHits());
+  EXPECT_FALSE(FileSystem::Instance().Exists(m_cache_dir));
+}
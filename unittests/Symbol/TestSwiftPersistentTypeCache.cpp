@@ -0,0 +1,178 @@
+//===-- TestSwiftPersistentTypeCache.cpp ----------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2019 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Symbol/SwiftPersistentTypeCache.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace llvm::sys;
+
+struct TestSwiftPersistentTypeCache : public testing::Test {
+  llvm::SmallString<128> m_base_dir;
+  FileSpec m_cache_dir;
+  UUID m_uuid = UUID::fromData("@ABCDEFGHIJKLMNO", 16);
+
+  void SetUp() override {
+    ASSERT_FALSE(fs::createUniqueDirectory("SwiftTypeCache", m_base_dir));
+    llvm::SmallString<128> cache_dir(m_base_dir);
+    path::append(cache_dir, "cache");
+    m_cache_dir = FileSpec(cache_dir);
+  }
+
+  void TearDown() override { fs::remove_directories(m_base_dir); }
+
+  static void SetUpTestCase() { FileSystem::Initialize(); }
+  static void TearDownTestCase() { FileSystem::Terminate(); }
+
+  std::unique_ptr<SwiftPersistentTypeCache>
+  Open(llvm::StringRef version = "swift 1.0", uint64_t max_size = 1 << 20) {
+    return SwiftPersistentTypeCache::Open(m_cache_dir, m_uuid, version,
+                                          max_size);
+  }
+
+  std::string CreateFile(llvm::StringRef name) {
+    llvm::SmallString<128> file(m_base_dir);
+    path::append(file, name);
+    int fd;
+    EXPECT_FALSE(fs::openFileForWrite(file, fd));
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    return file.str();
+  }
+};
+
+TEST_F(TestSwiftPersistentTypeCache, Disabled) {
+  EXPECT_EQ(nullptr, SwiftPersistentTypeCache::Open(FileSpec(), m_uuid,
+                                                    "swift 1.0", 1 << 20));
+  EXPECT_EQ(nullptr, SwiftPersistentTypeCache::Open(m_cache_dir, UUID(),
+                                                    "swift 1.0", 1 << 20));
+  EXPECT_EQ(nullptr, Open("swift 1.0", 0));
+}
+
+TEST_F(TestSwiftPersistentTypeCache, RoundTrip) {
+  std::string module_path = CreateFile("Foundation.swiftmodule");
+  {
+    auto cache = Open();
+    ASSERT_NE(nullptr, cache);
+    EXPECT_FALSE(cache->IsKnownTypeFailure("$s3Foo3BarVD"));
+    cache->RecordTypeFailure("$s3Foo3BarVD");
+    cache->RecordImport("Missing", "");
+    cache->RecordImport("Foundation", module_path);
+    ASSERT_TRUE(cache->Save().Success());
+    EXPECT_TRUE(FileSystem::Instance().Exists(cache->GetFileSpec()));
+  }
+
+  uint64_t hits = SwiftPersistentTypeCache::GetCacheHits();
+  auto cache = Open();
+  ASSERT_NE(nullptr, cache);
+  EXPECT_TRUE(cache->IsKnownTypeFailure("$s3Foo3BarVD"));
+  EXPECT_FALSE(cache->IsKnownTypeFailure("$s3Foo3BazVD"));
+  EXPECT_TRUE(cache->IsKnownImportFailure("Missing"));
+  EXPECT_FALSE(cache->IsKnownImportFailure("Foundation"));
+  EXPECT_EQ(module_path, cache->GetImportPath("Foundation"));
+  EXPECT_EQ("", cache->GetImportPath("Missing"));
+  EXPECT_EQ(hits + 3, SwiftPersistentTypeCache::GetCacheHits());
+
+  // A different compiler or search configuration doesn't share the cache.
+  auto other = Open("swift 2.0");
+  ASSERT_NE(nullptr, other);
+  EXPECT_FALSE(other->IsKnownTypeFailure("$s3Foo3BarVD"));
+}
+
+TEST_F(TestSwiftPersistentTypeCache, StaleImport) {
+  std::string module_path = CreateFile("Foundation.swiftmodule");
+  {
+    auto cache = Open();
+    cache->RecordTypeFailure("$s3Foo3BarVD");
+    cache->RecordImport("Foundation", module_path);
+    ASSERT_TRUE(cache->Save().Success());
+  }
+
+  // Rebuilding an imported module invalidates everything.
+  int fd;
+  ASSERT_FALSE(fs::openFileForWrite(module_path, fd));
+  ASSERT_FALSE(fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now() + std::chrono::hours(1)));
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+
+  auto cache = Open();
+  ASSERT_NE(nullptr, cache);
+  EXPECT_FALSE(cache->IsKnownTypeFailure("$s3Foo3BarVD"));
+}
+
+TEST_F(TestSwiftPersistentTypeCache, FailuresExpire) {
+  std::string module_path = CreateFile("Foundation.swiftmodule");
+  {
+    auto cache = Open();
+    cache->RecordTypeFailure("$s3Foo3BarVD");
+    cache->RecordImport("Missing", "");
+    cache->RecordImport("Foundation", module_path);
+    ASSERT_TRUE(cache->Save().Success());
+  }
+
+  {
+    auto cache = SwiftPersistentTypeCache::Open(
+        m_cache_dir, m_uuid, "swift 1.0", 1 << 20, std::chrono::hours(1));
+    ASSERT_NE(nullptr, cache);
+    EXPECT_TRUE(cache->IsKnownTypeFailure("$s3Foo3BarVD"));
+    EXPECT_TRUE(cache->IsKnownImportFailure("Missing"));
+  }
+
+  // Failures older than their lifetime are forgotten, the rest of the cache
+  // is still used.
+  auto cache = SwiftPersistentTypeCache::Open(
+      m_cache_dir, m_uuid, "swift 1.0", 1 << 20, std::chrono::seconds(0));
+  ASSERT_NE(nullptr, cache);
+  EXPECT_FALSE(cache->IsKnownTypeFailure("$s3Foo3BarVD"));
+  EXPECT_FALSE(cache->IsKnownImportFailure("Missing"));
+  ASSERT_TRUE(cache->Save().Success());
+
+  auto saved = Open();
+  ASSERT_NE(nullptr, saved);
+  EXPECT_FALSE(saved->IsKnownTypeFailure("$s3Foo3BarVD"));
+}
+
+TEST_F(TestSwiftPersistentTypeCache, SizeLimit) {
+  auto cache = Open("swift 1.0", 64);
+  ASSERT_NE(nullptr, cache);
+  for (int i = 0; i < 16; ++i)
+    cache->RecordTypeFailure("$s3Foo3BarV" + std::to_string(i) + "D");
+  ASSERT_TRUE(cache->Save().Success());
+
+  uint64_t size;
+  ASSERT_FALSE(fs::file_size(cache->GetFileSpec().GetPath(), size));
+  EXPECT_LE(size, 64u);
+}
+
+TEST_F(TestSwiftPersistentTypeCache, Prune) {
+  m_uuid = UUID::fromData("0123456789abcdef", 16);
+  auto first = Open();
+  first->RecordTypeFailure("$s3Foo3BarVD");
+  ASSERT_TRUE(first->Save().Success());
+
+  m_uuid = UUID::fromData("fedcba9876543210", 16);
+  auto second = Open();
+  second->RecordTypeFailure("$s3Foo3BazVD");
+  ASSERT_TRUE(second->Save().Success());
+
+  uint64_t size;
+  ASSERT_FALSE(fs::file_size(second->GetFileSpec().GetPath(), size));
+  SwiftPersistentTypeCache::Prune(m_cache_dir, size);
+  EXPECT_EQ(1, FileSystem::Instance().Exists(first->GetFileSpec()) +
+                   FileSystem::Instance().Exists(second->GetFileSpec()));
+}
@@ -0,0 +1,87 @@
+//===-- DWOFileCacheTest.cpp ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/DWOFileCache.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Utility/DataBuffer.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace llvm::sys;
+
+namespace {
+class DWOFileCacheTest : public ::testing::Test {
+public:
+  llvm::SmallString<128> m_base_dir;
+
+  void SetUp() override {
+    FileSystem::Initialize();
+    ASSERT_FALSE(fs::createUniqueDirectory("DWOFileCache", m_base_dir));
+  }
+
+  void TearDown() override {
+    fs::remove_directories(m_base_dir);
+    FileSystem::Terminate();
+  }
+
+  FileSpec CreateFile(llvm::StringRef name, llvm::StringRef contents) {
+    llvm::SmallString<128> file(m_base_dir);
+    path::append(file, name);
+    std::error_code ec;
+    llvm::raw_fd_ostream os(file, ec, fs::F_None);
+    EXPECT_FALSE(ec);
+    os << contents;
+    return FileSpec(file);
+  }
+};
+} // namespace
+
+static llvm::StringRef GetContents(const DataBufferSP &data_sp) {
+  return llvm::StringRef(reinterpret_cast<const char *>(data_sp->GetBytes()),
+                         data_sp->GetByteSize());
+}
+
+TEST_F(DWOFileCacheTest, Shared) {
+  FileSpec file = CreateFile("a.dwo", "dwo contents");
+  DWOFileCache cache;
+  DataBufferSP first = cache.GetFileData(file);
+  ASSERT_TRUE(first);
+  EXPECT_EQ("dwo contents", GetContents(first));
+  // Read once while someone still holds on to the contents.
+  EXPECT_EQ(first, cache.GetFileData(file));
+
+  // Rewritten files are read again.
+  CreateFile("a.dwo", "new dwo contents");
+  DataBufferSP second = cache.GetFileData(file);
+  ASSERT_TRUE(second);
+  EXPECT_EQ("new dwo contents", GetContents(second));
+}
+
+TEST_F(DWOFileCacheTest, Parallel) {
+  std::vector<FileSpec> files;
+  for (int i = 0; i < 20; ++i)
+    files.push_back(CreateFile(std::to_string(i) + ".dwo", std::to_string(i)));
+  llvm::SmallString<128> missing(m_base_dir);
+  path::append(missing, "missing.dwo");
+  files.push_back(FileSpec(missing));
+
+  DWOFileCache cache;
+  std::vector<DataBufferSP> data = cache.GetFileData(files, 4);
+  ASSERT_EQ(files.size(), data.size());
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(data[i]);
+    EXPECT_EQ(std::to_string(i), GetContents(data[i]));
+  }
+  EXPECT_FALSE(data.back());
+}
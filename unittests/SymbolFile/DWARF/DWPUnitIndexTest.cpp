@@ -0,0 +1,141 @@
+//===-- DWPUnitIndexTest.cpp ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/DWPUnitIndex.h"
+#include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Endian.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+/// Builds a .debug_cu_index section the way llvm-dwp lays it out.
+class UnitIndexWriter {
+public:
+  std::vector<uint32_t> columns = {llvm::DW_SECT_INFO, llvm::DW_SECT_ABBREV,
+                                   llvm::DW_SECT_LINE,
+                                   llvm::DW_SECT_STR_OFFSETS};
+  std::vector<uint64_t> signatures;
+
+  DataExtractor Write() const {
+    const uint32_t num_units = signatures.size();
+    const uint32_t num_buckets = llvm::NextPowerOf2(3 * num_units / 2);
+    std::vector<uint64_t> hashes(num_buckets);
+    std::vector<uint32_t> rows(num_buckets);
+    const uint64_t mask = num_buckets - 1;
+    for (uint32_t i = 0; i < num_units; ++i) {
+      const uint64_t signature = signatures[i];
+      uint64_t bucket = signature & mask;
+      const uint64_t step = ((signature >> 32) & mask) | 1;
+      while (rows[bucket])
+        bucket = (bucket + step) & mask;
+      hashes[bucket] = signature;
+      rows[bucket] = i + 1;
+    }
+
+    std::vector<uint8_t> bytes;
+    auto append = [&bytes](const void *value, size_t size) {
+      const uint8_t *begin = static_cast<const uint8_t *>(value);
+      bytes.insert(bytes.end(), begin, begin + size);
+    };
+    const uint32_t header[] = {2, uint32_t(columns.size()), num_units,
+                               num_buckets};
+    append(header, sizeof(header));
+    append(hashes.data(), hashes.size() * sizeof(uint64_t));
+    append(rows.data(), rows.size() * sizeof(uint32_t));
+    append(columns.data(), columns.size() * sizeof(uint32_t));
+    for (uint32_t row = 1; row <= num_units; ++row)
+      for (uint32_t column = 0; column < columns.size(); ++column) {
+        const uint32_t offset = GetOffset(row, column);
+        append(&offset, sizeof(offset));
+      }
+    for (uint32_t row = 1; row <= num_units; ++row)
+      for (uint32_t column = 0; column < columns.size(); ++column) {
+        const uint32_t length = GetLength(row, column);
+        append(&length, sizeof(length));
+      }
+
+    auto data_sp = std::make_shared<DataBufferHeap>(bytes.data(), bytes.size());
+    return DataExtractor(data_sp, endian::InlHostByteOrder(), 8);
+  }
+
+  static uint32_t GetOffset(uint32_t row, uint32_t column) {
+    return row * 1000 + column;
+  }
+  static uint32_t GetLength(uint32_t row, uint32_t column) {
+    return row + column;
+  }
+};
+} // namespace
+
+TEST(DWPUnitIndexTest, Lookup) {
+  UnitIndexWriter writer;
+  writer.signatures = {0x1111222233334444, 0x5555666677778888, 0};
+  DWPUnitIndex index;
+  ASSERT_TRUE(index.Parse(writer.Write()));
+  EXPECT_EQ(3u, index.GetNumUnits());
+
+  EXPECT_EQ(2u, index.FindRow(0x5555666677778888));
+  // A zero signature is valid; empty buckets are recognized by their row.
+  EXPECT_EQ(3u, index.FindRow(0));
+  EXPECT_EQ(0u, index.FindRow(0x1111222233334445));
+
+  DWPUnitIndex::Contribution contribution;
+  ASSERT_TRUE(index.GetContribution(2, llvm::DW_SECT_LINE, contribution));
+  EXPECT_EQ(UnitIndexWriter::GetOffset(2, 2), contribution.offset);
+  EXPECT_EQ(UnitIndexWriter::GetLength(2, 2), contribution.length);
+  // No column for this section.
+  EXPECT_FALSE(index.GetContribution(2, llvm::DW_SECT_LOC, contribution));
+  EXPECT_FALSE(index.GetContribution(0, llvm::DW_SECT_INFO, contribution));
+  EXPECT_FALSE(index.GetContribution(4, llvm::DW_SECT_INFO, contribution));
+}
+
+TEST(DWPUnitIndexTest, Malformed) {
+  UnitIndexWriter writer;
+  writer.signatures = {1, 2, 3};
+  DataExtractor data = writer.Write();
+
+  DWPUnitIndex index;
+  EXPECT_FALSE(index.Parse(DataExtractor(data, 0, data.GetByteSize() - 1)));
+  EXPECT_EQ(0u, index.FindRow(1));
+  EXPECT_FALSE(index.Parse(DataExtractor(data, 0, 8)));
+
+  std::vector<uint8_t> bytes(data.GetDataStart(), data.GetDataEnd());
+  uint32_t version = 5;
+  memcpy(bytes.data(), &version, sizeof(version));
+  EXPECT_FALSE(index.Parse(DataExtractor(bytes.data(), bytes.size(),
+                                         endian::InlHostByteOrder(), 8)));
+}
+
+TEST(DWPUnitIndexTest, LargePackage) {
+  UnitIndexWriter writer;
+  const uint32_t num_units = 50000;
+  for (uint64_t i = 1; i <= num_units; ++i)
+    writer.signatures.push_back(i * 0x9e3779b97f4a7c15ULL);
+  DataExtractor data = writer.Write();
+
+  DWPUnitIndex index;
+  ASSERT_TRUE(index.Parse(data));
+  DWPUnitIndex::Contribution contribution;
+  for (uint32_t i = 0; i < num_units; ++i) {
+    const uint32_t row = index.FindRow(writer.signatures[i]);
+    ASSERT_EQ(i + 1, row);
+    ASSERT_TRUE(index.GetContribution(row, llvm::DW_SECT_INFO, contribution));
+    ASSERT_EQ(UnitIndexWriter::GetOffset(row, 0), contribution.offset);
+    // Neighbouring signatures share most of their bits but aren't in it.
+    ASSERT_EQ(0u, index.FindRow(writer.signatures[i] + 1));
+  }
+}
@@ -0,0 +1,104 @@
+//===-- DebugNamesWriterTest.cpp --------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/SymbolFile/DWARF/DebugNamesWriter.h"
+
+#include "llvm/DebugInfo/DWARF/DWARFAcceleratorTable.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Testing/Support/Error.h"
+
+using namespace lldb_private;
+
+namespace {
+struct Entry {
+  dw_tag_t tag;
+  uint64_t cu_offset;
+  uint64_t die_offset;
+
+  bool operator==(const Entry &rhs) const {
+    return tag == rhs.tag && cu_offset == rhs.cu_offset &&
+           die_offset == rhs.die_offset;
+  }
+};
+
+class DebugNamesWriterTest : public testing::Test {
+public:
+  std::string m_debug_names, m_debug_str;
+  std::unique_ptr<llvm::DWARFDebugNames> m_index;
+
+  void Read(const DebugNamesWriter &writer) {
+    writer.Write(m_debug_names, m_debug_str);
+    const bool little_endian = llvm::sys::IsLittleEndianHost;
+    m_index = llvm::make_unique<llvm::DWARFDebugNames>(
+        llvm::DWARFDataExtractor(m_debug_names, little_endian, 8),
+        llvm::DataExtractor(m_debug_str, little_endian, 8));
+    ASSERT_THAT_ERROR(m_index->extract(), llvm::Succeeded());
+  }
+
+  std::vector<Entry> Lookup(llvm::StringRef name) {
+    std::vector<Entry> result;
+    for (const llvm::DWARFDebugNames::Entry &entry :
+         m_index->equal_range(name))
+      result.push_back({dw_tag_t(entry.tag()), *entry.getCUOffset(),
+                        *entry.getDIEUnitOffset()});
+    return result;
+  }
+};
+} // namespace
+
+TEST_F(DebugNamesWriterTest, RoundTrip) {
+  DebugNamesWriter writer;
+  writer.AddUnit(0);
+  writer.AddUnit(0x100);
+  // A unit without names is still listed.
+  writer.AddUnit(0x200);
+  writer.AddName("foo", DW_TAG_subprogram, 0, 0x2a);
+  writer.AddName("foo", DW_TAG_variable, 0x100, 0x10);
+  writer.AddName("_Z3foov", DW_TAG_subprogram, 0, 0x2a);
+  writer.AddName("bar", DW_TAG_structure_type, 0x100, 0x30);
+  // Duplicates are dropped.
+  writer.AddName("foo", DW_TAG_subprogram, 0, 0x2a);
+  ASSERT_NO_FATAL_FAILURE(Read(writer));
+
+  const llvm::DWARFDebugNames::NameIndex &ni = *m_index->begin();
+  EXPECT_EQ(3u, ni.getCUCount());
+  EXPECT_EQ(0x200u, ni.getCUOffset(2));
+  EXPECT_EQ(3u, ni.getNameCount());
+
+  std::vector<Entry> expected = {{DW_TAG_subprogram, 0, 0x2a},
+                                 {DW_TAG_variable, 0x100, 0x10}};
+  EXPECT_EQ(expected, Lookup("foo"));
+  expected = {{DW_TAG_subprogram, 0, 0x2a}};
+  EXPECT_EQ(expected, Lookup("_Z3foov"));
+  expected = {{DW_TAG_structure_type, 0x100, 0x30}};
+  EXPECT_EQ(expected, Lookup("bar"));
+  EXPECT_TRUE(Lookup("baz").empty());
+}
+
+TEST_F(DebugNamesWriterTest, ManyNames) {
+  // Enough names to share buckets.
+  DebugNamesWriter writer;
+  for (uint32_t i = 0; i < 5000; ++i)
+    writer.AddName("name" + std::to_string(i), DW_TAG_subprogram, 0, i);
+  ASSERT_NO_FATAL_FAILURE(Read(writer));
+
+  EXPECT_EQ(5000u, m_index->begin()->getNameCount());
+  for (uint32_t i = 0; i < 5000; i += 7) {
+    std::vector<Entry> expected = {{DW_TAG_subprogram, 0, i}};
+    ASSERT_EQ(expected, Lookup("name" + std::to_string(i)));
+  }
+}
+
+TEST_F(DebugNamesWriterTest, Empty) {
+  DebugNamesWriter writer;
+  writer.AddUnit(0);
+  ASSERT_NO_FATAL_FAILURE(Read(writer));
+  EXPECT_TRUE(Lookup("foo").empty());
+}
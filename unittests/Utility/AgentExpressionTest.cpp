@@ -0,0 +1,173 @@
+//===-- AgentExpressionTest.cpp ---------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+#include <map>
+
+using namespace lldb_private;
+
+namespace {
+struct FakeTarget {
+  std::map<uint32_t, uint64_t> registers;
+  std::map<lldb::addr_t, uint64_t> memory;
+
+  llvm::Expected<uint64_t> Evaluate(const AgentExpression &expr) {
+    return expr.Evaluate(
+        [this](uint32_t regnum) -> llvm::Optional<uint64_t> {
+          auto pos = registers.find(regnum);
+          if (pos == registers.end())
+            return llvm::None;
+          return pos->second;
+        },
+        [this](lldb::addr_t addr, size_t size) -> llvm::Optional<uint64_t> {
+          auto pos = memory.find(addr);
+          if (pos == memory.end())
+            return llvm::None;
+          if (size == 8)
+            return pos->second;
+          return pos->second & ((uint64_t(1) << (size * 8)) - 1);
+        });
+  }
+};
+} // namespace
+
+TEST(AgentExpressionTest, Constants) {
+  FakeTarget target;
+  for (uint64_t value : {uint64_t(0), uint64_t(0x12), uint64_t(0x1234),
+                         uint64_t(0x12345678), uint64_t(0x123456789abcdef0)}) {
+    AgentExpression expr;
+    expr.EmitConstant(value);
+    expr.Emit(AgentExpression::eOpEnd);
+    EXPECT_THAT_EXPECTED(target.Evaluate(expr), llvm::HasValue(value));
+  }
+
+  // The encoding is the one GDB uses.
+  AgentExpression expr;
+  expr.EmitConstant(0x1234);
+  EXPECT_EQ(std::vector<uint8_t>({0x23, 0x12, 0x34}),
+            std::vector<uint8_t>(expr.GetBytes().begin(),
+                                 expr.GetBytes().end()));
+}
+
+TEST(AgentExpressionTest, Arithmetic) {
+  FakeTarget target;
+  auto binary = [&](uint64_t a, uint64_t b, AgentExpression::Opcode op) {
+    AgentExpression expr;
+    expr.EmitConstant(a);
+    expr.EmitConstant(b);
+    expr.Emit(op);
+    expr.Emit(AgentExpression::eOpEnd);
+    return target.Evaluate(expr);
+  };
+  const uint64_t minus_seven = uint64_t(-7);
+
+  EXPECT_THAT_EXPECTED(binary(7, 5, AgentExpression::eOpSub),
+                       llvm::HasValue(2));
+  EXPECT_THAT_EXPECTED(binary(minus_seven, 2, AgentExpression::eOpDivSigned),
+                       llvm::HasValue(uint64_t(-3)));
+  EXPECT_THAT_EXPECTED(binary(minus_seven, 2, AgentExpression::eOpRemSigned),
+                       llvm::HasValue(uint64_t(-1)));
+  EXPECT_THAT_EXPECTED(binary(minus_seven, 1, AgentExpression::eOpRshSigned),
+                       llvm::HasValue(uint64_t(-4)));
+  EXPECT_THAT_EXPECTED(
+      binary(minus_seven, 60, AgentExpression::eOpRshUnsigned),
+      llvm::HasValue(15));
+  EXPECT_THAT_EXPECTED(binary(minus_seven, 0, AgentExpression::eOpLessSigned),
+                       llvm::HasValue(1));
+  EXPECT_THAT_EXPECTED(
+      binary(minus_seven, 0, AgentExpression::eOpLessUnsigned),
+      llvm::HasValue(0));
+  EXPECT_THAT_EXPECTED(binary(1, 0, AgentExpression::eOpDivUnsigned),
+                       llvm::Failed());
+}
+
+TEST(AgentExpressionTest, Extend) {
+  FakeTarget target;
+  AgentExpression expr;
+  expr.EmitConstant(0xff);
+  expr.EmitExtend(8, /*is_signed=*/true);
+  expr.Emit(AgentExpression::eOpEnd);
+  EXPECT_THAT_EXPECTED(target.Evaluate(expr), llvm::HasValue(uint64_t(-1)));
+
+  AgentExpression zext;
+  zext.EmitConstant(0x12345678);
+  zext.EmitExtend(16, /*is_signed=*/false);
+  zext.Emit(AgentExpression::eOpEnd);
+  EXPECT_THAT_EXPECTED(target.Evaluate(zext), llvm::HasValue(0x5678));
+}
+
+TEST(AgentExpressionTest, RegistersAndMemory) {
+  FakeTarget target;
+  target.registers[6] = 0x1000;
+  target.memory[0x0ff8] = 0x1122334455667788;
+
+  // *(int *)($reg6 - 8) == 0x55667788
+  AgentExpression expr;
+  expr.EmitRegister(6);
+  expr.EmitConstant(8);
+  expr.Emit(AgentExpression::eOpSub);
+  ASSERT_TRUE(expr.EmitLoad(4));
+  expr.EmitConstant(0x55667788);
+  expr.Emit(AgentExpression::eOpEqual);
+  expr.Emit(AgentExpression::eOpEnd);
+  EXPECT_THAT_EXPECTED(target.Evaluate(expr), llvm::HasValue(1));
+
+  AgentExpression bad_register;
+  bad_register.EmitRegister(7);
+  bad_register.Emit(AgentExpression::eOpEnd);
+  EXPECT_THAT_EXPECTED(target.Evaluate(bad_register), llvm::Failed());
+
+  AgentExpression bad_memory;
+  bad_memory.EmitConstant(0);
+  ASSERT_TRUE(bad_memory.EmitLoad(8));
+  bad_memory.Emit(AgentExpression::eOpEnd);
+  EXPECT_THAT_EXPECTED(target.Evaluate(bad_memory), llvm::Failed());
+}
+
+TEST(AgentExpressionTest, Jumps) {
+  FakeTarget target;
+
+  // 0 && <something that fails> short circuits.
+  AgentExpression expr;
+  expr.EmitConstant(0);
+  expr.Emit(AgentExpression::eOpDup);
+  expr.Emit(AgentExpression::eOpLogNot);
+  size_t jump = expr.EmitJump(AgentExpression::eOpIfGoto);
+  expr.Emit(AgentExpression::eOpPop);
+  expr.EmitRegister(99);
+  expr.PatchJump(jump, expr.GetSize());
+  expr.Emit(AgentExpression::eOpEnd);
+  EXPECT_THAT_EXPECTED(target.Evaluate(expr), llvm::HasValue(0));
+
+  // An infinite loop is cut off.
+  AgentExpression loop;
+  loop.PatchJump(loop.EmitJump(AgentExpression::eOpGoto), 0);
+  EXPECT_THAT_EXPECTED(target.Evaluate(loop), llvm::Failed());
+}
+
+TEST(AgentExpressionTest, Malformed) {
+  FakeTarget target;
+  EXPECT_THAT_EXPECTED(target.Evaluate(AgentExpression()), llvm::Failed());
+
+  const uint8_t underflow[] = {AgentExpression::eOpAdd,
+                               AgentExpression::eOpEnd};
+  EXPECT_THAT_EXPECTED(target.Evaluate(AgentExpression(underflow)),
+                       llvm::Failed());
+
+  const uint8_t truncated[] = {AgentExpression::eOpConst32, 0x12};
+  EXPECT_THAT_EXPECTED(target.Evaluate(AgentExpression(truncated)),
+                       llvm::Failed());
+
+  // trace is not supported.
+  const uint8_t trace[] = {0x0c, AgentExpression::eOpEnd};
+  EXPECT_THAT_EXPECTED(target.Evaluate(AgentExpression(trace)),
+                       llvm::Failed());
+}
@@ -0,0 +1,125 @@
+//===-- AsyncLogStreamTest.cpp ----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/AsyncLogStream.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <thread>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace {
+class StringStream : public llvm::raw_ostream {
+public:
+  StringStream() : llvm::raw_ostream(/*unbuffered=*/true) {}
+  std::string m_str;
+
+private:
+  void write_impl(const char *ptr, size_t size) override {
+    m_str.append(ptr, size);
+  }
+  uint64_t current_pos() const override { return m_str.size(); }
+};
+} // namespace
+
+TEST(AsyncLogStreamTest, Forward) {
+  auto target_sp = std::make_shared<StringStream>();
+  {
+    AsyncLogStream stream(target_sp);
+    EXPECT_EQ(&stream, AsyncLogStream::Find(&stream));
+    stream << "one\n";
+    stream << "two\n";
+    stream.Drain();
+    EXPECT_EQ("one\ntwo\n", target_sp->m_str);
+    stream << "three\n";
+  }
+  // Destroying the stream writes out whatever is still queued.
+  EXPECT_EQ("one\ntwo\nthree\n", target_sp->m_str);
+}
+
+TEST(AsyncLogStreamTest, MultipleThreads) {
+  auto target_sp = std::make_shared<StringStream>();
+  const unsigned num_threads = 4;
+  const unsigned num_messages = 1000;
+  {
+    AsyncLogStream stream(target_sp);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t)
+      threads.emplace_back([&stream] {
+        for (unsigned i = 0; i < num_messages; ++i)
+          stream << "message\n";
+      });
+    for (std::thread &thread : threads)
+      thread.join();
+  }
+  llvm::StringRef output(target_sp->m_str);
+  EXPECT_EQ(num_threads * num_messages, output.count("message\n"));
+}
+
+TEST(AsyncLogStreamTest, Dropped) {
+  auto target_sp = std::make_shared<StringStream>();
+  {
+    // A ring too small for any message drops everything.
+    AsyncLogStream stream(target_sp, 0, 8);
+    stream << "hello\n";
+    stream << "world\n";
+    EXPECT_EQ(2u, stream.GetDroppedCount());
+  }
+  llvm::StringRef output(target_sp->m_str);
+  EXPECT_TRUE(output.contains("log messages dropped"));
+  EXPECT_FALSE(output.contains("hello"));
+}
+
+TEST(AsyncLogStreamTest, History) {
+  auto target_sp = std::make_shared<StringStream>();
+  AsyncLogStream stream(target_sp, 8);
+  stream << "aaaa\n";
+  stream << "bbbb\n";
+  stream << "cccc\n";
+  stream.Drain();
+  // Nothing is written until the history is dumped.
+  EXPECT_EQ("", target_sp->m_str);
+
+  stream.DumpHistory();
+  EXPECT_EQ("cccc\n", target_sp->m_str);
+
+  // Dumping clears the history.
+  stream.DumpHistory();
+  EXPECT_EQ("cccc\n", target_sp->m_str);
+}
+
+TEST(AsyncLogStreamTest, HistoryWraps) {
+  auto target_sp = std::make_shared<StringStream>();
+  AsyncLogStream stream(target_sp, 16);
+  stream << "first message\n";
+  stream << "two\n";
+  stream << "three\n";
+  // The first message was partly overwritten, so it is left out.
+  stream.DumpHistory();
+  EXPECT_EQ("two\nthree\n", target_sp->m_str);
+}
+
+TEST(AsyncLogStreamTest, ThreadExit) {
+  auto target_sp = std::make_shared<StringStream>();
+  {
+    AsyncLogStream stream(target_sp);
+    // Each thread gets a ring that is freed once the thread is gone and the
+    // ring is drained; messages written just before exiting aren't lost.
+    for (unsigned i = 0; i < 64; ++i) {
+      std::thread([&stream] { stream << "message\n"; }).join();
+      if (i % 8 == 0)
+        stream.Drain();
+    }
+  }
+  llvm::StringRef output(target_sp->m_str);
+  EXPECT_EQ(64u, output.count("message\n"));
+}
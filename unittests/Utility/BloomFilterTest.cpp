@@ -0,0 +1,59 @@
+//===-- BloomFilterTest.cpp -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/BloomFilter.h"
+
+#include "llvm/ADT/Twine.h"
+
+using namespace lldb_private;
+
+static ConstString GetName(llvm::StringRef prefix, size_t idx) {
+  return ConstString((prefix + llvm::Twine(idx)).str());
+}
+
+TEST(BloomFilterTest, Empty) {
+  // A filter without room for names can't rule any out.
+  BloomFilter filter;
+  EXPECT_FALSE(filter.IsValid());
+  filter.Insert(ConstString("foo"));
+  EXPECT_TRUE(filter.MayContain(ConstString("foo")));
+  EXPECT_TRUE(filter.MayContain(ConstString("bar")));
+}
+
+TEST(BloomFilterTest, MayContain) {
+  const size_t num_names = 10000;
+  BloomFilter filter(num_names);
+  EXPECT_TRUE(filter.IsValid());
+  EXPECT_GT(filter.GetMemoryUsage(), 0u);
+  for (size_t idx = 0; idx < num_names; ++idx)
+    filter.Insert(GetName("inserted", idx));
+
+  for (size_t idx = 0; idx < num_names; ++idx)
+    EXPECT_TRUE(filter.MayContain(GetName("inserted", idx)));
+
+  size_t false_positives = 0;
+  for (size_t idx = 0; idx < num_names; ++idx)
+    if (filter.MayContain(GetName("missing", idx)))
+      ++false_positives;
+  EXPECT_LT(false_positives, num_names * 3 / 100);
+
+  filter.Reset(0);
+  EXPECT_FALSE(filter.IsValid());
+  EXPECT_TRUE(filter.MayContain(GetName("missing", 0)));
+}
+
+TEST(BloomFilterTest, Statistics) {
+  uint64_t avoided = BloomFilter::GetLookupsAvoided();
+  uint64_t false_positives = BloomFilter::GetFalsePositives();
+  BloomFilter::RecordLookupAvoided();
+  BloomFilter::RecordFalsePositive();
+  EXPECT_EQ(avoided + 1, BloomFilter::GetLookupsAvoided());
+  EXPECT_EQ(false_positives + 1, BloomFilter::GetFalsePositives());
+}
@@ -8,7 +8,10 @@
 
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/Timer.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <map>
 #include <thread>
 
 using namespace lldb_private;
@@ -69,3 +72,60 @@ TEST(TimerTest, CategoryTimes2) {
   EXPECT_LT(0.001, seconds2);
   EXPECT_GT(0.1, seconds2);
 }
+
+TEST(TimerTest, Trace) {
+  Timer::ResetTrace();
+  Timer::SetTraceEnabled(true);
+  {
+    static Timer::Category tcat1("CAT1");
+    Timer t1(tcat1, "");
+    std::thread thread([] {
+      static Timer::Category tcat2("CAT\"2\"");
+      Timer t2(tcat2, "parsing \"%s\" %d", "a.out", 2);
+    });
+    thread.join();
+  }
+  Timer::SetTraceEnabled(false);
+  {
+    static Timer::Category tcat3("CAT3");
+    Timer t3(tcat3, "");
+  }
+
+  std::string trace;
+  llvm::raw_string_ostream os(trace);
+  Timer::DumpTrace(os);
+
+  llvm::Expected<llvm::json::Value> json = llvm::json::parse(os.str());
+  ASSERT_TRUE(bool(json)) << llvm::toString(json.takeError());
+  const llvm::json::Array *events =
+      json->getAsObject()->getArray("traceEvents");
+  ASSERT_NE(nullptr, events);
+  ASSERT_EQ(2U, events->size());
+
+  std::map<std::string, const llvm::json::Object *> by_name;
+  for (const llvm::json::Value &event : *events) {
+    const llvm::json::Object *object = event.getAsObject();
+    ASSERT_NE(nullptr, object);
+    EXPECT_EQ(llvm::StringRef("X"), object->getString("ph"));
+    by_name[object->getString("name")->str()] = object;
+  }
+  ASSERT_EQ(1U, by_name.count("CAT1"));
+  ASSERT_EQ(1U, by_name.count("CAT\"2\""));
+  const llvm::json::Object *event1 = by_name["CAT1"];
+  const llvm::json::Object *event2 = by_name["CAT\"2\""];
+  EXPECT_NE(*event1->getInteger("tid"), *event2->getInteger("tid"));
+
+  // Empty messages are left out.
+  EXPECT_EQ(nullptr, event1->getObject("args"));
+  const llvm::json::Object *args = event2->getObject("args");
+  ASSERT_NE(nullptr, args);
+  EXPECT_EQ(llvm::StringRef("parsing \"a.out\" 2"),
+            args->getString("message"));
+
+  Timer::ResetTrace();
+  trace.clear();
+  Timer::DumpTrace(os);
+  json = llvm::json::parse(os.str());
+  ASSERT_TRUE(bool(json)) << llvm::toString(json.takeError());
+  EXPECT_EQ(0U, json->getAsObject()->getArray("traceEvents")->size());
+}